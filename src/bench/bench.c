@@ -0,0 +1,121 @@
+
+// Benchmark Entry Point
+// Usage: bench.o [filter]
+// Runs all benchmark groups whose name contains the filter
+
+#include "bench.h"
+
+void bench_map();
+void bench_rehash();
+void bench_string();
+void bench_churn();
+void bench_lookup();
+void bench_entry();
+void bench_build();
+void bench_concurrent();
+void bench_visited();
+void bench_rcu();
+void bench_ordered();
+void bench_clear();
+void bench_algebra();
+void bench_bloom();
+void bench_hash();
+void bench_small();
+void bench_bitset();
+void bench_intern();
+void bench_list();
+void bench_reduce();
+void bench_search();
+void bench_sort();
+
+typedef void (*FnBenchGroup) ();
+
+typedef struct
+{
+    slice_t name;
+    FnBenchGroup group;
+} BenchGroup;
+
+static BenchGroup GROUPS[] = {
+    { "map", & bench_map },
+    { "rehash", & bench_rehash },
+    { "string", & bench_string },
+    { "churn", & bench_churn },
+    { "lookup", & bench_lookup },
+    { "entry", & bench_entry },
+    { "build", & bench_build },
+    { "concurrent", & bench_concurrent },
+    { "visited", & bench_visited },
+    { "rcu", & bench_rcu },
+    { "ordered", & bench_ordered },
+    { "clear", & bench_clear },
+    { "algebra", & bench_algebra },
+    { "bloom", & bench_bloom },
+    { "hash", & bench_hash },
+    { "small", & bench_small },
+    { "bitset", & bench_bitset },
+    { "intern", & bench_intern },
+    { "list", & bench_list },
+    { "reduce", & bench_reduce },
+    { "search", & bench_search },
+    { "sort", & bench_sort },
+};
+
+int main(int argc, char** argv)
+{
+    slice_t filter = argc > 1 ? argv[1] : "";
+    for (uint32_t i = 0; i < sizeof(GROUPS) / sizeof(BenchGroup); i++)
+    {
+        if (strstr(GROUPS[i].name, filter) != NULL)
+        {
+            GROUPS[i].group();
+        }
+    }
+    return 0;
+}
+
+
+uint64_t bench_nanos()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ((uint64_t) ts.tv_sec) * 1000000000ul + (uint64_t) ts.tv_nsec;
+}
+
+void bench_report(slice_t name, uint64_t nanos, uint64_t operations)
+{
+    println("  %-48s %10.2f ns/op %10.2f ms", name, (double) nanos / (double) max(operations, 1ul), (double) nanos / 1000000.0);
+}
+
+static int bench_compare_uint64(const void* left, const void* right)
+{
+    uint64_t l = *(const uint64_t*) left, r = *(const uint64_t*) right;
+    return (l > r) - (l < r);
+}
+
+void bench_report_latency(slice_t name, uint64_t* samples, uint32_t count)
+{
+    // Latencies have many duplicates, which the partition in sorting_qsort_recursive handles poorly, so use the C library sort instead
+    qsort(samples, count, sizeof(uint64_t), bench_compare_uint64);
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        total += samples[i];
+    }
+
+    #define PERCENTILE(p) samples[(uint32_t) ((double) (count - 1) * (p))]
+    println("  %-32s mean %8.1f  p50 %6lu  p99 %6lu  p99.9 %8lu  p99.99 %9lu  max %10lu ns", name, (double) total / (double) max(count, 1u),
+        PERCENTILE(0.5), PERCENTILE(0.99), PERCENTILE(0.999), PERCENTILE(0.9999), samples[count - 1]);
+    #undef PERCENTILE
+}
+
+uint64_t bench_rand(uint64_t* state)
+{
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1Dul;
+}
@@ -0,0 +1,43 @@
+// Simple, easy-to-write benchmarks
+
+#include "../lib/lib.h"
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// Defines a group of benchmarks.
+// Groups are ran from the entry point, optionally filtered by name
+#define BENCH_GROUP(name, body...) \
+void name(); \
+void name() \
+{ \
+    println(FORMAT_BOLD "%s" FORMAT_RESET, LITERAL(name)); \
+    body \
+    ; \
+} \
+GLOBAL_NOOP
+
+// Timing
+// Returns a wall clock time stamp, in nanoseconds
+uint64_t bench_nanos();
+
+// Reports the result of a single benchmark, as time per operation
+void bench_report(slice_t name, uint64_t nanos, uint64_t operations);
+
+// Times a block of code which performs a given number of operations, and reports the time per operation
+#define BENCH(name, operations, body...) do { \
+    uint64_t __bench_start = bench_nanos(); \
+    body \
+    ; \
+    bench_report(name, bench_nanos() - __bench_start, operations); \
+} while (0)
+
+// Reports the distribution of a set of per-operation latency samples, in nanoseconds: the mean, median, tail percentiles, and maximum
+// Sorts the samples in place
+void bench_report_latency(slice_t name, uint64_t* samples, uint32_t count);
+
+// Random numbers
+// A fast, seedable generator (xorshift64*) so runs over the same inputs are repeatable
+uint64_t bench_rand(uint64_t* state);
+
+#endif
@@ -0,0 +1,70 @@
+#include "bench.h"
+
+// Set Algebra
+// Intersects a set of 1M random Int32 values with a set of 1K values (half of which are shared), both ways around.
+// Compares set_intersect_new() against a hand written loop, which iterates the first set, and probes the second with set_contains().
+
+#define BENCH_ALGEBRA_LARGE (1 << 20)
+#define BENCH_ALGEBRA_SMALL (1 << 10)
+#define BENCH_ALGEBRA_ROUNDS 10
+
+static Set bench_algebra_by_hand(Set set, Set other)
+{
+    Set result = new(Set, 16, set->value_class);
+    for iter(Set, it, set)
+    {
+        if (set_contains(other, it.value))
+        {
+            set_put(result, copy_c(set->value_class, it.value));
+        }
+    }
+    return result;
+}
+
+static void bench_algebra_run(Set first, Set second, slice_t order)
+{
+    uint64_t total = 0;
+    String name = str_format("by hand, %s", order);
+    BENCH(name->slice, BENCH_ALGEBRA_ROUNDS, {
+        for (uint32_t round = 0; round < BENCH_ALGEBRA_ROUNDS; round++)
+        {
+            Set result = bench_algebra_by_hand(first, second);
+            total += result->length;
+            del(Set, result);
+        }
+    });
+    del(String, name);
+
+    name = str_format("set_intersect_new, %s", order);
+    BENCH(name->slice, BENCH_ALGEBRA_ROUNDS, {
+        for (uint32_t round = 0; round < BENCH_ALGEBRA_ROUNDS; round++)
+        {
+            Set result = set_intersect_new(first, second);
+            total -= result->length;
+            del(Set, result);
+        }
+    });
+    del(String, name);
+    panic_if(total != 0, "Intersections should match");
+}
+
+BENCH_GROUP(bench_algebra, {
+    Set large = new(Set, 16, class(Int32)), small = new(Set, 16, class(Int32));
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < BENCH_ALGEBRA_LARGE; i++)
+    {
+        int32_t value = (int32_t) (bench_rand(&seed) >> 33);
+        set_put(large, new(Int32, value));
+        if (i < BENCH_ALGEBRA_SMALL / 2)
+        {
+            set_put(small, new(Int32, value));
+            set_put(small, new(Int32, -1 - value)); // Never in the large set
+        }
+    }
+
+    bench_algebra_run(large, small, "large with small");
+    bench_algebra_run(small, large, "small with large");
+
+    del(Set, large);
+    del(Set, small);
+});
@@ -0,0 +1,105 @@
+#include "bench.h"
+
+// BitSet
+// Marks 4M random integers (about a third of them duplicates) in [0, 4M) as visited, testing each first, with a BitSet, a PrimitiveArrayList(bool), and a Set<Int32>.
+// Then counts the visited integers 100 times, with bs_count(), and by summing the bool list.
+
+#define BENCH_BITSET_OPERATIONS (1 << 22)
+#define BENCH_BITSET_RANGE (1 << 22)
+#define BENCH_BITSET_COUNTS 100
+
+static void bench_bitset_bitset(uint32_t* values)
+{
+    BitSet visited = new(BitSet, BENCH_BITSET_RANGE);
+    uint32_t count = 0;
+    BENCH("visited, bitset", BENCH_BITSET_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_BITSET_OPERATIONS; i++)
+        {
+            if (!bs_test(visited, values[i]))
+            {
+                bs_set(visited, values[i]);
+                count++;
+            }
+        }
+    });
+
+    uint32_t total = 0;
+    BENCH("count, bitset", BENCH_BITSET_COUNTS, {
+        for (uint32_t i = 0; i < BENCH_BITSET_COUNTS; i++)
+        {
+            total += bs_count(visited);
+        }
+    });
+    panic_if(total != count * BENCH_BITSET_COUNTS, "Counted %u, expected %u", total, count * BENCH_BITSET_COUNTS);
+    println("  %-48s %10lu bytes", "memory, bitset", sizeof(uint64_t) * visited->size);
+    del(BitSet, visited);
+}
+
+static void bench_bitset_bool_list(uint32_t* values)
+{
+    PrimitiveArrayList(bool) visited = new(PrimitiveArrayList(bool), BENCH_BITSET_RANGE);
+    memset(visited->values, 0, sizeof(bool) * BENCH_BITSET_RANGE);
+    visited->length = BENCH_BITSET_RANGE;
+    uint32_t count = 0;
+    BENCH("visited, bool list", BENCH_BITSET_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_BITSET_OPERATIONS; i++)
+        {
+            if (!al_get(visited, values[i]))
+            {
+                al_set(visited, values[i], true);
+                count++;
+            }
+        }
+    });
+
+    uint32_t total = 0;
+    BENCH("count, bool list", BENCH_BITSET_COUNTS, {
+        for (uint32_t i = 0; i < BENCH_BITSET_COUNTS; i++)
+        {
+            for (uint32_t j = 0; j < BENCH_BITSET_RANGE; j++)
+            {
+                total += visited->values[j];
+            }
+        }
+    });
+    panic_if(total != count * BENCH_BITSET_COUNTS, "Counted %u, expected %u", total, count * BENCH_BITSET_COUNTS);
+    println("  %-48s %10lu bytes", "memory, bool list", sizeof(bool) * visited->size);
+    del(PrimitiveArrayList(bool), visited);
+}
+
+static void bench_bitset_set(uint32_t* values)
+{
+    Set visited = new(Set, BENCH_BITSET_RANGE, class(Int32));
+    Int32 key = new(Int32, 0);
+    uint32_t count = 0;
+    BENCH("visited, set", BENCH_BITSET_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_BITSET_OPERATIONS; i++)
+        {
+            *key = (int32_t) values[i];
+            if (!set_contains(visited, key))
+            {
+                set_put(visited, new(Int32, *key));
+                count++;
+            }
+        }
+    });
+    panic_if(visited->length != count, "Counted %u, expected %u", visited->length, count);
+    println("  %-48s %10lu bytes", "memory, set (excluding values)", set_stats(visited).bytes);
+    del(Int32, key);
+    del(Set, visited);
+}
+
+BENCH_GROUP(bench_bitset, {
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    uint32_t* values = safe_malloc(sizeof(uint32_t) * BENCH_BITSET_OPERATIONS);
+    for (uint32_t i = 0; i < BENCH_BITSET_OPERATIONS; i++)
+    {
+        values[i] = (uint32_t) (bench_rand(&seed) % BENCH_BITSET_RANGE);
+    }
+
+    bench_bitset_bitset(values);
+    bench_bitset_bool_list(values);
+    bench_bitset_set(values);
+
+    free(values);
+});
@@ -0,0 +1,61 @@
+#include "bench.h"
+
+// Bloom Filter
+// Looks up 4M random keys, which all miss, in a map of 4M random Int32 keys, with and without HASH_BLOOM, and then 4M keys which all hit.
+// The table is far larger than the cache, while the filter (1 byte per slot) is smaller, so a rejected miss avoids a cache miss on the table.
+
+#define BENCH_BLOOM_KEYS (1 << 22)
+
+static void bench_bloom_run(slice_t engine_name, HashOptions options)
+{
+    Map map = new(Map, 16, class(Int32), class(Int32), options);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < BENCH_BLOOM_KEYS; i++)
+    {
+        int32_t key = (int32_t) (bench_rand(&seed) >> 33); // Non-negative keys
+        map_put(map, new(Int32, key), new(Int32, key));
+    }
+
+    Int32 query = new(Int32, 0);
+    uint32_t found = 0;
+
+    String name = str_format("%s miss", engine_name);
+    seed = 0xD1B54A32D192ED03ul;
+    BENCH(name->slice, BENCH_BLOOM_KEYS, {
+        for (uint32_t i = 0; i < BENCH_BLOOM_KEYS; i++)
+        {
+            *query = -1 - (int32_t) (bench_rand(&seed) >> 33); // Negative, so never present
+            found += map_contains_key(map, query);
+        }
+    });
+    del(String, name);
+
+    name = str_format("%s hit", engine_name);
+    seed = 0x9E3779B97F4A7C15ul;
+    BENCH(name->slice, BENCH_BLOOM_KEYS, {
+        for (uint32_t i = 0; i < BENCH_BLOOM_KEYS; i++)
+        {
+            *query = (int32_t) (bench_rand(&seed) >> 33);
+            found += map_contains_key(map, query);
+        }
+    });
+    del(String, name);
+    panic_if(found != BENCH_BLOOM_KEYS, "Every hit should be found");
+
+    HashBloomStats stats = map_bloom_stats(map);
+    if (stats.lookups > 0)
+    {
+        println("  %-48s %10.4f false positive rate, %lu KB", "", stats.false_positive_rate, stats.bytes >> 10);
+    }
+
+    del(Int32, query);
+    del(Map, map);
+    free(safe_malloc(1 << 20));
+}
+
+BENCH_GROUP(bench_bloom, {
+    bench_bloom_run("swiss", HASH_SWISS);
+    bench_bloom_run("swiss bloom", HASH_SWISS | HASH_BLOOM);
+    bench_bloom_run("linear", HASH_LINEAR);
+    bench_bloom_run("linear bloom", HASH_LINEAR | HASH_BLOOM);
+});
@@ -0,0 +1,75 @@
+#include "bench.h"
+
+// Build
+// Builds a map of 4M Int32 keys, by calling map_put() for each key (resizing as it grows), after map_reserve(), and with map_from_arrays() (which hashes and places keys in parallel).
+// Boxing the keys and values is not timed.
+
+#define BENCH_BUILD_KEYS (1 << 22)
+
+static void bench_build_box(pointer_t* keys, pointer_t* values)
+{
+    free(safe_malloc(1 << 20)); // Let the allocator coalesce boxes freed by the last map, as in benchrehash.c
+
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < BENCH_BUILD_KEYS; i++)
+    {
+        keys[i] = new(Int32, (int32_t) (bench_rand(&seed) >> 33));
+        values[i] = new(Int32, (int32_t) i);
+    }
+}
+
+static void bench_build_engine(slice_t engine_name, HashOptions options)
+{
+    pointer_t* keys = safe_malloc(sizeof(pointer_t) * BENCH_BUILD_KEYS);
+    pointer_t* values = safe_malloc(sizeof(pointer_t) * BENCH_BUILD_KEYS);
+    Map map;
+
+    bench_build_box(keys, values);
+    String name = str_format("%s put", engine_name);
+    BENCH(name->slice, BENCH_BUILD_KEYS, {
+        map = new(Map, 16, class(Int32), class(Int32), options);
+        for (uint32_t i = 0; i < BENCH_BUILD_KEYS; i++)
+        {
+            map_put(map, keys[i], values[i]);
+        }
+    });
+    del(Map, map);
+    del(String, name);
+
+    bench_build_box(keys, values);
+    name = str_format("%s reserve + put", engine_name);
+    BENCH(name->slice, BENCH_BUILD_KEYS, {
+        map = new(Map, 16, class(Int32), class(Int32), options);
+        map_reserve(map, BENCH_BUILD_KEYS);
+        for (uint32_t i = 0; i < BENCH_BUILD_KEYS; i++)
+        {
+            map_put(map, keys[i], values[i]);
+        }
+    });
+    del(Map, map);
+    del(String, name);
+
+    bench_build_box(keys, values);
+    name = str_format("%s from arrays", engine_name);
+    BENCH(name->slice, BENCH_BUILD_KEYS, {
+        map = map_from_arrays(BENCH_BUILD_KEYS, keys, values, class(Int32), class(Int32), options);
+    });
+    del(String, name);
+
+    // Rehash the built map, which places keys in parallel, using their cached hashes
+    name = str_format("%s rehash", engine_name);
+    BENCH(name->slice, map->length, {
+        map_reserve(map, 2 * map->length); // Doubles the size
+    });
+    del(Map, map);
+    del(String, name);
+
+    free(keys);
+    free(values);
+}
+
+BENCH_GROUP(bench_build, {
+    bench_build_engine("linear", HASH_LINEAR);
+    bench_build_engine("robin hood", HASH_ROBIN_HOOD);
+    bench_build_engine("swiss", HASH_SWISS);
+});
@@ -0,0 +1,74 @@
+#include "bench.h"
+
+// Churn
+// A map is filled to a fixed live size, then the oldest key is repeatedly removed and a new key inserted, so the live size stays constant.
+// With tombstones, probe sequences would grow with every cycle. Lookups of missing keys are timed before and after the churn, to show they do not degrade.
+
+#define BENCH_CHURN_LIVE (1 << 20)
+#define BENCH_CHURN_ROUNDS 4
+#define BENCH_CHURN_QUERIES 1000000
+
+static uint32_t bench_churn_misses(Map map, Int32 query, uint64_t seed)
+{
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < BENCH_CHURN_QUERIES; i++)
+    {
+        *query = -1 - (int32_t) (bench_rand(&seed) >> 33); // Inserted keys are all non-negative
+        found += map_contains_key(map, query);
+    }
+    return found;
+}
+
+static void bench_churn_engine(slice_t engine_name, HashOptions options)
+{
+    Map map = new(Map, 16, class(Int32), class(Int32), options);
+    int32_t* live = safe_malloc(sizeof(int32_t) * BENCH_CHURN_LIVE); // Ring buffer of the live keys, oldest first
+    Int32 query = new(Int32, 0);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    uint32_t found = 0;
+
+    for (uint32_t i = 0; i < BENCH_CHURN_LIVE; i++)
+    {
+        live[i] = (int32_t) (bench_rand(&seed) >> 33);
+        map_put(map, new(Int32, live[i]), NULL);
+    }
+
+    String name = str_format("%s miss before", engine_name);
+    BENCH(name->slice, BENCH_CHURN_QUERIES, {
+        found += bench_churn_misses(map, query, 0xD1B54A32D192ED03ul);
+    });
+
+    for (uint32_t round = 0; round < BENCH_CHURN_ROUNDS; round++)
+    {
+        del(String, name);
+        name = str_format("%s remove + put, round %d", engine_name, round + 1);
+        BENCH(name->slice, BENCH_CHURN_LIVE, {
+            for (uint32_t i = 0; i < BENCH_CHURN_LIVE; i++)
+            {
+                *query = live[i];
+                map_remove(map, query, NULL, NULL);
+                live[i] = (int32_t) (bench_rand(&seed) >> 33);
+                map_put(map, new(Int32, live[i]), NULL);
+            }
+        });
+    }
+
+    del(String, name);
+    name = str_format("%s miss after", engine_name);
+    BENCH(name->slice, BENCH_CHURN_QUERIES, {
+        found += bench_churn_misses(map, query, 0xD1B54A32D192ED03ul);
+    });
+
+    panic_if(found != 0, "Expected no misses to be found");
+
+    del(String, name);
+    del(Int32, query);
+    del(Map, map);
+    free(live);
+}
+
+BENCH_GROUP(bench_churn, {
+    bench_churn_engine("linear", HASH_LINEAR);
+    bench_churn_engine("robin hood", HASH_ROBIN_HOOD);
+    bench_churn_engine("swiss", HASH_SWISS);
+});
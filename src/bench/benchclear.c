@@ -0,0 +1,42 @@
+#include "bench.h"
+
+// Clear
+// A scratch Set is grown once to hold 64K values, and is then filled with 8 values and cleared, many times, as with the per-line sets in day 4.
+// Without HASH_REUSABLE, each clear visits every slot of the set. With it, each clear only visits the 8 slots filled since the last one.
+
+#define BENCH_CLEAR_GROW (1 << 16)
+#define BENCH_CLEAR_ROUNDS 10000
+#define BENCH_CLEAR_VALUES 8
+
+static void bench_clear_run(slice_t engine_name, HashOptions options)
+{
+    Set set = new(Set, 16, class(Int32), options);
+    for (int32_t i = 0; i < BENCH_CLEAR_GROW; i++)
+    {
+        set_put(set, new(Int32, i));
+    }
+    set_clear(set);
+
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    String name = str_format("%s, %d values per clear", engine_name, BENCH_CLEAR_VALUES);
+    BENCH(name->slice, BENCH_CLEAR_ROUNDS, {
+        for (uint32_t round = 0; round < BENCH_CLEAR_ROUNDS; round++)
+        {
+            for (uint32_t i = 0; i < BENCH_CLEAR_VALUES; i++)
+            {
+                set_put(set, new(Int32, (int32_t) (bench_rand(&seed) >> 33)));
+            }
+            set_clear(set);
+        }
+    });
+
+    del(String, name);
+    del(Set, set);
+}
+
+BENCH_GROUP(bench_clear, {
+    bench_clear_run("swiss", HASH_SWISS);
+    bench_clear_run("swiss reusable", HASH_SWISS | HASH_REUSABLE);
+    bench_clear_run("linear", HASH_LINEAR);
+    bench_clear_run("linear reusable", HASH_LINEAR | HASH_REUSABLE);
+});
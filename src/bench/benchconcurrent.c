@@ -0,0 +1,99 @@
+#include "bench.h"
+
+// Concurrent
+// A mixed workload on a ConcurrentMap of 1M Int32 keys: 90% gets and 10% puts of random keys, split evenly across 1 to 64 threads.
+// The total number of operations is fixed, so with perfect scaling, the time per operation divides by the number of threads (up to the number of cores).
+
+#define BENCH_CONCURRENT_KEYS (1 << 20)
+#define BENCH_CONCURRENT_OPERATIONS (1 << 22)
+#define BENCH_CONCURRENT_SHARDS 64
+#define BENCH_CONCURRENT_MAX_THREADS 64
+
+typedef struct
+{
+    ConcurrentMap map;
+    uint32_t operations;
+    uint64_t seed;
+    uint32_t found;
+} BenchConcurrentThread;
+
+static void* bench_concurrent_thread(void* arg)
+{
+    BenchConcurrentThread* thread = arg;
+    Int32 query = new(Int32, 0);
+    for (uint32_t i = 0; i < thread->operations; i++)
+    {
+        uint64_t r = bench_rand(&thread->seed);
+        int32_t key = (int32_t) ((r >> 32) % BENCH_CONCURRENT_KEYS);
+        if ((r & 0xFF) < 26) // ~10%
+        {
+            cmap_put(thread->map, new(Int32, key), new(Int32, key));
+        }
+        else
+        {
+            *query = key;
+            Int32 value = cmap_get(thread->map, query);
+            thread->found += value != NULL;
+            del(Int32, value);
+        }
+    }
+    del(Int32, query);
+    return NULL;
+}
+
+BENCH_GROUP(bench_concurrent, {
+    ConcurrentMap map = new(ConcurrentMap, BENCH_CONCURRENT_SHARDS, 16, class(Int32), class(Int32));
+    for (int32_t i = 0; i < BENCH_CONCURRENT_KEYS; i += 2)
+    {
+        cmap_put(map, new(Int32, i), new(Int32, i)); // Half of the keys are present to start with
+    }
+
+    pthread_t threads[BENCH_CONCURRENT_MAX_THREADS];
+    BenchConcurrentThread args[BENCH_CONCURRENT_MAX_THREADS];
+    for (uint32_t count = 1; count <= BENCH_CONCURRENT_MAX_THREADS; count <<= 1)
+    {
+        String name = str_format("%d threads, 90%% get / 10%% put", count);
+        BENCH(name->slice, BENCH_CONCURRENT_OPERATIONS, {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                args[i] = (BenchConcurrentThread) { map, BENCH_CONCURRENT_OPERATIONS / count, 0x9E3779B97F4A7C15ul + i, 0 };
+                panic_if(pthread_create(&threads[i], NULL, bench_concurrent_thread, &args[i]) != 0, "Unable to create thread %d", i);
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                pthread_join(threads[i], NULL);
+            }
+        });
+        del(String, name);
+    }
+
+    del(ConcurrentMap, map);
+
+    // The same workload on a single Map, without any locks or copies, for comparison
+    Map single = new(Map, 16, class(Int32), class(Int32));
+    for (int32_t i = 0; i < BENCH_CONCURRENT_KEYS; i += 2)
+    {
+        map_put(single, new(Int32, i), new(Int32, i));
+    }
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    uint32_t found = 0;
+    Int32 query = new(Int32, 0);
+    BENCH("1 thread, Map without locks", BENCH_CONCURRENT_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_CONCURRENT_OPERATIONS; i++)
+        {
+            uint64_t r = bench_rand(&seed);
+            int32_t key = (int32_t) ((r >> 32) % BENCH_CONCURRENT_KEYS);
+            if ((r & 0xFF) < 26)
+            {
+                map_put(single, new(Int32, key), new(Int32, key));
+            }
+            else
+            {
+                *query = key;
+                found += map_get(single, query) != NULL;
+            }
+        }
+    });
+    del(Int32, query);
+    del(Map, single);
+});
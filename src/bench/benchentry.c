@@ -0,0 +1,103 @@
+#include "bench.h"
+
+// Entry
+// Counts the occurrences of states, as lists of 16 banks (as in day06), drawn from a fixed pool so most lookups find their key.
+// Compares probing for each state twice (contains, then get or put), against a single probe with map_entry(), and with map_get_or_insert() (which allocates a value even when the state is present).
+
+#define BENCH_ENTRY_STATES (1 << 18)
+#define BENCH_ENTRY_OPERATIONS (1 << 22)
+#define BENCH_ENTRY_BANKS 16
+
+static PrimitiveArrayList(uint32_t) bench_entry_state(uint64_t* seed)
+{
+    uint64_t index = bench_rand(seed) % BENCH_ENTRY_STATES;
+    PrimitiveArrayList(uint32_t) state = new(PrimitiveArrayList(uint32_t), BENCH_ENTRY_BANKS);
+    for (uint32_t i = 0; i < BENCH_ENTRY_BANKS; i++)
+    {
+        al_append(state, (uint32_t) bench_rand(&index)); // Seeded by the index, so each state is generated identically every time
+    }
+    return state;
+}
+
+static void bench_entry_engine(slice_t engine_name, HashOptions options)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    int64_t totals[3] = { 0, 0, 0 };
+
+    // The cost of generating and deleting states alone, which is common to all methods
+    String name = str_format("%s (states only)", engine_name);
+    BENCH(name->slice, BENCH_ENTRY_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_ENTRY_OPERATIONS; i++)
+        {
+            del(PrimitiveArrayList(uint32_t), bench_entry_state(&seed));
+        }
+    });
+    del(String, name);
+
+    seed = 0x9E3779B97F4A7C15ul;
+    Map map = new(Map, 16, class(PrimitiveArrayList(uint32_t)), class(Int32), options);
+    name = str_format("%s contains + get / put", engine_name);
+    BENCH(name->slice, BENCH_ENTRY_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_ENTRY_OPERATIONS; i++)
+        {
+            PrimitiveArrayList(uint32_t) state = bench_entry_state(&seed);
+            if (map_contains_key(map, state))
+            {
+                Int32 count = map_get(map, state);
+                totals[0] += ++(*count);
+                del(PrimitiveArrayList(uint32_t), state);
+            }
+            else
+            {
+                map_put(map, state, new(Int32, 1));
+                totals[0]++;
+            }
+        }
+    });
+    del(Map, map);
+    del(String, name);
+
+    seed = 0x9E3779B97F4A7C15ul;
+    map = new(Map, 16, class(PrimitiveArrayList(uint32_t)), class(Int32), options);
+    name = str_format("%s entry", engine_name);
+    BENCH(name->slice, BENCH_ENTRY_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_ENTRY_OPERATIONS; i++)
+        {
+            PrimitiveArrayList(uint32_t) state = bench_entry_state(&seed);
+            MapEntry entry = map_entry(map, state);
+            if (entry.occupied)
+            {
+                totals[1] += ++(*(Int32) *map_entry_value(&entry));
+                del(PrimitiveArrayList(uint32_t), state);
+            }
+            else
+            {
+                map_entry_insert(&entry, new(Int32, 1));
+                totals[1]++;
+            }
+        }
+    });
+    del(Map, map);
+    del(String, name);
+
+    seed = 0x9E3779B97F4A7C15ul;
+    map = new(Map, 16, class(PrimitiveArrayList(uint32_t)), class(Int32), options);
+    name = str_format("%s get_or_insert", engine_name);
+    BENCH(name->slice, BENCH_ENTRY_OPERATIONS, {
+        for (uint32_t i = 0; i < BENCH_ENTRY_OPERATIONS; i++)
+        {
+            Int32 count = map_get_or_insert(map, bench_entry_state(&seed), new(Int32, 0));
+            totals[2] += ++(*count);
+        }
+    });
+    del(Map, map);
+    del(String, name);
+
+    panic_if(totals[0] != totals[1] || totals[0] != totals[2], "Expected all methods to count the same states");
+}
+
+BENCH_GROUP(bench_entry, {
+    bench_entry_engine("linear", HASH_LINEAR);
+    bench_entry_engine("robin hood", HASH_ROBIN_HOOD);
+    bench_entry_engine("swiss", HASH_SWISS);
+});
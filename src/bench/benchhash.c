@@ -0,0 +1,78 @@
+#include "bench.h"
+
+// Hashing
+// Hashes 1M strings of several lengths with hash_bytes(), and with the polynomial (multiplier 31) String hash it replaced, one byte at a time.
+// Then puts a 1024 x 1024 grid of points into a set, where the hash of a point combines the hashes of it's coordinates. With xor, (x, y) and (y, x) collided, and (k, k) all hashed to 0.
+
+#define BENCH_HASH_STRINGS (1 << 20)
+#define BENCH_HASH_GRID 1024
+
+#define Tuple BenchPoint, int32_t, x, int32_t, y
+#include "../lib/collections/tuple.template.c"
+
+static uint32_t bench_hash_polynomial(const uint8_t* data, uint32_t length)
+{
+    uint32_t h = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        h = (h * 31) + data[i];
+    }
+    return h;
+}
+
+static void bench_hash_strings(uint32_t length)
+{
+    uint8_t* data = safe_malloc(length + BENCH_HASH_STRINGS);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < length + BENCH_HASH_STRINGS; i++)
+    {
+        data[i] = (uint8_t) bench_rand(&seed);
+    }
+
+    // Each string starts one byte after the last, so no two are equal
+    uint32_t total = 0;
+    String name = str_format("hash_bytes, length %d", length);
+    BENCH(name->slice, BENCH_HASH_STRINGS, {
+        for (uint32_t i = 0; i < BENCH_HASH_STRINGS; i++)
+        {
+            total += hash_fold(hash_bytes(data + i, length, 0));
+        }
+    });
+    del(String, name);
+
+    name = str_format("polynomial, length %d", length);
+    BENCH(name->slice, BENCH_HASH_STRINGS, {
+        for (uint32_t i = 0; i < BENCH_HASH_STRINGS; i++)
+        {
+            total += bench_hash_polynomial(data + i, length);
+        }
+    });
+    del(String, name);
+
+    panic_if(total == 1, "Keeps the hashes from being optimized away");
+    free(data);
+}
+
+static void bench_hash_grid(slice_t name, HashOptions options)
+{
+    Set set = new(Set, 16, class(BenchPoint), options);
+    BENCH(name, BENCH_HASH_GRID * BENCH_HASH_GRID, {
+        for (int32_t x = 0; x < BENCH_HASH_GRID; x++)
+        {
+            for (int32_t y = 0; y < BENCH_HASH_GRID; y++)
+            {
+                set_put(set, new(BenchPoint, x, y));
+            }
+        }
+    });
+    del(Set, set);
+}
+
+BENCH_GROUP(bench_hash, {
+    bench_hash_strings(8);
+    bench_hash_strings(32);
+    bench_hash_strings(256);
+    bench_hash_grid("grid, swiss", HASH_SWISS);
+    bench_hash_grid("grid, linear", HASH_LINEAR);
+    bench_hash_grid("grid, linear seeded", HASH_LINEAR | HASH_SEEDED);
+});
@@ -0,0 +1,81 @@
+#include "bench.h"
+
+// Interning
+// Assigns ids to 1M words drawn from 16K distinct random words, as a parser would for names, with an Interner, and with a Map<String, Int32> of ids plus an ArrayList of names.
+// Each word is a fresh String, as if just read from the input, and is given to the interner or map, or deleted once it has an id.
+
+#define BENCH_INTERN_WORDS (1 << 20)
+#define BENCH_INTERN_DISTINCT (1 << 14)
+
+static String bench_intern_words[BENCH_INTERN_DISTINCT];
+
+static void bench_intern_interner(uint32_t* words)
+{
+    Interner interner = new(Interner, 16, class(String));
+    uint64_t total = 0;
+    BENCH("interner", BENCH_INTERN_WORDS, {
+        for (uint32_t i = 0; i < BENCH_INTERN_WORDS; i++)
+        {
+            total += intern_put(interner, copy(String, bench_intern_words[words[i]]));
+        }
+    });
+    panic_if(interner->length != BENCH_INTERN_DISTINCT, "Expected %u ids, got %u", BENCH_INTERN_DISTINCT, interner->length);
+    del(Interner, interner);
+}
+
+static void bench_intern_map(uint32_t* words)
+{
+    Map ids = new(Map, 16, class(String), class(Int32));
+    ArrayList names = new(ArrayList, 16, class(String));
+    uint64_t total = 0;
+    BENCH("map and list", BENCH_INTERN_WORDS, {
+        for (uint32_t i = 0; i < BENCH_INTERN_WORDS; i++)
+        {
+            String word = copy(String, bench_intern_words[words[i]]);
+            Int32 id = map_get(ids, word);
+            if (id == NULL)
+            {
+                id = new(Int32, (int32_t) names->length);
+                al_append(names, copy(String, word));
+                map_put(ids, word, id);
+            }
+            else
+            {
+                del(String, word);
+            }
+            total += (uint64_t) *id;
+        }
+    });
+    panic_if(names->length != BENCH_INTERN_DISTINCT, "Expected %u ids, got %u", BENCH_INTERN_DISTINCT, names->length);
+    del(Map, ids);
+    del(ArrayList, names);
+}
+
+BENCH_GROUP(bench_intern, {
+    // Each word is it's index, followed by random letters, so all are distinct
+    uint64_t seed = 0xD1B54A32D192ED03ul;
+    for (uint32_t i = 0; i < BENCH_INTERN_DISTINCT; i++)
+    {
+        String word = str_format("%u", i);
+        for (uint32_t length = word->length + 4 + (uint32_t) (bench_rand(&seed) % 8); word->length < length;)
+        {
+            str_append_char(word, (char) ('a' + bench_rand(&seed) % 26));
+        }
+        bench_intern_words[i] = word;
+    }
+
+    uint32_t* words = safe_malloc(sizeof(uint32_t) * BENCH_INTERN_WORDS);
+    for (uint32_t i = 0; i < BENCH_INTERN_WORDS; i++)
+    {
+        words[i] = i < BENCH_INTERN_DISTINCT ? i : (uint32_t) (bench_rand(&seed) % BENCH_INTERN_DISTINCT); // Every word appears at least once
+    }
+
+    bench_intern_interner(words);
+    bench_intern_map(words);
+
+    free(words);
+    for (uint32_t i = 0; i < BENCH_INTERN_DISTINCT; i++)
+    {
+        del(String, bench_intern_words[i]);
+    }
+});
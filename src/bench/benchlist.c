@@ -0,0 +1,72 @@
+#include "bench.h"
+
+// ArrayList growth
+// Builds a PrimitiveArrayList(uint32_t) of 64M values, from an initial size of 1: by appending with the previous growth (malloc() a new array, and copy the old one), by appending with realloc() growth, by appending after al_reserve(), and by al_extend_array() in blocks of 4K values.
+
+#define BENCH_LIST_VALUES (1 << 26)
+#define BENCH_LIST_BLOCK (1 << 12)
+
+// The previous al_append(), which copied the whole list on every resize
+static void bench_list_append_copying(PrimitiveArrayList(uint32_t) list, uint32_t value)
+{
+    if (list->length == list->size)
+    {
+        uint32_t* new_array = safe_malloc(sizeof(uint32_t) * list->size * 2);
+        memcpy(new_array, list->values, sizeof(uint32_t) * list->size);
+        free(list->values);
+        list->values = new_array;
+        list->size *= 2;
+    }
+    list->values[list->length++] = value;
+}
+
+static void bench_list_check(PrimitiveArrayList(uint32_t) list)
+{
+    panic_if(list->length != BENCH_LIST_VALUES, "Expected %u values, got %u", BENCH_LIST_VALUES, list->length);
+    panic_if(al_get(list, BENCH_LIST_VALUES - 1) != BENCH_LIST_VALUES - 1, "Expected the last value to be %u", BENCH_LIST_VALUES - 1);
+    del(PrimitiveArrayList(uint32_t), list);
+}
+
+BENCH_GROUP(bench_list, {
+    PrimitiveArrayList(uint32_t) list = new(PrimitiveArrayList(uint32_t), 1);
+    BENCH("append, malloc and copy", BENCH_LIST_VALUES, {
+        for (uint32_t i = 0; i < BENCH_LIST_VALUES; i++)
+        {
+            bench_list_append_copying(list, i);
+        }
+    });
+    bench_list_check(list);
+
+    list = new(PrimitiveArrayList(uint32_t), 1);
+    BENCH("append, realloc", BENCH_LIST_VALUES, {
+        for (uint32_t i = 0; i < BENCH_LIST_VALUES; i++)
+        {
+            al_append(list, i);
+        }
+    });
+    bench_list_check(list);
+
+    list = new(PrimitiveArrayList(uint32_t), 1);
+    BENCH("append, reserved", BENCH_LIST_VALUES, {
+        al_reserve(list, BENCH_LIST_VALUES);
+        for (uint32_t i = 0; i < BENCH_LIST_VALUES; i++)
+        {
+            al_append(list, i);
+        }
+    });
+    bench_list_check(list);
+
+    uint32_t block[BENCH_LIST_BLOCK];
+    list = new(PrimitiveArrayList(uint32_t), 1);
+    BENCH("extend, 4K blocks", BENCH_LIST_VALUES, {
+        for (uint32_t i = 0; i < BENCH_LIST_VALUES; i += BENCH_LIST_BLOCK)
+        {
+            for (uint32_t j = 0; j < BENCH_LIST_BLOCK; j++)
+            {
+                block[j] = i + j;
+            }
+            al_extend_array(list, block, BENCH_LIST_BLOCK);
+        }
+    });
+    bench_list_check(list);
+});
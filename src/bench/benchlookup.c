@@ -0,0 +1,109 @@
+#include "bench.h"
+
+// Large random lookups
+// The map is far larger than the cache, so each lookup of a random key costs cache misses, to read the slot (and the boxed key and value)
+// Measures lookups which find their key and read the value, lookups of missing keys, and iteration over all entries
+
+#define BENCH_LOOKUP_KEYS (1 << 22)
+#define BENCH_LOOKUP_QUERIES 4000000
+
+static void bench_lookup_engine(slice_t engine_name, HashOptions options)
+{
+    Map map = new(Map, 16, class(Int32), class(Int32), options);
+    int32_t* keys = safe_malloc(sizeof(int32_t) * BENCH_LOOKUP_KEYS);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+
+    for (uint32_t i = 0; i < BENCH_LOOKUP_KEYS; i++)
+    {
+        keys[i] = (int32_t) (bench_rand(&seed) >> 33);
+        map_put(map, new(Int32, keys[i]), new(Int32, 1));
+    }
+
+    Int32 query = new(Int32, 0);
+    int64_t total = 0;
+    String name = str_format("%s get", engine_name);
+
+    BENCH(name->slice, BENCH_LOOKUP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_LOOKUP_QUERIES; i++)
+        {
+            *query = keys[bench_rand(&seed) % BENCH_LOOKUP_KEYS];
+            total += *(Int32) map_get(map, query);
+        }
+    });
+
+    str_pop(name, 4);
+    str_append_slice(name, " miss");
+    BENCH(name->slice, BENCH_LOOKUP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_LOOKUP_QUERIES; i++)
+        {
+            *query = -1 - (int32_t) (bench_rand(&seed) >> 33); // Inserted keys are all non-negative
+            total += map_contains_key(map, query);
+        }
+    });
+
+    str_pop(name, 5);
+    str_append_slice(name, " iterate");
+    BENCH(name->slice, map->length, {
+        for iter(Map, it, map)
+        {
+            total += it.key != NULL;
+        }
+    });
+
+    panic_if(total != BENCH_LOOKUP_QUERIES + map->length, "Expected all gets to find their key, and no misses");
+
+    del(String, name);
+    del(Int32, query);
+    del(Map, map);
+    free(keys);
+}
+
+// The same lookups, with keys and values stored inline in a PrimitiveMap
+static void bench_lookup_primitive()
+{
+    PrimitiveMap(int32_t) map = new(PrimitiveMap(int32_t), 16);
+    int32_t* keys = safe_malloc(sizeof(int32_t) * BENCH_LOOKUP_KEYS);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+
+    BENCH("primitive put", BENCH_LOOKUP_KEYS, {
+        for (uint32_t i = 0; i < BENCH_LOOKUP_KEYS; i++)
+        {
+            keys[i] = (int32_t) (bench_rand(&seed) >> 33);
+            pm_put(map, keys[i], 1);
+        }
+    });
+
+    int64_t total = 0;
+    BENCH("primitive get", BENCH_LOOKUP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_LOOKUP_QUERIES; i++)
+        {
+            total += pm_get(map, keys[bench_rand(&seed) % BENCH_LOOKUP_KEYS]);
+        }
+    });
+
+    BENCH("primitive miss", BENCH_LOOKUP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_LOOKUP_QUERIES; i++)
+        {
+            total += pm_contains_key(map, -1 - (int32_t) (bench_rand(&seed) >> 33));
+        }
+    });
+
+    BENCH("primitive iterate", map->length, {
+        for iter(PrimitiveMap(int32_t), it, map)
+        {
+            total += it.value;
+        }
+    });
+
+    panic_if(total != BENCH_LOOKUP_QUERIES + map->length, "Expected all gets to find their key, and no misses");
+
+    del(PrimitiveMap(int32_t), map);
+    free(keys);
+}
+
+BENCH_GROUP(bench_lookup, {
+    bench_lookup_engine("linear", HASH_LINEAR);
+    bench_lookup_engine("robin hood", HASH_ROBIN_HOOD);
+    bench_lookup_engine("swiss", HASH_SWISS);
+    bench_lookup_primitive();
+});
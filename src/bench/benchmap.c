@@ -0,0 +1,88 @@
+#include "bench.h"
+
+// Probing engine comparisons at fixed load factors
+// Tables are filled up to the load factor without resizing, then queried for keys present (hits) and absent (misses)
+
+#define BENCH_MAP_SIZE (1 << 20)
+#define BENCH_MAP_QUERIES 1000000
+
+// Keys are either uniformly random, or drawn in runs of consecutive integers, which with an identity hash build long clusters
+static void bench_map_keys(PrimitiveArrayList(int32_t) keys, uint32_t count, bool clustered, uint64_t seed)
+{
+    al_clear(keys);
+    while (keys->length < count)
+    {
+        int32_t base = (int32_t) (bench_rand(&seed) >> 33);
+        uint32_t run = clustered ? 32 : 1;
+        for (uint32_t i = 0; i < run && keys->length < count; i++)
+        {
+            al_append(keys, base + (int32_t) i);
+        }
+    }
+}
+
+static void bench_map_engine(slice_t engine_name, HashOptions options, double load, bool clustered)
+{
+    uint32_t count = (uint32_t) (load * BENCH_MAP_SIZE);
+    PrimitiveArrayList(int32_t) keys = new(PrimitiveArrayList(int32_t), count);
+    PrimitiveArrayList(int32_t) misses = new(PrimitiveArrayList(int32_t), count);
+
+    bench_map_keys(keys, count, clustered, 0x9E3779B97F4A7C15ul);
+    bench_map_keys(misses, count, false, 0xD1B54A32D192ED03ul);
+
+    Map map = new(Map, BENCH_MAP_SIZE, class(Int32), class(Int32), options);
+    map->load_factor = 0.95; // Never resize during the benchmark
+
+    Int32 query = new(Int32, 0);
+    uint32_t found = 0;
+    String name = str_format("%s %s load=%.1f", engine_name, clustered ? "clustered" : "uniform", load);
+
+    str_append_slice(name, " put");
+    BENCH(name->slice, count, {
+        for iter(PrimitiveArrayList(int32_t), it, keys)
+        {
+            map_put(map, new(Int32, it.value), NULL);
+        }
+    });
+
+    str_pop(name, 4);
+    str_append_slice(name, " hit");
+    BENCH(name->slice, BENCH_MAP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_MAP_QUERIES; i++)
+        {
+            *query = keys->values[i % count];
+            found += map_contains_key(map, query);
+        }
+    });
+
+    str_pop(name, 4);
+    str_append_slice(name, " miss");
+    BENCH(name->slice, BENCH_MAP_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_MAP_QUERIES; i++)
+        {
+            *query = misses->values[i % count];
+            found += map_contains_key(map, query);
+        }
+    });
+
+    panic_if(found < BENCH_MAP_QUERIES, "Expected all hits to be found");
+
+    del(String, name);
+    del(Int32, query);
+    del(Map, map);
+    del(PrimitiveArrayList(int32_t), keys);
+    del(PrimitiveArrayList(int32_t), misses);
+}
+
+BENCH_GROUP(bench_map, {
+    double loads[] = { 0.5, 0.6, 0.7, 0.8, 0.9 };
+    for (uint32_t clustered = 0; clustered <= 1; clustered++)
+    {
+        for (uint32_t i = 0; i < 5; i++)
+        {
+            bench_map_engine("linear", HASH_LINEAR, loads[i], clustered);
+            bench_map_engine("robin hood", HASH_ROBIN_HOOD, loads[i], clustered);
+            bench_map_engine("swiss", HASH_SWISS, loads[i], clustered);
+        }
+    }
+});
@@ -0,0 +1,160 @@
+#include "bench.h"
+
+// Ordered Map
+// Compares a Map against an OrderedMap, filled with 1M random keys: building, querying, iterating, and the memory used per entry.
+// Both are then thinned out to 1000 keys, which a Map still iterates and clears in O(size), and an OrderedMap in O(length)
+
+#define BENCH_ORDERED_KEYS (1 << 20)
+#define BENCH_ORDERED_REMAINING 1000
+#define BENCH_ORDERED_SPARSE_ROUNDS 1000
+
+static void bench_ordered_run(bool ordered)
+{
+    PrimitiveArrayList(int32_t) keys = new(PrimitiveArrayList(int32_t), BENCH_ORDERED_KEYS);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < BENCH_ORDERED_KEYS; i++)
+    {
+        al_append(keys, (int32_t) (bench_rand(&seed) >> 33));
+    }
+
+    Map map = ordered ? NULL : new(Map, 16, class(Int32), class(Int32));
+    OrderedMap omap = ordered ? new(OrderedMap, 16, class(Int32), class(Int32)) : NULL;
+    slice_t kind = ordered ? "ordered" : "map";
+    Int32 query = new(Int32, 0);
+    uint64_t total = 0;
+
+    String name = str_format("%s put", kind);
+    BENCH(name->slice, BENCH_ORDERED_KEYS, {
+        for iter(PrimitiveArrayList(int32_t), it, keys)
+        {
+            if (ordered)
+            {
+                omap_put(omap, new(Int32, it.value), new(Int32, it.value));
+            }
+            else
+            {
+                map_put(map, new(Int32, it.value), new(Int32, it.value));
+            }
+        }
+    });
+    del(String, name);
+
+    name = str_format("%s hit", kind);
+    BENCH(name->slice, BENCH_ORDERED_KEYS, {
+        for iter(PrimitiveArrayList(int32_t), it, keys)
+        {
+            *query = it.value;
+            total += *(Int32) (ordered ? omap_get(omap, query) : map_get(map, query));
+        }
+    });
+    del(String, name);
+
+    uint32_t length = ordered ? omap->length : map->length;
+    name = str_format("%s iterate", kind);
+    BENCH(name->slice, length, {
+        if (ordered)
+        {
+            for iter(OrderedMap, it, omap)
+            {
+                total += *(Int32) it.value;
+            }
+        }
+        else
+        {
+            for iter(Map, it, map)
+            {
+                total += *(Int32) it.value;
+            }
+        }
+    });
+    del(String, name);
+
+    uint64_t bytes = ordered
+        ? (uint64_t) omap->size * omap->width + (uint64_t) omap->capacity * (sizeof(OrderedMapEntry) + sizeof(uint32_t))
+        : (uint64_t) map->size * (sizeof(MapSlot) + (map->control != NULL ? 1 : 0));
+    println("  %-48s %10.2f bytes/entry", kind, (double) bytes / length);
+
+    // Thin out to the last few keys, and iterate and clear what remains many times
+    for (uint32_t i = 0; i < BENCH_ORDERED_KEYS - BENCH_ORDERED_REMAINING; i++)
+    {
+        *query = keys->values[i];
+        if (ordered)
+        {
+            omap_remove(omap, query, NULL, NULL);
+        }
+        else
+        {
+            map_remove(map, query, NULL, NULL);
+        }
+    }
+    length = ordered ? omap->length : map->length;
+
+    name = str_format("%s sparse iterate", kind);
+    BENCH(name->slice, (uint64_t) BENCH_ORDERED_SPARSE_ROUNDS * length, {
+        for (uint32_t round = 0; round < BENCH_ORDERED_SPARSE_ROUNDS; round++)
+        {
+            if (ordered)
+            {
+                for iter(OrderedMap, it, omap)
+                {
+                    total += *(Int32) it.value;
+                }
+            }
+            else
+            {
+                for iter(Map, it, map)
+                {
+                    total += *(Int32) it.value;
+                }
+            }
+        }
+    });
+    del(String, name);
+
+    name = str_format("%s sparse clear", kind);
+    BENCH(name->slice, BENCH_ORDERED_SPARSE_ROUNDS, {
+        for (uint32_t round = 0; round < BENCH_ORDERED_SPARSE_ROUNDS; round++)
+        {
+            for (uint32_t i = 0; i < BENCH_ORDERED_REMAINING; i++)
+            {
+                int32_t key = keys->values[BENCH_ORDERED_KEYS - 1 - i];
+                if (ordered)
+                {
+                    omap_put(omap, new(Int32, key), new(Int32, key));
+                }
+                else
+                {
+                    map_put(map, new(Int32, key), new(Int32, key));
+                }
+            }
+            if (ordered)
+            {
+                omap_clear(omap);
+            }
+            else
+            {
+                map_clear(map);
+            }
+        }
+    });
+    del(String, name);
+
+    println("  %-48s %10lu", "(checksum)", total);
+
+    del(Int32, query);
+    if (ordered)
+    {
+        del(OrderedMap, omap);
+    }
+    else
+    {
+        del(Map, map);
+    }
+    del(PrimitiveArrayList(int32_t), keys);
+    free(safe_malloc(1 << 20));
+}
+
+BENCH_GROUP(bench_ordered, {
+    bench_ordered_run(false);
+    bench_ordered_run(true);
+});
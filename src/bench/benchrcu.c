@@ -0,0 +1,172 @@
+#include "bench.h"
+
+// RCU
+// One writer and 1 to 16 readers share a map of 64K Int32 keys. Readers perform 4M lookups between them, while the writer replaces values as fast as it can.
+// Compares an RcuMap (where the writer publishes every 1024 puts) against a ConcurrentMap with 64 shards, and a single Map guarded by one lock.
+
+#define BENCH_RCU_KEYS (1 << 16)
+#define BENCH_RCU_READS (1 << 22)
+#define BENCH_RCU_PUBLISH 1024
+#define BENCH_RCU_MAX_READERS 16
+
+typedef enum { BENCH_RCU, BENCH_RCU_SHARDED, BENCH_RCU_LOCKED } BenchRcuKind;
+
+typedef struct
+{
+    BenchRcuKind kind;
+    RcuMap rcu;
+    ConcurrentMap sharded;
+    Map locked;
+    pthread_mutex_t* lock;
+    _Atomic(bool)* done;
+    uint32_t operations;
+    uint64_t seed;
+    uint64_t total;
+} BenchRcuThread;
+
+static void* bench_rcu_reader(void* arg)
+{
+    BenchRcuThread* thread = arg;
+    Int32 query = new(Int32, 0);
+    uint32_t reader = thread->kind == BENCH_RCU ? rmap_register(thread->rcu) : 0;
+    for (uint32_t i = 0; i < thread->operations; i++)
+    {
+        *query = (int32_t) ((bench_rand(&thread->seed) >> 32) % BENCH_RCU_KEYS);
+        if (thread->kind == BENCH_RCU)
+        {
+            Map snapshot = rmap_read_begin(thread->rcu, reader);
+            thread->total += *(Int32) map_get(snapshot, query);
+            rmap_read_end(thread->rcu, reader);
+        }
+        else if (thread->kind == BENCH_RCU_SHARDED)
+        {
+            Int32 value = cmap_get(thread->sharded, query);
+            thread->total += *value;
+            del(Int32, value);
+        }
+        else
+        {
+            pthread_mutex_lock(thread->lock);
+            thread->total += *(Int32) map_get(thread->locked, query);
+            pthread_mutex_unlock(thread->lock);
+        }
+    }
+    if (thread->kind == BENCH_RCU)
+    {
+        rmap_unregister(thread->rcu, reader);
+    }
+    del(Int32, query);
+    return NULL;
+}
+
+static void* bench_rcu_writer(void* arg)
+{
+    BenchRcuThread* thread = arg;
+    for (uint32_t i = 1; !atomic_load(thread->done); i++)
+    {
+        int32_t key = (int32_t) ((bench_rand(&thread->seed) >> 32) % BENCH_RCU_KEYS);
+        if (thread->kind == BENCH_RCU)
+        {
+            rmap_put(thread->rcu, new(Int32, key), new(Int32, (int32_t) i));
+            if (i % BENCH_RCU_PUBLISH == 0)
+            {
+                rmap_publish(thread->rcu);
+            }
+        }
+        else if (thread->kind == BENCH_RCU_SHARDED)
+        {
+            cmap_put(thread->sharded, new(Int32, key), new(Int32, (int32_t) i));
+        }
+        else
+        {
+            pthread_mutex_lock(thread->lock);
+            map_put(thread->locked, new(Int32, key), new(Int32, (int32_t) i));
+            pthread_mutex_unlock(thread->lock);
+        }
+        thread->total++;
+    }
+    return NULL;
+}
+
+static void bench_rcu_run(BenchRcuKind kind, slice_t kind_name, uint32_t count)
+{
+    pthread_mutex_t lock;
+    pthread_mutex_init(&lock, NULL);
+    _Atomic(bool) done = false;
+
+    BenchRcuThread base = { kind, NULL, NULL, NULL, &lock, &done, 0, 0, 0 };
+    if (kind == BENCH_RCU)
+    {
+        base.rcu = new(RcuMap, 16, class(Int32), class(Int32));
+        for (int32_t i = 0; i < BENCH_RCU_KEYS; i++)
+        {
+            rmap_put(base.rcu, new(Int32, i), new(Int32, i));
+        }
+        rmap_publish(base.rcu);
+    }
+    else if (kind == BENCH_RCU_SHARDED)
+    {
+        base.sharded = new(ConcurrentMap, 64, 16, class(Int32), class(Int32));
+        for (int32_t i = 0; i < BENCH_RCU_KEYS; i++)
+        {
+            cmap_put(base.sharded, new(Int32, i), new(Int32, i));
+        }
+    }
+    else
+    {
+        base.locked = new(Map, 16, class(Int32), class(Int32));
+        for (int32_t i = 0; i < BENCH_RCU_KEYS; i++)
+        {
+            map_put(base.locked, new(Int32, i), new(Int32, i));
+        }
+    }
+
+    pthread_t writer, readers[BENCH_RCU_MAX_READERS];
+    BenchRcuThread writer_args = base, reader_args[BENCH_RCU_MAX_READERS];
+    writer_args.seed = 0xD1B54A32D192ED03ul;
+
+    String name = str_format("%s, %d readers", kind_name, count);
+    uint64_t start = bench_nanos();
+    pthread_create(&writer, NULL, bench_rcu_writer, &writer_args);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        reader_args[i] = base;
+        reader_args[i].operations = BENCH_RCU_READS / count;
+        reader_args[i].seed = 0x9E3779B97F4A7C15ul + i;
+        pthread_create(&readers[i], NULL, bench_rcu_reader, &reader_args[i]);
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+    uint64_t nanos = bench_nanos() - start;
+    atomic_store(&done, true);
+    pthread_join(writer, NULL);
+
+    bench_report(name->slice, nanos, BENCH_RCU_READS);
+    println("  %-48s %10lu writes", "", writer_args.total);
+
+    del(String, name);
+    if (kind == BENCH_RCU)
+    {
+        del(RcuMap, base.rcu);
+    }
+    else if (kind == BENCH_RCU_SHARDED)
+    {
+        del(ConcurrentMap, base.sharded);
+    }
+    else
+    {
+        del(Map, base.locked);
+    }
+    pthread_mutex_destroy(&lock);
+}
+
+BENCH_GROUP(bench_rcu, {
+    for (uint32_t count = 1; count <= BENCH_RCU_MAX_READERS; count <<= 2)
+    {
+        bench_rcu_run(BENCH_RCU, "rcu", count);
+        bench_rcu_run(BENCH_RCU_SHARDED, "sharded", count);
+        bench_rcu_run(BENCH_RCU_LOCKED, "locked", count);
+    }
+});
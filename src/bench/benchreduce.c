@@ -0,0 +1,58 @@
+#include "bench.h"
+
+// Reductions
+// Sums, finds the minimum and maximum, and the index of the maximum of a PrimitiveArrayList(uint32_t) of 128M random values, with the al_ reductions, and with loops over the list's iterator, as days 2 and 6 were written.
+
+#define BENCH_REDUCE_VALUES (1 << 27)
+
+BENCH_GROUP(bench_reduce, {
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    PrimitiveArrayList(uint32_t) list = new(PrimitiveArrayList(uint32_t), BENCH_REDUCE_VALUES);
+    for (uint32_t i = 0; i < BENCH_REDUCE_VALUES; i++)
+    {
+        al_append(list, (uint32_t) bench_rand(&seed));
+    }
+
+    uint64_t sum = 0, iter_sum = 0;
+    BENCH("sum, al_sum", BENCH_REDUCE_VALUES, {
+        sum = al_sum(list);
+    });
+    BENCH("sum, iterator", BENCH_REDUCE_VALUES, {
+        for iter(PrimitiveArrayList(uint32_t), it, list)
+        {
+            iter_sum += it.value;
+        }
+    });
+    panic_if(sum != iter_sum, "Sums are not equal: %lu, %lu", sum, iter_sum);
+
+    uint32_t low = 0, high = 0, iter_low = UINT32_MAX, iter_high = 0;
+    BENCH("minmax, al_minmax", BENCH_REDUCE_VALUES, {
+        al_minmax(list, &low, &high);
+    });
+    BENCH("minmax, iterator", BENCH_REDUCE_VALUES, {
+        for iter(PrimitiveArrayList(uint32_t), it, list)
+        {
+            iter_low = min(iter_low, it.value);
+            iter_high = max(iter_high, it.value);
+        }
+    });
+    panic_if(low != iter_low || high != iter_high, "Minimum and maximum are not equal");
+
+    uint32_t index = 0, iter_index = 0, iter_max = 0;
+    BENCH("argmax, al_argmax", BENCH_REDUCE_VALUES, {
+        index = unwrap(al_argmax(list));
+    });
+    BENCH("argmax, iterator", BENCH_REDUCE_VALUES, {
+        for iter(PrimitiveArrayList(uint32_t), it, list)
+        {
+            if (it.value > iter_max)
+            {
+                iter_max = it.value;
+                iter_index = it.index;
+            }
+        }
+    });
+    panic_if(index != iter_index, "Indices of the maximum are not equal: %u, %u", index, iter_index);
+
+    del(PrimitiveArrayList(uint32_t), list);
+});
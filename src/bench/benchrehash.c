@@ -0,0 +1,40 @@
+#include "bench.h"
+
+// Resize latency
+// Every put is timed individually, as a table grows from empty. A stop-the-world resize moves every key within a single put, which shows up in the tail latency.
+// An incremental resize spreads the same work over the following puts.
+
+#define BENCH_REHASH_PUTS (1 << 22)
+
+static void bench_rehash_engine(slice_t name, HashOptions options, uint64_t* samples)
+{
+    // Deleting the previous map frees millions of small boxes, which the allocator coalesces on the next large allocation. Do that before timing anything
+    free(safe_malloc(1 << 20));
+
+    Map map = new(Map, 16, class(Int32), class(Int32), options);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+
+    for (uint32_t i = 0; i < BENCH_REHASH_PUTS; i++)
+    {
+        Int32 key = new(Int32, (int32_t) (bench_rand(&seed) >> 33));
+        uint64_t start = bench_nanos();
+        map_put(map, key, NULL);
+        samples[i] = bench_nanos() - start;
+    }
+
+    bench_report_latency(name, samples, BENCH_REHASH_PUTS);
+    del(Map, map);
+}
+
+BENCH_GROUP(bench_rehash, {
+    uint64_t* samples = safe_malloc(sizeof(uint64_t) * BENCH_REHASH_PUTS);
+
+    bench_rehash_engine("linear", HASH_LINEAR, samples);
+    bench_rehash_engine("linear incremental", HASH_LINEAR | HASH_INCREMENTAL, samples);
+    bench_rehash_engine("robin hood", HASH_ROBIN_HOOD, samples);
+    bench_rehash_engine("robin hood incremental", HASH_ROBIN_HOOD | HASH_INCREMENTAL, samples);
+    bench_rehash_engine("swiss", HASH_SWISS, samples);
+    bench_rehash_engine("swiss incremental", HASH_SWISS | HASH_INCREMENTAL, samples);
+
+    free(samples);
+});
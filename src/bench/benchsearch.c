@@ -0,0 +1,58 @@
+#include "bench.h"
+
+// Searches
+// Searches a PrimitiveArrayList(uint32_t) of 128M random values for a value which is only present at the last index, with the al_ searches, and with loops over the list's iterator calling equals().
+
+#define BENCH_SEARCH_VALUES (1 << 27)
+
+BENCH_GROUP(bench_search, {
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    PrimitiveArrayList(uint32_t) list = new(PrimitiveArrayList(uint32_t), BENCH_SEARCH_VALUES);
+    for (uint32_t i = 0; i < BENCH_SEARCH_VALUES; i++)
+    {
+        al_append(list, (uint32_t) (bench_rand(&seed) % (1u << 31))); // Never the target
+    }
+    uint32_t target = 1u << 31;
+    al_set(list, BENCH_SEARCH_VALUES - 1, target);
+
+    uint32_t index = 0, iter_index = 0;
+    BENCH("index_of, al_index_of", BENCH_SEARCH_VALUES, {
+        index = unwrap(al_index_of(list, target));
+    });
+    BENCH("index_of, iterator", BENCH_SEARCH_VALUES, {
+        for iter(PrimitiveArrayList(uint32_t), it, list)
+        {
+            if (equals(uint32_t, it.value, target))
+            {
+                iter_index = it.index;
+                break;
+            }
+        }
+    });
+    panic_if(index != iter_index, "Indices are not equal: %u, %u", index, iter_index);
+
+    uint32_t count = 0, iter_count = 0;
+    BENCH("count, al_count", BENCH_SEARCH_VALUES, {
+        count = al_count(list, target);
+    });
+    BENCH("count, iterator", BENCH_SEARCH_VALUES, {
+        for iter(PrimitiveArrayList(uint32_t), it, list)
+        {
+            if (equals(uint32_t, it.value, target))
+            {
+                iter_count++;
+            }
+        }
+    });
+    panic_if(count != 1 || iter_count != 1, "Counts are not 1: %u, %u", count, iter_count);
+
+    // The first index, so the last index is found with a full scan
+    al_set(list, BENCH_SEARCH_VALUES - 1, 0);
+    al_set(list, 0, target);
+    BENCH("last_index_of, al_last_index_of", BENCH_SEARCH_VALUES, {
+        index = unwrap(al_last_index_of(list, target));
+    });
+    panic_if(index != 0, "Expected the last index to be 0, got %u", index);
+
+    del(PrimitiveArrayList(uint32_t), list);
+});
@@ -0,0 +1,111 @@
+#include "bench.h"
+
+// Small Sets
+// Deduplicates the words of 1M records, of 4 - 15 words each, drawn from 64 short random words, as with the per-line sets in day 4.
+// Each record uses a new Set, a single Set with HASH_REUSABLE which is cleared after each record, or a single SmallSet, which is cleared after each record.
+
+#define BENCH_SMALL_RECORDS (1 << 20)
+#define BENCH_SMALL_WORDS 64
+
+static String bench_small_words[BENCH_SMALL_WORDS];
+
+// Words are borrowed from the pool, and are never copied or deleted by the sets, so only the cost of the sets is measured
+typedef String BenchWord;
+
+declare_class(BenchWord);
+impl_class(BenchWord);
+
+void BenchWord__del(BenchWord word) {}
+BenchWord BenchWord__copy(BenchWord word) { return word; }
+bool BenchWord__equals(BenchWord left, BenchWord right) { return String__equals(left, right); }
+int32_t BenchWord__compare(BenchWord left, BenchWord right) { return String__compare(left, right); }
+uint32_t BenchWord__hash(BenchWord word) { return String__hash(word); }
+String BenchWord__format(BenchWord word) { return String__format(word); }
+
+// The number of words in the next record, and the index of each word
+static uint32_t bench_small_record(uint64_t* seed, uint32_t* words)
+{
+    uint32_t length = 4 + (uint32_t) (bench_rand(seed) % 12);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        words[i] = (uint32_t) (bench_rand(seed) % BENCH_SMALL_WORDS);
+    }
+    return length;
+}
+
+static void bench_small_set(slice_t name, bool reuse, HashOptions options)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    uint32_t words[16], duplicates = 0;
+    Set set = reuse ? new(Set, 10, class(BenchWord), options) : NULL;
+    BENCH(name, BENCH_SMALL_RECORDS, {
+        for (uint32_t record = 0; record < BENCH_SMALL_RECORDS; record++)
+        {
+            uint32_t length = bench_small_record(&seed, words);
+            if (!reuse)
+            {
+                set = new(Set, 10, class(BenchWord), options);
+            }
+            for (uint32_t i = 0; i < length; i++)
+            {
+                duplicates += set_put(set, bench_small_words[words[i]]);
+            }
+            if (reuse)
+            {
+                set_clear(set);
+            }
+            else
+            {
+                del(Set, set);
+            }
+        }
+    });
+    if (reuse)
+    {
+        del(Set, set);
+    }
+    panic_if(duplicates == 0, "Some records should have duplicate words");
+}
+
+static void bench_small_small_set(slice_t name)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    uint32_t words[16], duplicates = 0;
+    SmallSet set = new(SmallSet, 10, class(BenchWord));
+    BENCH(name, BENCH_SMALL_RECORDS, {
+        for (uint32_t record = 0; record < BENCH_SMALL_RECORDS; record++)
+        {
+            uint32_t length = bench_small_record(&seed, words);
+            for (uint32_t i = 0; i < length; i++)
+            {
+                duplicates += set_put(set, bench_small_words[words[i]]);
+            }
+            set_clear(set);
+        }
+    });
+    del(SmallSet, set);
+    panic_if(duplicates == 0, "Some records should have duplicate words");
+}
+
+BENCH_GROUP(bench_small, {
+    // Random lowercase words of 2 - 7 letters, as in day 4
+    uint64_t seed = 0xD1B54A32D192ED03ul;
+    for (uint32_t i = 0; i < BENCH_SMALL_WORDS; i++)
+    {
+        String word = new(String, "");
+        for (uint32_t length = 2 + (uint32_t) (bench_rand(&seed) % 6); word->length < length;)
+        {
+            str_append_char(word, (char) ('a' + bench_rand(&seed) % 26));
+        }
+        bench_small_words[i] = word;
+    }
+
+    bench_small_set("set, new per record", false, HASH_DEFAULT);
+    bench_small_set("set, reusable", true, HASH_DEFAULT | HASH_REUSABLE);
+    bench_small_small_set("small set");
+
+    for (uint32_t i = 0; i < BENCH_SMALL_WORDS; i++)
+    {
+        del(String, bench_small_words[i]);
+    }
+});
@@ -0,0 +1,102 @@
+#include "bench.h"
+
+// Sorting
+// Sorts 10M random values in a PrimitiveArrayList(uint32_t) with al_sort(), with sorting_qsort_recursive() and it's callbacks, and with the C library qsort(). Then 10M random int64_t values with al_sort() and qsort().
+
+#define BENCH_SORT_VALUES 10000000
+
+static bool bench_sort_lt(PrimitiveArrayList(uint32_t) list, uint32_t i, uint32_t j)
+{
+    return list->values[i] < list->values[j];
+}
+
+static void bench_sort_swap(PrimitiveArrayList(uint32_t) list, uint32_t i, uint32_t j)
+{
+    uint32_t t = list->values[i];
+    list->values[i] = list->values[j];
+    list->values[j] = t;
+}
+
+static int bench_sort_compare_uint32(const void* left, const void* right)
+{
+    uint32_t l = *(const uint32_t*) left, r = *(const uint32_t*) right;
+    return (l > r) - (l < r);
+}
+
+static int bench_sort_compare_int64(const void* left, const void* right)
+{
+    int64_t l = *(const int64_t*) left, r = *(const int64_t*) right;
+    return (l > r) - (l < r);
+}
+
+static PrimitiveArrayList(uint32_t) bench_sort_uint32()
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+    PrimitiveArrayList(uint32_t) list = new(PrimitiveArrayList(uint32_t), BENCH_SORT_VALUES);
+    for (uint32_t i = 0; i < BENCH_SORT_VALUES; i++)
+    {
+        al_append(list, (uint32_t) bench_rand(&seed));
+    }
+    return list;
+}
+
+static PrimitiveArrayList(int64_t) bench_sort_int64()
+{
+    uint64_t seed = 0xD1B54A32D192ED03ul;
+    PrimitiveArrayList(int64_t) list = new(PrimitiveArrayList(int64_t), BENCH_SORT_VALUES);
+    for (uint32_t i = 0; i < BENCH_SORT_VALUES; i++)
+    {
+        al_append(list, (int64_t) bench_rand(&seed));
+    }
+    return list;
+}
+
+static void bench_sort_check_uint32(PrimitiveArrayList(uint32_t) list)
+{
+    for (uint32_t i = 1; i < list->length; i++)
+    {
+        panic_if(list->values[i - 1] > list->values[i], "List is not sorted at index %u", i);
+    }
+    del(PrimitiveArrayList(uint32_t), list);
+}
+
+static void bench_sort_check_int64(PrimitiveArrayList(int64_t) list)
+{
+    for (uint32_t i = 1; i < list->length; i++)
+    {
+        panic_if(list->values[i - 1] > list->values[i], "List is not sorted at index %u", i);
+    }
+    del(PrimitiveArrayList(int64_t), list);
+}
+
+BENCH_GROUP(bench_sort, {
+    PrimitiveArrayList(uint32_t) list = bench_sort_uint32();
+    BENCH("uint32_t, al_sort", BENCH_SORT_VALUES, {
+        al_sort(list);
+    });
+    bench_sort_check_uint32(list);
+
+    list = bench_sort_uint32();
+    BENCH("uint32_t, sorting_qsort_recursive", BENCH_SORT_VALUES, {
+        sorting_qsort_recursive(list, (FnSortingLessThan) & bench_sort_lt, (FnSortingSwap) & bench_sort_swap, 0, list->length - 1);
+    });
+    bench_sort_check_uint32(list);
+
+    list = bench_sort_uint32();
+    BENCH("uint32_t, qsort", BENCH_SORT_VALUES, {
+        qsort(list->values, list->length, sizeof(uint32_t), bench_sort_compare_uint32);
+    });
+    bench_sort_check_uint32(list);
+
+    PrimitiveArrayList(int64_t) signed_list = bench_sort_int64();
+    BENCH("int64_t, al_sort", BENCH_SORT_VALUES, {
+        al_sort(signed_list);
+    });
+    bench_sort_check_int64(signed_list);
+
+    signed_list = bench_sort_int64();
+    BENCH("int64_t, qsort", BENCH_SORT_VALUES, {
+        qsort(signed_list->values, signed_list->length, sizeof(int64_t), bench_sort_compare_int64);
+    });
+    bench_sort_check_int64(signed_list);
+});
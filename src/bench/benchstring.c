@@ -0,0 +1,70 @@
+#include "bench.h"
+
+// String keys
+// Hashing or comparing a String key reads the whole string, so these measure how often the table calls hash() and equals()
+// A map is grown from empty (so put includes every resize), then queried for keys present (hits) and absent (misses)
+
+#define BENCH_STRING_KEYS (1 << 20)
+#define BENCH_STRING_QUERIES 1000000
+
+static void bench_string_engine(slice_t engine_name, HashOptions options, String* keys, String* misses)
+{
+    Map map = new(Map, 16, class(String), class(Int32), options);
+    uint32_t found = 0;
+    String name = str_format("%s put", engine_name);
+
+    BENCH(name->slice, BENCH_STRING_KEYS, {
+        for (uint32_t i = 0; i < BENCH_STRING_KEYS; i++)
+        {
+            map_put(map, copy(String, keys[i]), NULL);
+        }
+    });
+
+    str_pop(name, 4);
+    str_append_slice(name, " hit");
+    BENCH(name->slice, BENCH_STRING_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_STRING_QUERIES; i++)
+        {
+            found += map_contains_key(map, keys[(i * 7919) % BENCH_STRING_KEYS]);
+        }
+    });
+
+    str_pop(name, 4);
+    str_append_slice(name, " miss");
+    BENCH(name->slice, BENCH_STRING_QUERIES, {
+        for (uint32_t i = 0; i < BENCH_STRING_QUERIES; i++)
+        {
+            found += map_contains_key(map, misses[i % BENCH_STRING_KEYS]);
+        }
+    });
+
+    panic_if(found != BENCH_STRING_QUERIES, "Expected exactly all hits to be found");
+
+    del(String, name);
+    del(Map, map);
+}
+
+BENCH_GROUP(bench_string, {
+    String* keys = safe_malloc(sizeof(String) * BENCH_STRING_KEYS);
+    String* misses = safe_malloc(sizeof(String) * BENCH_STRING_KEYS);
+    uint64_t seed = 0x9E3779B97F4A7C15ul;
+
+    // Keys share a long common prefix, as identifiers often do, so equals() has to compare most of the string
+    for (uint32_t i = 0; i < BENCH_STRING_KEYS; i++)
+    {
+        keys[i] = str_format("advent/of/code/2017/key/%016lx", bench_rand(&seed));
+        misses[i] = str_format("advent/of/code/2017/miss/%016lx", bench_rand(&seed));
+    }
+
+    bench_string_engine("linear", HASH_LINEAR, keys, misses);
+    bench_string_engine("robin hood", HASH_ROBIN_HOOD, keys, misses);
+    bench_string_engine("swiss", HASH_SWISS, keys, misses);
+
+    for (uint32_t i = 0; i < BENCH_STRING_KEYS; i++)
+    {
+        del(String, keys[i]);
+        del(String, misses[i]);
+    }
+    free(keys);
+    free(misses);
+});
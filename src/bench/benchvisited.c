@@ -0,0 +1,96 @@
+#include "bench.h"
+
+// Visited
+// Parallel visited state tracking: 4M random states (Int32s, about half of them duplicates) are inserted if absent, split evenly across 1 to 64 threads.
+// Compares the lock-free ConcurrentSet against a single Set guarded by one lock. Each run starts from an empty, presized set.
+
+#define BENCH_VISITED_OPERATIONS (1 << 22)
+#define BENCH_VISITED_RANGE (1 << 22)
+#define BENCH_VISITED_MAX_THREADS 64
+
+typedef struct
+{
+    ConcurrentSet set;
+    Set locked_set;
+    pthread_mutex_t* lock;
+    uint32_t operations;
+    uint64_t seed;
+    uint32_t inserted;
+} BenchVisitedThread;
+
+static void* bench_visited_thread(void* arg)
+{
+    BenchVisitedThread* thread = arg;
+    for (uint32_t i = 0; i < thread->operations; i++)
+    {
+        Int32 state = new(Int32, (int32_t) ((bench_rand(&thread->seed) >> 32) % BENCH_VISITED_RANGE));
+        if (thread->set != NULL)
+        {
+            thread->inserted += !cset_put_if_absent(thread->set, state);
+        }
+        else
+        {
+            // Set has no insert-if-absent, so check and then put
+            pthread_mutex_lock(thread->lock);
+            if (set_contains(thread->locked_set, state))
+            {
+                del(Int32, state);
+            }
+            else
+            {
+                set_put(thread->locked_set, state);
+                thread->inserted++;
+            }
+            pthread_mutex_unlock(thread->lock);
+        }
+    }
+    return NULL;
+}
+
+static void bench_visited_run(bool lock_free, uint32_t count)
+{
+    pthread_t threads[BENCH_VISITED_MAX_THREADS];
+    BenchVisitedThread args[BENCH_VISITED_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_mutex_init(&lock, NULL);
+
+    ConcurrentSet set = lock_free ? new(ConcurrentSet, BENCH_VISITED_OPERATIONS, class(Int32)) : NULL;
+    Set locked_set = lock_free ? NULL : new(Set, 16, class(Int32));
+    if (!lock_free)
+    {
+        set_reserve(locked_set, BENCH_VISITED_OPERATIONS); // Both sets are presized
+    }
+
+    String name = str_format("%s, %d threads", lock_free ? "lock-free" : "locked", count);
+    BENCH(name->slice, BENCH_VISITED_OPERATIONS, {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            args[i] = (BenchVisitedThread) { set, locked_set, &lock, BENCH_VISITED_OPERATIONS / count, 0x9E3779B97F4A7C15ul + i, 0 };
+            panic_if(pthread_create(&threads[i], NULL, bench_visited_thread, &args[i]) != 0, "Unable to create thread %d", i);
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+    });
+
+    del(String, name);
+    if (lock_free)
+    {
+        del(ConcurrentSet, set);
+    }
+    else
+    {
+        del(Set, locked_set);
+    }
+    pthread_mutex_destroy(&lock);
+    free(safe_malloc(1 << 20)); // Let the allocator coalesce freed boxes, as in benchrehash.c
+}
+
+BENCH_GROUP(bench_visited, {
+    for (uint32_t count = 1; count <= BENCH_VISITED_MAX_THREADS; count <<= 2)
+    {
+        bench_visited_run(true, count);
+        bench_visited_run(false, count);
+    }
+});
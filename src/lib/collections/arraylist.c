@@ -6,21 +6,27 @@
 // Uses Templating to achieve similar classes with proper line number references
 
 #define type char
+#define sum_type int64_t
 #include "primitivearraylist.template.c"
 
 #define type bool
+#define sum_type uint64_t
 #include "primitivearraylist.template.c"
 
 #define type int32_t
+#define sum_type int64_t
 #include "primitivearraylist.template.c"
 
 #define type int64_t
+#define sum_type int64_t
 #include "primitivearraylist.template.c"
 
 #define type uint32_t
+#define sum_type uint64_t
 #include "primitivearraylist.template.c"
 
 #define type uint64_t
+#define sum_type uint64_t
 #include "primitivearraylist.template.c"
 
 // ArrayList Class
@@ -99,7 +105,7 @@ uint32_t ArrayList__hash(ArrayList instance)
     uint32_t h = 0;
     for iter(ArrayList, it, instance)
     {
-        h = (31 * h + hash_c(instance->value_class, it.value));
+        h = hash_combine(h, hash_c(instance->value_class, it.value));
     }
     return h;
 }
@@ -143,22 +149,59 @@ void al_pointer_t_append(ArrayList list, pointer_t value)
 {
     if (list->length == list->size)
     {
-        // Resize the array
-        uint32_t old_size = list->size;
-        uint32_t new_size = old_size * 2;
-        pointer_t* new_array = safe_malloc(sizeof(pointer_t) * new_size);
-
-        memcpy(new_array, list->values, sizeof(pointer_t) * old_size);
-        free(list->values);
-
-        list->values = new_array;
-        list->size = new_size;
+        al_pointer_t_reserve(list, max(list->size * 2, 1u)); // A list may be created, or copied, with a size of 0
     }
     // Append at index length
     list->values[list->length] = value;
     list->length++;
 }
 
+void al_pointer_t_extend(ArrayList list, ArrayList other)
+{
+    panic_if(!equals(Class, list->value_class, other->value_class), "al_extend(ArrayList<%s>, ArrayList<%s>) parameters have different generic types!", list->value_class->name, other->value_class->name);
+    if (list->length + other->length > list->size)
+    {
+        al_pointer_t_reserve(list, max(list->length + other->length, list->size * 2));
+    }
+    // Read the length first, as other may be the same list
+    uint32_t length = other->length;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        list->values[list->length + i] = copy_c(list->value_class, other->values[i]);
+    }
+    list->length += length;
+}
+
+void al_pointer_t_extend_array(ArrayList list, pointer_t array[], uint32_t length)
+{
+    if (list->length + length > list->size)
+    {
+        al_pointer_t_reserve(list, max(list->length + length, list->size * 2));
+    }
+    memcpy(list->values + list->length, array, sizeof(pointer_t) * length);
+    list->length += length;
+}
+
+void al_pointer_t_reserve(ArrayList list, uint32_t size)
+{
+    if (size > list->size)
+    {
+        // realloc() can often extend the array in place, where malloc() and copying never can
+        safe_realloc(list->values, sizeof(pointer_t) * size);
+        list->size = size;
+    }
+}
+
+void al_pointer_t_shrink_to_fit(ArrayList list)
+{
+    uint32_t size = max(list->length, 1u);
+    if (size < list->size)
+    {
+        safe_realloc(list->values, sizeof(pointer_t) * size);
+        list->size = size;
+    }
+}
+
 void al_pointer_t_clear(ArrayList list)
 {
     for iter(ArrayList, it, list)
@@ -12,6 +12,7 @@
 // - It is typed as ArrayList
 
 #include "../lib.h"
+#include "result.h"
 
 #ifndef COLLECTIONS_ARRAY_LIST_H
 #define COLLECTIONS_ARRAY_LIST_H
@@ -29,32 +30,97 @@
     ArrayList_uint64_t : al_uint64_t_ ## method, \
     default: al_pointer_t_ ## method)
 
+// As above, but for methods only implemented by PrimitiveArrayList(type)
+#define PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, method) _Generic((list), \
+    ArrayList_char : al_char_ ## method, \
+    ArrayList_bool : al_bool_ ## method, \
+    ArrayList_int32_t : al_int32_t_ ## method, \
+    ArrayList_int64_t : al_int64_t_ ## method, \
+    ArrayList_uint32_t : al_uint32_t_ ## method, \
+    ArrayList_uint64_t : al_uint64_t_ ## method)
+
 // All ArrayList Instance Methods - Delegated through generic prefixing
 
 #define al_get(list, index) ARRAY_LIST_GENERIC_PREFIX(list, get) (list, index)
 #define al_set(list, index, value) ARRAY_LIST_GENERIC_PREFIX(list, set) (list, index, value)
 #define al_append(list, value) ARRAY_LIST_GENERIC_PREFIX(list, append) (list, value)
 #define al_clear(list) ARRAY_LIST_GENERIC_PREFIX(list, clear) (list)
+#define al_extend(list, other) ARRAY_LIST_GENERIC_PREFIX(list, extend) (list, other)
+#define al_extend_array(list, array, length) ARRAY_LIST_GENERIC_PREFIX(list, extend_array) (list, array, length)
+#define al_reserve(list, size) ARRAY_LIST_GENERIC_PREFIX(list, reserve) (list, size)
+#define al_shrink_to_fit(list) ARRAY_LIST_GENERIC_PREFIX(list, shrink_to_fit) (list)
+
+// Reductions, for PrimitiveArrayList(type) only
+// al_sum() returns an int64_t for signed types, and uint64_t for unsigned types and bool, so it can't overflow the list's type
+// al_min(), al_max() return a Result(type), and al_argmax() a Result(uint32_t), which is Err if the list is empty
+// al_minmax() returns false if the list is empty, otherwise stores both the minimum and maximum
+
+#define al_sum(list) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, sum) (list)
+#define al_min(list) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, min) (list)
+#define al_max(list) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, max) (list)
+#define al_minmax(list, min_value, max_value) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, minmax) (list, min_value, max_value)
+#define al_argmax(list) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, argmax) (list)
+
+// Searches, for PrimitiveArrayList(type) only
+// al_index_of() and al_last_index_of() return a Result(uint32_t) of the first or last index of a value, which is Err if it is not present
+
+#define al_index_of(list, value) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, index_of) (list, value)
+#define al_last_index_of(list, value) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, last_index_of) (list, value)
+#define al_count(list, value) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, count) (list, value)
+#define al_contains(list, value) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, contains) (list, value)
+
+// Sorts the list in ascending order, with a LSD radix sort, one byte at a time. For PrimitiveArrayList(type) only
+#define al_sort(list) PRIMITIVE_ARRAY_LIST_GENERIC_PREFIX(list, sort) (list)
+
+// Kernels
+// A kernel is a loop over an array which the compiler can vectorize. ARRAY_LIST_KERNEL(ret, name, params, args, body) defines it twice, compiled for AVX2, and for the baseline of the target (SSE2 on x86-64),
+// and defines name(params) which calls one of them, checking the CPU's features at runtime, as the library is not compiled for a specific CPU.
+// This doesn't use target_clones, as resolving a function when the program is loaded happens before, and crashes, the thread sanitizer.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARRAY_LIST_KERNEL(ret, name, params, args, body...) \
+    __attribute__((target("avx2"))) static ret CONCAT(name, _avx2) params body \
+    static ret CONCAT(name, _baseline) params body \
+    static ret name params { return __builtin_cpu_supports("avx2") ? CONCAT(name, _avx2) args : CONCAT(name, _baseline) args; }
+#else
+#define ARRAY_LIST_KERNEL(ret, name, params, args, body...) static ret name params body
+#endif
+
+// The number of values in each block of al_argmax(), which finds the maximum of each block, and then scans just the block containing the first maximum
+#define ARRAY_LIST_ARGMAX_BLOCK 1024
+
+// The number of values in each block of al_index_of() and al_last_index_of(), which count the matches in each block, and then scan just the first block with a match
+// A loop which exits early can't be vectorized, so a smaller block stops sooner after a match, and a larger block branches less often
+#define ARRAY_LIST_SEARCH_BLOCK 64
+
+// Lists shorter than this are sorted by al_sort() with an insertion sort, as counting every digit costs more than sorting them
+#define ARRAY_LIST_RADIX_MIN_LENGTH 64
 
 // Primitive Type Array List
 // Uses Templating to achieve similar classes with proper line number references
 
 #define type char
+#define sum_type int64_t
 #include "primitivearraylist.template.h"
 
 #define type bool
+#define sum_type uint64_t
 #include "primitivearraylist.template.h"
 
 #define type int32_t
+#define sum_type int64_t
 #include "primitivearraylist.template.h"
 
 #define type int64_t
+#define sum_type int64_t
 #include "primitivearraylist.template.h"
 
 #define type uint32_t
+#define sum_type uint64_t
 #include "primitivearraylist.template.h"
 
 #define type uint64_t
+#define sum_type uint64_t
 #include "primitivearraylist.template.h"
 
 // Iterator Macros for Primitive ArrayLists
@@ -120,6 +186,11 @@ pointer_t al_pointer_t_get(ArrayList list, uint32_t index); // Gets the element
 
 void al_pointer_t_set(ArrayList list, uint32_t index, pointer_t value); // Overwrites an element at a specific index. Panics if the index is out of range.
 void al_pointer_t_append(ArrayList list, pointer_t value); // Appends a new element to the list. Resizes the list if nessecary.
+void al_pointer_t_extend(ArrayList list, ArrayList other); // Appends a copy of every element of other, which is borrowed. Resizes the list at most once.
+void al_pointer_t_extend_array(ArrayList list, pointer_t array[], uint32_t length); // Appends every element of an array, taking ownership of each element. Resizes the list at most once.
+
+void al_pointer_t_reserve(ArrayList list, uint32_t size); // Resizes the backing array to hold at least size elements, so they can be appended without resizing again.
+void al_pointer_t_shrink_to_fit(ArrayList list); // Resizes the backing array to the length of the list, freeing any unused memory.
 
 void al_pointer_t_clear(ArrayList list); // Removes all elements
 
@@ -0,0 +1,207 @@
+#include "bitset.h"
+
+// Private Methods
+
+static void bs_grow(BitSet set, uint32_t size);
+static uint32_t bs_popcount(const uint64_t* words, uint32_t length);
+
+
+BitSet BitSet__new(uint32_t initial_size)
+{
+    BitSet set = class_malloc(BitSet);
+
+    set->size = max(1u, (initial_size + BIT_SET_WORD_BITS - 1) / BIT_SET_WORD_BITS);
+    set->words = safe_calloc(sizeof(uint64_t) * set->size);
+
+    return set;
+}
+
+void BitSet__del(BitSet set)
+{
+    free(set->words);
+    free(set);
+}
+
+String BitSet__format(BitSet set)
+{
+    String s = new(String, "BitSet{");
+    bool first = true;
+    for iter(BitSet, it, set)
+    {
+        if (!first)
+        {
+            str_append(s, ", ");
+        }
+        str_append(s, format(uint32_t, it.value));
+        first = false;
+    }
+    str_append(s, "}");
+    return s;
+}
+
+
+// Iterator
+
+bool BitSet__iterator__test(Iterator(BitSet)* it, BitSet set)
+{
+    while (it->word == 0)
+    {
+        if (it->index >= set->size)
+        {
+            return false;
+        }
+        it->word = set->words[it->index++];
+    }
+    it->value = (it->index - 1) * BIT_SET_WORD_BITS + __builtin_ctzll(it->word);
+    return true;
+}
+
+
+// Instance Methods
+
+bool bs_set(BitSet set, uint32_t index)
+{
+    uint32_t word = index / BIT_SET_WORD_BITS;
+    uint64_t bit = (uint64_t) 1 << (index % BIT_SET_WORD_BITS);
+    if (word >= set->size)
+    {
+        bs_grow(set, word + 1);
+    }
+    bool present = (set->words[word] & bit) != 0;
+    set->words[word] |= bit;
+    return present;
+}
+
+bool bs_clear(BitSet set, uint32_t index)
+{
+    uint32_t word = index / BIT_SET_WORD_BITS;
+    uint64_t bit = (uint64_t) 1 << (index % BIT_SET_WORD_BITS);
+    if (word >= set->size)
+    {
+        return false;
+    }
+    bool present = (set->words[word] & bit) != 0;
+    set->words[word] &= ~bit;
+    return present;
+}
+
+bool bs_test(BitSet set, uint32_t index)
+{
+    uint32_t word = index / BIT_SET_WORD_BITS;
+    return word < set->size && (set->words[word] & ((uint64_t) 1 << (index % BIT_SET_WORD_BITS))) != 0;
+}
+
+void bs_clear_all(BitSet set)
+{
+    memset(set->words, 0, sizeof(uint64_t) * set->size);
+}
+
+uint32_t bs_count(BitSet set)
+{
+    return bs_popcount(set->words, set->size);
+}
+
+uint32_t bs_rank(BitSet set, uint32_t index)
+{
+    uint32_t word = index / BIT_SET_WORD_BITS;
+    if (word >= set->size)
+    {
+        return bs_popcount(set->words, set->size);
+    }
+    uint64_t below = ((uint64_t) 1 << (index % BIT_SET_WORD_BITS)) - 1; // The bits of the last word less than index
+    return bs_popcount(set->words, word) + __builtin_popcountll(set->words[word] & below);
+}
+
+void bs_and(BitSet set, BitSet other)
+{
+    uint32_t length = min(set->size, other->size);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        set->words[i] &= other->words[i];
+    }
+    if (set->size > length)
+    {
+        memset(set->words + length, 0, sizeof(uint64_t) * (set->size - length)); // Not set in other
+    }
+}
+
+void bs_or(BitSet set, BitSet other)
+{
+    if (other->size > set->size)
+    {
+        bs_grow(set, other->size);
+    }
+    for (uint32_t i = 0; i < other->size; i++)
+    {
+        set->words[i] |= other->words[i];
+    }
+}
+
+void bs_xor(BitSet set, BitSet other)
+{
+    if (other->size > set->size)
+    {
+        bs_grow(set, other->size);
+    }
+    for (uint32_t i = 0; i < other->size; i++)
+    {
+        set->words[i] ^= other->words[i];
+    }
+}
+
+void bs_andnot(BitSet set, BitSet other)
+{
+    uint32_t length = min(set->size, other->size);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        set->words[i] &= ~other->words[i];
+    }
+}
+
+
+// Private Methods
+
+// Grows the set to at least the given number of words, at least doubling it's size. The new words are cleared
+static void bs_grow(BitSet set, uint32_t size)
+{
+    uint32_t new_size = max(size, set->size * 2);
+    safe_realloc(set->words, sizeof(uint64_t) * new_size);
+    memset(set->words + set->size, 0, sizeof(uint64_t) * (new_size - set->size));
+    set->size = new_size;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// The library is not compiled for a specific CPU, so without this, __builtin_popcountll() is a call to a portable bit counting function
+__attribute__((target("popcnt")))
+static uint32_t bs_popcount_native(const uint64_t* words, uint32_t length)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        count += __builtin_popcountll(words[i]);
+    }
+    return count;
+}
+#endif
+
+static uint32_t bs_popcount_portable(const uint64_t* words, uint32_t length)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        count += __builtin_popcountll(words[i]);
+    }
+    return count;
+}
+
+// Counts the set bits of an array of words, with the popcnt instruction if the CPU supports it
+static uint32_t bs_popcount(const uint64_t* words, uint32_t length)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("popcnt"))
+    {
+        return bs_popcount_native(words, length);
+    }
+#endif
+    return bs_popcount_portable(words, length);
+}
@@ -0,0 +1,65 @@
+// A dense set of unsigned integers, stored as one bit per integer in an array of 64 bit words
+// This uses 8x less memory than a PrimitiveArrayList(bool), and 64x less than the keys array of a Set<Int32>, for integers in a dense range such as the indices of a visited array.
+// Counting uses the hardware popcount instruction where the CPU supports it, and set bits are iterated a word at a time.
+// The set grows to fit any integer which is set, and integers outside of it's size are not contained.
+
+#include "../lib.h"
+
+#ifndef COLLECTIONS_BIT_SET_H
+#define COLLECTIONS_BIT_SET_H
+
+// The number of bits in each word
+#define BIT_SET_WORD_BITS 64
+
+struct BitSet__struct
+{
+    uint64_t* words; // The bits, where integer i is bit (i % 64) of word (i / 64)
+    uint32_t size; // The number of words. The set holds integers in [0, 64 * size)
+};
+
+typedef struct BitSet__struct * BitSet;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+
+// Creates an empty set, able to hold integers in [0, initial_size) without growing
+declare_constructor(BitSet, uint32_t initial_size);
+
+void BitSet__del(BitSet set);
+String BitSet__format(BitSet set);
+
+// Iterator
+// Iterates the set integers in ascending order, visiting each word once, and each set bit in a word by it's trailing zero count
+
+typedef struct
+{
+    uint32_t index; // The index of the next word
+    uint64_t word; // The bits of the current word which have not yet been visited
+    uint32_t value; // The current integer
+} Iterator(BitSet);
+
+bool BitSet__iterator__test(Iterator(BitSet)* it, BitSet set);
+
+#define BitSet__iterator__start(set) { 0, 0, 0 }
+#define BitSet__iterator__next(it, set) (it)->word &= (it)->word - 1 // Clears the lowest set bit
+
+
+// Public Instance Methods - these all borrow the set
+
+bool bs_set(BitSet set, uint32_t index); // Sets an integer, growing the set if needed. Returns true if it was already set
+bool bs_clear(BitSet set, uint32_t index); // Clears an integer. Returns true if it was set
+bool bs_test(BitSet set, uint32_t index); // Returns true if an integer is set
+
+void bs_clear_all(BitSet set); // Clears every integer, keeping the size of the set
+
+uint32_t bs_count(BitSet set); // Returns the number of set integers
+uint32_t bs_rank(BitSet set, uint32_t index); // Returns the number of set integers less than index
+
+// Bulk operations, which modify set in place, a word at a time. These borrow other, which may be a different size
+void bs_and(BitSet set, BitSet other); // Keeps only the integers also set in other
+void bs_or(BitSet set, BitSet other); // Sets every integer set in other, growing the set if needed
+void bs_xor(BitSet set, BitSet other); // Flips every integer set in other, growing the set if needed
+void bs_andnot(BitSet set, BitSet other); // Clears every integer set in other
+
+#endif
@@ -0,0 +1,158 @@
+#include "concurrentmap.h"
+
+// Private Methods
+
+static uint32_t cmap_hash(ConcurrentMap map, pointer_t key);
+static ConcurrentMapShard* cmap_shard(ConcurrentMap map, uint32_t h);
+
+
+// The name is parenthesized, as ConcurrentMap__new() is also a macro supplying the default options
+ConcurrentMap (ConcurrentMap__new)(uint32_t shard_count, uint32_t initial_size, Class key_class, Class value_class, HashOptions options)
+{
+    shard_count = next_highest_power_of_two(max(shard_count, 1u));
+    ConcurrentMap map = class_malloc(ConcurrentMap);
+
+    map->key_class = key_class;
+    map->value_class = value_class;
+    map->shard_count = shard_count;
+    map->shard_shift = 64 - __builtin_ctz(shard_count);
+
+    map->shards = aligned_alloc(_Alignof(ConcurrentMapShard), sizeof(ConcurrentMapShard) * shard_count);
+    panic_if_null(map->shards, "Out of Memory: Cannot allocate %d shards", shard_count);
+
+    for (uint32_t i = 0; i < shard_count; i++)
+    {
+        ConcurrentMapShard* shard = &map->shards[i];
+        panic_if(pthread_mutex_init(&shard->lock, NULL) != 0, "Unable to create lock for shard %d", i);
+        shard->map = new(Map, initial_size, key_class, value_class, options);
+    }
+
+    return map;
+}
+
+void ConcurrentMap__del(ConcurrentMap map)
+{
+    for (uint32_t i = 0; i < map->shard_count; i++)
+    {
+        ConcurrentMapShard* shard = &map->shards[i];
+        pthread_mutex_destroy(&shard->lock);
+        del(Map, shard->map);
+    }
+    free(map->shards);
+    free(map);
+}
+
+String ConcurrentMap__format(ConcurrentMap map)
+{
+    String s = new(String, "ConcurrentMap<");
+    str_append(s, map->key_class->name);
+    str_append(s, ", ");
+    str_append(s, map->value_class->name);
+    str_append(s, ">{");
+
+    bool empty = true;
+    for (uint32_t i = 0; i < map->shard_count; i++)
+    {
+        ConcurrentMapShard* shard = &map->shards[i];
+        for iter(Map, it, shard->map)
+        {
+            str_append(s, format_c(map->key_class, it.key));
+            str_append(s, ": ");
+            str_append(s, format_c(map->value_class, it.value));
+            str_append(s, ", ");
+            empty = false;
+        }
+    }
+    if (!empty)
+    {
+        str_pop(s, 2); // Pop the last ', '
+    }
+    str_append(s, "}");
+    return s;
+}
+
+
+// Instance Methods
+
+bool cmap_put(ConcurrentMap map, pointer_t key, pointer_t value)
+{
+    uint32_t h = cmap_hash(map, key); // Hashed once, outside the lock, and used to select both the shard and the slot within it
+    ConcurrentMapShard* shard = cmap_shard(map, h);
+    pthread_mutex_lock(&shard->lock);
+    bool present = map_put_hashed(shard->map, key, value, h);
+    pthread_mutex_unlock(&shard->lock);
+    return present;
+}
+
+bool cmap_contains_key(ConcurrentMap map, pointer_t key)
+{
+    uint32_t h = cmap_hash(map, key);
+    ConcurrentMapShard* shard = cmap_shard(map, h);
+    pthread_mutex_lock(&shard->lock);
+    bool present = map_contains_key_hashed(shard->map, key, h);
+    pthread_mutex_unlock(&shard->lock);
+    return present;
+}
+
+pointer_t cmap_get(ConcurrentMap map, pointer_t key)
+{
+    uint32_t h = cmap_hash(map, key);
+    ConcurrentMapShard* shard = cmap_shard(map, h);
+    pthread_mutex_lock(&shard->lock);
+    pointer_t value = map_get_hashed(shard->map, key, h);
+    value = value != NULL ? copy_c(map->value_class, value) : NULL; // Copy while holding the lock, as another thread may delete the value once it is released
+    pthread_mutex_unlock(&shard->lock);
+    return value;
+}
+
+pointer_t cmap_get_or_insert(ConcurrentMap map, pointer_t key, pointer_t value)
+{
+    uint32_t h = cmap_hash(map, key);
+    ConcurrentMapShard* shard = cmap_shard(map, h);
+    pthread_mutex_lock(&shard->lock);
+    pointer_t current = map_get_or_insert_hashed(shard->map, key, value, h);
+    current = current != NULL ? copy_c(map->value_class, current) : NULL;
+    pthread_mutex_unlock(&shard->lock);
+    return current;
+}
+
+bool cmap_remove(ConcurrentMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value)
+{
+    uint32_t h = cmap_hash(map, key);
+    ConcurrentMapShard* shard = cmap_shard(map, h);
+    pthread_mutex_lock(&shard->lock);
+    bool present = map_remove_hashed(shard->map, key, h, removed_key, removed_value);
+    pthread_mutex_unlock(&shard->lock);
+    return present;
+}
+
+uint32_t cmap_length(ConcurrentMap map)
+{
+    uint32_t length = 0;
+    for (uint32_t i = 0; i < map->shard_count; i++)
+    {
+        ConcurrentMapShard* shard = &map->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        length += shard->map->length;
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return length;
+}
+
+
+// Private Methods
+
+// Hashes a key, with the key class' hash. The map of each shard derives it's own hash from this.
+static uint32_t cmap_hash(ConcurrentMap map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: ConcurrentMap key must not be null.");
+    return hash_c(map->key_class, key);
+}
+
+// Selects the shard for a key's hash, from the top bits of a 64 bit multiplicative (Fibonacci) hash of it
+// Each shard's map stores the 32 bit mixed hash, and uses both it's low bits (for the slot) and it's top bits (for the h2 tag of the Swiss engine). Selecting the shard from either would leave all keys of a shard with the same few bits, so the remix must be independent of it.
+static ConcurrentMapShard* cmap_shard(ConcurrentMap map, uint32_t h)
+{
+    uint32_t index = map->shard_count == 1 ? 0 : (uint32_t) ((h * 0x9E3779B97F4A7C15ul) >> map->shard_shift);
+    return &map->shards[index];
+}
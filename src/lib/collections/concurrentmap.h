@@ -0,0 +1,67 @@
+// A thread safe Hash Map for generic key and value types
+// The keyspace is split by hash into a power of two number of shards. Each shard is an independent Map, guarded by it's own lock, so threads operating on different shards never contend.
+// Values stored in the map may be replaced or deleted by another thread at any time, so values are never borrowed out of the map. Instead, gets return a copy.
+
+#include "../lib.h"
+#include "hashtable.h"
+#include "map.h"
+
+#ifndef COLLECTIONS_CONCURRENT_MAP_H
+#define COLLECTIONS_CONCURRENT_MAP_H
+
+// Each shard is aligned to (and padded to) a cache line, so locking one shard does not contend with it's neighbours
+typedef struct
+{
+    _Alignas(64) pthread_mutex_t lock; // Guards all access to the map
+    Map map;
+} ConcurrentMapShard;
+
+struct ConcurrentMap__struct
+{
+    ConcurrentMapShard* shards; // Shard array
+    Class key_class; // The key class
+    Class value_class; // The value class
+    uint32_t shard_count; // The number of shards. Must be a power of 2
+    uint32_t shard_shift; // The shift from a 64 bit multiplicative hash of a hash to it's shard index
+};
+
+typedef struct ConcurrentMap__struct * ConcurrentMap;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+// Neither del() nor format() are thread safe, and must not be called while other threads are using the map.
+
+// shard_count is rounded up to a power of two. initial_size is the initial size of each shard, and options are passed to each shard's Map
+declare_constructor(ConcurrentMap, uint32_t shard_count, uint32_t initial_size, Class key_class, Class value_class, HashOptions options);
+
+// The options are optional, new(ConcurrentMap, shard_count, initial_size, key_class, value_class) will use HASH_DEFAULT
+#define ConcurrentMap__new(shard_count, initial_size, key_class, value_class, options...) ConcurrentMap__new(shard_count, initial_size, key_class, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
+void ConcurrentMap__del(ConcurrentMap map);
+String ConcurrentMap__format(ConcurrentMap map);
+
+
+// Public Instance Methods - these all borrow the map, and are thread safe
+
+// Puts a (key, value) pair into the map, as with map_put(). Ownership of both the key and value is given to the map. Returns true if the key was already in the map
+bool cmap_put(ConcurrentMap map, pointer_t key, pointer_t value);
+
+// Checks if a key is present in the map.
+bool cmap_contains_key(ConcurrentMap map, pointer_t key);
+
+// Gets a copy of the value associated to a key, or NULL if there was none. The returned value is owned by the caller.
+pointer_t cmap_get(ConcurrentMap map, pointer_t key);
+
+// Gets a copy of the value associated to a key, or inserts (key, value) if it is absent, with a single lock and probe. The returned value is a copy, owned by the caller.
+// Ownership of both the key and value is given to the map. If the key was already present, they are deleted.
+// When multiple threads race to insert the same key, exactly one value is inserted, and all threads receive a copy of it.
+pointer_t cmap_get_or_insert(ConcurrentMap map, pointer_t key, pointer_t value);
+
+// Removes a key from the map, as with map_remove(). Returns true if the key was present.
+bool cmap_remove(ConcurrentMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value);
+
+// Returns the total number of keys in the map. Each shard is locked in turn, so this is not a consistent snapshot if other threads are modifying the map.
+uint32_t cmap_length(ConcurrentMap map);
+
+#endif
@@ -0,0 +1,155 @@
+#include "concurrentset.h"
+
+// Private Methods
+
+static uint32_t cset_hash(ConcurrentSet set, pointer_t value);
+static uint32_t cset_slot_hash(ConcurrentSet set, ConcurrentSetSlot* slot, pointer_t slot_value);
+
+
+ConcurrentSet ConcurrentSet__new(uint32_t capacity, Class value_class)
+{
+    uint32_t size = next_highest_power_of_two(max((uint32_t) (capacity / HASH_LINEAR_LOAD_FACTOR) + 1, 16u));
+    ConcurrentSet set = class_malloc(ConcurrentSet);
+
+    set->value_class = value_class;
+    set->size = size;
+    set->capacity = (uint32_t) (size * HASH_LINEAR_LOAD_FACTOR);
+    set->slots = safe_calloc(sizeof(ConcurrentSetSlot) * size); // NULL values and zero hashes
+    atomic_init(&set->length, 0);
+    atomic_init(&set->reserved, 0);
+
+    return set;
+}
+
+void ConcurrentSet__del(ConcurrentSet set)
+{
+    for iter(ConcurrentSet, it, set)
+    {
+        del_c(set->value_class, it.value);
+    }
+    free(set->slots);
+    free(set);
+}
+
+String ConcurrentSet__format(ConcurrentSet set)
+{
+    String s = new(String, "ConcurrentSet<");
+    str_append(s, set->value_class->name);
+    str_append(s, ">{");
+    if (atomic_load(&set->length) == 0)
+    {
+        str_append(s, "}");
+        return s;
+    }
+    else
+    {
+        for iter(ConcurrentSet, it, set)
+        {
+            str_append(s, format_c(set->value_class, it.value));
+            str_append(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append(s, "}");
+    return s;
+}
+
+
+// Iterator
+
+bool ConcurrentSet__iterator__test(Iterator(ConcurrentSet)* it, ConcurrentSet set)
+{
+    for (;it->index < set->size; it->index++) // Don't iterate off the end of the set
+    {
+        pointer_t value = atomic_load_explicit(&set->slots[it->index].value, memory_order_relaxed); // Stop at valid locations
+        if (value != NULL)
+        {
+            it->value = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Instance Methods
+
+// A value is inserted by publishing it into the first empty slot of it's probe sequence with a compare-and-swap, and only then storing it's hash.
+// Any thread which reads a slot with a value, but no hash yet, computes the hash itself, so no thread ever waits on another, except to insert into a set which is at capacity.
+// As values are never removed, the probe sequence for a value only ever grows, and two equal values always race for the same slots, so only one is inserted.
+// Before publishing, a thread reserves a value of the capacity, and gives it back if it loses the race. So the set never holds more than capacity values, and always has empty slots.
+bool cset_put_if_absent(ConcurrentSet set, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: ConcurrentSet value must not be null.");
+
+    uint32_t h = cset_hash(set, value);
+    uint32_t mask = set->size - 1;
+    uint32_t index = h & mask;
+    for (;;)
+    {
+        ConcurrentSetSlot* slot = &set->slots[index];
+        pointer_t current = atomic_load_explicit(&slot->value, memory_order_acquire);
+        if (current == NULL)
+        {
+            if (atomic_fetch_add_explicit(&set->reserved, 1, memory_order_relaxed) >= set->capacity)
+            {
+                // Every value of the capacity is reserved. If they are all inserted, the set is full. Otherwise, another thread may be about to publish an equal value here, or give back it's reservation, so wait for it, and retry this slot
+                atomic_fetch_sub_explicit(&set->reserved, 1, memory_order_relaxed);
+                panic_if(atomic_load_explicit(&set->length, memory_order_acquire) >= set->capacity && atomic_load_explicit(&slot->value, memory_order_acquire) == NULL, "ConcurrentSet is full: capacity = %d", set->capacity);
+                continue;
+            }
+            if (atomic_compare_exchange_strong_explicit(&slot->value, &current, value, memory_order_acq_rel, memory_order_acquire))
+            {
+                atomic_store_explicit(&slot->hash, h, memory_order_release);
+                atomic_fetch_add_explicit(&set->length, 1, memory_order_release);
+                return false; // Inserted
+            }
+            // Another thread published a value into this slot first, which is now in current. Give back the reservation, and check it as any other value
+            atomic_fetch_sub_explicit(&set->reserved, 1, memory_order_relaxed);
+        }
+        if (cset_slot_hash(set, slot, current) == h && equals_c(set->value_class, current, value))
+        {
+            del_c(set->value_class, value);
+            return true; // Already present
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+bool cset_contains(ConcurrentSet set, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: ConcurrentSet value must not be null.");
+
+    uint32_t h = cset_hash(set, value);
+    uint32_t mask = set->size - 1;
+    for (uint32_t index = h & mask;; index = (index + 1) & mask) // The set always has empty slots, as it's capacity is below it's size - so this is gaurenteed to terminate
+    {
+        ConcurrentSetSlot* slot = &set->slots[index];
+        pointer_t current = atomic_load_explicit(&slot->value, memory_order_acquire);
+        if (current == NULL)
+        {
+            return false; // No match
+        }
+        if (cset_slot_hash(set, slot, current) == h && equals_c(set->value_class, current, value))
+        {
+            return true; // Match
+        }
+    }
+}
+
+
+// Private Methods
+
+// Hashes are mixed, as with the group engine, and 0 is reserved to indicate a hash which has not been written
+static uint32_t cset_hash(ConcurrentSet set, pointer_t value)
+{
+    uint32_t h = hash_mix(hash_c(set->value_class, value));
+    return h != 0 ? h : 1;
+}
+
+// Gets the hash of a slot, which holds slot_value. If the inserting thread has not yet stored it, it is computed
+static uint32_t cset_slot_hash(ConcurrentSet set, ConcurrentSetSlot* slot, pointer_t slot_value)
+{
+    uint32_t h = atomic_load_explicit(&slot->hash, memory_order_acquire);
+    return h != 0 ? h : cset_hash(set, slot_value);
+}
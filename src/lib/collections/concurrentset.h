@@ -0,0 +1,67 @@
+// A lock-free Hash Set for generic value types
+// Uses a fixed size backing array with linear probing. Values are published into empty slots with a compare-and-swap, and lookups never lock.
+// Values are never removed or moved, so the set cannot be resized. It must be created with a capacity for every value that will be inserted.
+
+#include "../lib.h"
+#include "hashtable.h"
+
+#include <stdatomic.h>
+
+#ifndef COLLECTIONS_CONCURRENT_SET_H
+#define COLLECTIONS_CONCURRENT_SET_H
+
+typedef struct
+{
+    _Atomic(pointer_t) value; // The value, or NULL for an empty slot. Once set, a slot's value never changes
+    _Atomic(uint32_t) hash; // The (mixed) hash of the value, or 0 if it has not yet been written
+} ConcurrentSetSlot;
+
+struct ConcurrentSet__struct
+{
+    ConcurrentSetSlot* slots; // Slot array
+    Class value_class; // The value class
+    uint32_t size; // The length of the backing array. Must be a power of 2
+    uint32_t capacity; // The maximum number of values, which keeps the load factor at most HASH_LINEAR_LOAD_FACTOR
+    _Atomic(uint32_t) length; // The number of values
+    _Atomic(uint32_t) reserved; // The number of values, and of slots reserved by threads which are inserting a value. At most capacity
+};
+
+typedef struct ConcurrentSet__struct * ConcurrentSet;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+// Neither del() nor format() are thread safe, and must not be called while other threads are using the set.
+
+// The set can hold at least capacity values. Inserting more will panic.
+declare_constructor(ConcurrentSet, uint32_t capacity, Class value_class);
+
+void ConcurrentSet__del(ConcurrentSet set);
+String ConcurrentSet__format(ConcurrentSet set);
+
+// Iterator
+// This is not thread safe, and must not be used while other threads are inserting into the set
+
+typedef struct
+{
+    uint32_t index;
+    pointer_t value;
+} Iterator(ConcurrentSet);
+
+bool ConcurrentSet__iterator__test(Iterator(ConcurrentSet)* it, ConcurrentSet set);
+
+#define ConcurrentSet__iterator__start(set) { 0, NULL }
+#define ConcurrentSet__iterator__next(it, set) (it)->index++
+
+
+// Public Instance Methods - these all borrow the set, and are thread safe and lock-free
+
+// Inserts a value into the set, if it is not already present. Returns true if the value was already in the set.
+// Ownership of the value is given to the set. If it was already present, the value is deleted, and the value in the set is kept.
+// When multiple threads race to insert equal values, exactly one of them inserts it's value, and returns false.
+bool cset_put_if_absent(ConcurrentSet set, pointer_t value);
+
+// Checks if a value is present in the set.
+bool cset_contains(ConcurrentSet set, pointer_t value);
+
+#endif
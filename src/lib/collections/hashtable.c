@@ -0,0 +1,217 @@
+#include "hashtable.h"
+
+// Diagnostics
+
+typedef struct
+{
+    pointer_t table; // The registered table, or NULL if this entry is free
+    FnHashStatsName name; // Produces the name of the table
+    FnHashStats stats; // Produces the stats of the table
+    uint32_t next_free; // If this entry is free, the next free entry, or UINT32_MAX
+} HashStatsEntry;
+
+typedef struct
+{
+    String name; // The name shared by the deleted tables
+    uint32_t tables; // The number of deleted tables
+    HashStats total; // The sum of the stats of each table, except for the maximums, and the mean probe length, which is the sum weighted by length
+} HashStatsDeleted;
+
+static pthread_once_t hash_stats_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t hash_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool hash_stats_enabled = false;
+
+static HashStatsEntry* hash_stats_entries = NULL; // Registered tables, with deleted tables' entries reused, so this holds at most as many entries as tables were ever live at once
+static uint32_t hash_stats_length = 0;
+static uint32_t hash_stats_size = 0;
+static uint32_t hash_stats_free = UINT32_MAX; // The first free entry, or UINT32_MAX
+
+static HashStatsDeleted* hash_stats_deleted = NULL; // Totals of deleted tables, one for each name
+static uint32_t hash_stats_deleted_length = 0;
+
+static void hash_stats_init();
+static void hash_stats_fold(String name, HashStats stats);
+static void hash_stats_dump();
+
+
+String hash_stats_format(HashStats stats)
+{
+    String s = str_format("length %u, capacity %u, load %.3f (max %.3f), tombstones %u, probe length mean %.3f max %u, clusters {", stats.length, stats.capacity, stats.load_factor, stats.max_load_factor, stats.tombstones, stats.mean_probe_length, stats.max_probe_length);
+    bool first = true;
+    for (uint32_t i = 0; i < HASH_STATS_BUCKETS; i++)
+    {
+        if (stats.clusters[i] != 0)
+        {
+            // Buckets hold lengths [2^i, 2^(i + 1)), except the first (exactly 1) and the last (2^i or more)
+            String bucket = i == 0 ? str_format("1: %u", stats.clusters[i]) : i == HASH_STATS_BUCKETS - 1 ? str_format("%u+: %u", 1u << i, stats.clusters[i]) : str_format("%u-%u: %u", 1u << i, (2u << i) - 1, stats.clusters[i]);
+            if (!first)
+            {
+                str_append(s, ", ");
+            }
+            str_append(s, bucket);
+            first = false;
+        }
+    }
+    str_append(s, str_format("}, rehashes %u, %lu bytes", stats.rehashes, stats.bytes));
+    return s;
+}
+
+uint32_t hash_stats_register(pointer_t table, FnHashStatsName name, FnHashStats stats)
+{
+    pthread_once(&hash_stats_once, &hash_stats_init);
+    if (!hash_stats_enabled)
+    {
+        return UINT32_MAX;
+    }
+
+    pthread_mutex_lock(&hash_stats_lock);
+    uint32_t id = hash_stats_free;
+    if (id != UINT32_MAX)
+    {
+        hash_stats_free = hash_stats_entries[id].next_free;
+    }
+    else
+    {
+        if (hash_stats_length == hash_stats_size)
+        {
+            hash_stats_size = max(hash_stats_size * 2, 16u);
+            safe_realloc(hash_stats_entries, sizeof(HashStatsEntry) * hash_stats_size);
+        }
+        id = hash_stats_length++;
+    }
+    hash_stats_entries[id] = (HashStatsEntry) { table, name, stats, UINT32_MAX };
+    pthread_mutex_unlock(&hash_stats_lock);
+    return id;
+}
+
+void hash_stats_unregister(uint32_t id)
+{
+    if (id == UINT32_MAX)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&hash_stats_lock);
+    bool registered = id < hash_stats_length; // Tables deleted after the report was printed are ignored
+    HashStatsEntry entry = registered ? hash_stats_entries[id] : (HashStatsEntry) { 0 };
+    pthread_mutex_unlock(&hash_stats_lock);
+
+    if (registered)
+    {
+        // The stats visit every slot of the table, so they are taken without holding the lock
+        String name = entry.name(entry.table);
+        HashStats stats = entry.stats(entry.table);
+
+        pthread_mutex_lock(&hash_stats_lock);
+        if (id < hash_stats_length)
+        {
+            hash_stats_entries[id] = (HashStatsEntry) { NULL, NULL, NULL, hash_stats_free };
+            hash_stats_free = id;
+            hash_stats_fold(name, stats);
+        }
+        else
+        {
+            del(String, name);
+        }
+        pthread_mutex_unlock(&hash_stats_lock);
+    }
+}
+
+
+// Private Methods
+
+static void hash_stats_init()
+{
+    slice_t value = getenv("HASH_STATS");
+    hash_stats_enabled = value != NULL && value[0] != '\0' && strcmp(value, "0") != 0;
+    if (hash_stats_enabled)
+    {
+        atexit(&hash_stats_dump);
+    }
+}
+
+// Adds the stats of a deleted table to the total for it's name. Takes ownership of the name. The lock must be held
+static void hash_stats_fold(String name, HashStats stats)
+{
+    HashStatsDeleted* deleted = NULL;
+    for (uint32_t i = 0; i < hash_stats_deleted_length; i++)
+    {
+        if (equals(String, hash_stats_deleted[i].name, name))
+        {
+            deleted = &hash_stats_deleted[i];
+            del(String, name);
+            break;
+        }
+    }
+    if (deleted == NULL)
+    {
+        safe_realloc(hash_stats_deleted, sizeof(HashStatsDeleted) * (hash_stats_deleted_length + 1));
+        deleted = &hash_stats_deleted[hash_stats_deleted_length++];
+        *deleted = (HashStatsDeleted) { name, 0, { 0 } };
+    }
+
+    HashStats* total = &deleted->total;
+    deleted->tables++;
+    total->length += stats.length;
+    total->capacity += stats.capacity;
+    total->max_load_factor = max(total->max_load_factor, stats.max_load_factor);
+    total->tombstones += stats.tombstones;
+    total->mean_probe_length += stats.mean_probe_length * stats.length;
+    total->max_probe_length = max(total->max_probe_length, stats.max_probe_length);
+    for (uint32_t i = 0; i < HASH_STATS_BUCKETS; i++)
+    {
+        total->clusters[i] += stats.clusters[i];
+    }
+    total->rehashes += stats.rehashes;
+    total->bytes += stats.bytes;
+}
+
+// Reports every live table, and then the totals of the deleted tables of each name
+static void hash_stats_dump()
+{
+    pthread_mutex_lock(&hash_stats_lock);
+    uint32_t live = 0, deleted = 0;
+    for (uint32_t i = 0; i < hash_stats_length; i++)
+    {
+        live += hash_stats_entries[i].table != NULL;
+    }
+    for (uint32_t i = 0; i < hash_stats_deleted_length; i++)
+    {
+        deleted += hash_stats_deleted[i].tables;
+    }
+    fprintf(stderr, "Hash table stats: %u tables, %u deleted\n", live, deleted);
+
+    for (uint32_t i = 0; i < hash_stats_length; i++)
+    {
+        HashStatsEntry* entry = &hash_stats_entries[i];
+        if (entry->table != NULL)
+        {
+            String name = entry->name(entry->table), report = hash_stats_format(entry->stats(entry->table));
+            fprintf(stderr, "  %s: %s\n", name->slice, report->slice);
+            del(String, name);
+            del(String, report);
+        }
+    }
+    for (uint32_t i = 0; i < hash_stats_deleted_length; i++)
+    {
+        HashStatsDeleted* entry = &hash_stats_deleted[i];
+        HashStats total = entry->total;
+        total.load_factor = total.capacity == 0 ? 0 : (double) total.length / total.capacity;
+        total.mean_probe_length = total.length == 0 ? 0 : total.mean_probe_length / total.length;
+
+        String report = hash_stats_format(total);
+        fprintf(stderr, "  %s: %u deleted, total %s\n", entry->name->slice, entry->tables, report->slice);
+        del(String, report);
+        del(String, entry->name);
+    }
+
+    free(hash_stats_entries);
+    free(hash_stats_deleted);
+    hash_stats_entries = NULL;
+    hash_stats_deleted = NULL;
+    hash_stats_length = 0;
+    hash_stats_size = 0;
+    hash_stats_free = UINT32_MAX;
+    hash_stats_deleted_length = 0;
+    pthread_mutex_unlock(&hash_stats_lock);
+}
@@ -0,0 +1,258 @@
+// Common definitions for the open addressing hash tables (Map and Set)
+// The probing engines are implemented once in hashtable.template.c, and instantiated for each table type
+
+#include "../lib.h"
+
+#ifndef COLLECTIONS_HASH_TABLE_H
+#define COLLECTIONS_HASH_TABLE_H
+
+#include <pthread.h> // Used for parallel rehashing and bulk insertion
+
+#ifdef __SSE2__
+#include <emmintrin.h> // SSE2 intrinsics, used to match a group of control bytes at once
+#endif
+
+// Hash Table Options
+// These can be passed as an optional last argument to the constructor of a table, e.g.
+// new(Map, 16, class(String), class(Int32), HASH_ROBIN_HOOD)
+// The lowest bits select the probing engine.
+
+typedef uint32_t HashOptions;
+
+#define HASH_LINEAR      0x0 // Linear probing. A key is inserted into the first empty slot after it's home index
+#define HASH_ROBIN_HOOD  0x1 // Robin Hood linear probing. Keys are kept ordered by probe distance, so lookups of missing keys exit early
+#define HASH_SWISS       0x2 // Group probing (as in a Swiss table). A control byte per slot holds 7 bits of the hash, and a group of slots is matched at once
+#define HASH_ENGINE_MASK 0x3
+
+#define HASH_INCREMENTAL 0x4 // Resize incrementally. The previous backing arrays are kept while keys are migrated a few slots at a time, by each put(). Lookups search both arrays, and never move keys
+#define HASH_REUSABLE    0x8 // Log the slots filled since the table was last cleared, so clear() only visits those, rather than every slot. For scratch tables which are cleared and refilled many times
+#define HASH_BLOOM       0x10 // Keep a blocked Bloom filter of the keys in the table, which answers most lookups of missing keys without probing the table. For large tables where most lookups miss
+#define HASH_SEEDED      0x20 // Mix a random seed, different for each table, into the hash of each key. Keys are placed, and iterated, in a different order in each table, so copying keys from one table to another cannot build long clusters
+
+#define HASH_DEFAULT HASH_SWISS
+
+#define hash_engine(options) ((options) & HASH_ENGINE_MASK)
+
+// Maximum load factors
+// Robin Hood probing keeps probe lengths short at much higher loads than plain linear probing
+#define HASH_LINEAR_LOAD_FACTOR 0.75
+#define HASH_ROBIN_HOOD_LOAD_FACTOR 0.875
+#define HASH_SWISS_LOAD_FACTOR 0.875
+
+#define hash_load_factor(options) ( \
+    hash_engine(options) == HASH_SWISS ? HASH_SWISS_LOAD_FACTOR : \
+    hash_engine(options) == HASH_ROBIN_HOOD ? HASH_ROBIN_HOOD_LOAD_FACTOR : \
+    HASH_LINEAR_LOAD_FACTOR)
+
+// The number of slots of the previous table that are migrated by each operation, during an incremental resize
+// This must be at least 2, for the migration to complete before the next resize
+#define HASH_MIGRATE_SLOTS 16
+
+// With HASH_REUSABLE, the log of filled slots holds up to size / HASH_REUSABLE_LOG_RATIO indices. Once a table has filled more slots than that since it was last cleared, the next clear() visits every slot instead.
+#define HASH_REUSABLE_LOG_RATIO 4
+
+// With HASH_BLOOM, the filter has HASH_BLOOM_BITS_PER_SLOT bits for each slot of the table, split into blocks of one cache line.
+// Each key sets HASH_BLOOM_PROBES bits, all within one block, so a lookup reads a single cache line of the filter.
+#define HASH_BLOOM_BITS_PER_SLOT 8
+#define HASH_BLOOM_BLOCK_BITS 512
+#define HASH_BLOOM_PROBES 4
+
+// Rehashing or bulk inserting at least this many keys places them using multiple threads, see hashtable.template.c
+// This requires that the hash() and equals() of the key class are safe to call concurrently, which is true of any class that does not modify shared state.
+#define HASH_PARALLEL_THRESHOLD (1 << 16)
+#define HASH_PARALLEL_THREADS 8
+
+// Swiss Table Control Bytes
+// Each slot has a control byte, which is either EMPTY, DELETED, or for a full slot, the top 7 bits (h2) of the slot's hash.
+// Slots are probed in aligned groups of HASH_GROUP_WIDTH, and the control bytes for a group are compared against h2 all at once.
+// Only slots with a matching h2 then need to compare keys with equals().
+
+#define HASH_GROUP_WIDTH 16
+
+#define HASH_CONTROL_EMPTY   ((uint8_t) 0x80)
+#define HASH_CONTROL_DELETED ((uint8_t) 0xFE)
+
+#define hash_h2(h) ((uint8_t) ((h) >> 25))
+
+// Bloom Filter
+// The filter is an array of blocks, each of HASH_BLOOM_BLOCK_BITS bits. A key's (mixed) hash g selects it's block with it's low bits, and HASH_BLOOM_PROBES bits within the block from the high bits of a multiplicative hash of g.
+// Keys are never removed from the filter, as other keys may share their bits. Removed keys are cleared when the filter is rebuilt, on a resize or clear.
+
+typedef struct
+{
+    uint64_t lookups; // The number of lookups which checked the filter
+    uint64_t rejected; // The number of lookups of missing keys, which the filter answered without probing the table
+    uint64_t false_positives; // The number of lookups of missing keys, which passed the filter, and so probed the table
+    double false_positive_rate; // The fraction of lookups of missing keys which passed the filter
+    uint64_t bytes; // The size of the filter
+} HashBloomStats;
+
+static inline uint64_t* hash_bloom_block(uint64_t* bloom, uint32_t blocks, uint32_t g)
+{
+    return bloom + (g & (blocks - 1)) * (HASH_BLOOM_BLOCK_BITS / 64);
+}
+
+static inline void hash_bloom_add(uint64_t* bloom, uint32_t blocks, uint32_t g)
+{
+    uint64_t* block = hash_bloom_block(bloom, blocks, g);
+    uint64_t bits = g * 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < HASH_BLOOM_PROBES; i++)
+    {
+        uint32_t bit = (bits >> (28 + 9 * i)) & (HASH_BLOOM_BLOCK_BITS - 1);
+        block[bit / 64] |= (uint64_t) 1 << (bit % 64);
+    }
+}
+
+static inline bool hash_bloom_test(const uint64_t* bloom, uint32_t blocks, uint32_t g)
+{
+    const uint64_t* block = hash_bloom_block((uint64_t*) bloom, blocks, g);
+    uint64_t bits = g * 0x9E3779B97F4A7C15ul;
+    for (uint32_t i = 0; i < HASH_BLOOM_PROBES; i++)
+    {
+        uint32_t bit = (bits >> (28 + 9 * i)) & (HASH_BLOOM_BLOCK_BITS - 1);
+        if ((block[bit / 64] & ((uint64_t) 1 << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Diagnostics
+// Stats describe how the keys of a table are laid out, in order to find key classes with a poor hash(), see map_stats() and set_stats().
+// If the environment variable HASH_STATS is set (and not "0"), every Map and Set is registered when it is created. Each live table reports it's stats to stderr when the process exits. Tables deleted before then are not kept, but their stats when they were deleted are added up, and reported as one total for each name.
+
+#define HASH_STATS_BUCKETS 12 // The number of buckets of the cluster histogram
+
+typedef struct
+{
+    uint32_t length; // The number of keys
+    uint32_t capacity; // The number of slots
+    double load_factor; // The ratio of keys to slots
+    double max_load_factor; // The load factor at which the table is resized
+    uint32_t tombstones; // The number of DELETED slots. Only used by the Swiss engine
+    double mean_probe_length; // The mean, over all keys, of the number of slots a lookup of the key visits. For the Swiss engine, this counts groups rather than slots
+    uint32_t max_probe_length; // The maximum number of slots (or groups) a lookup of any key visits
+    uint32_t clusters[HASH_STATS_BUCKETS]; // A histogram of the lengths of clusters, runs of consecutive slots with keys. Bucket i counts clusters of length 2^i to 2^(i + 1) - 1, and the last bucket also counts any longer
+    uint32_t rehashes; // The number of times the table was resized, or rehashed at the same size
+    uint64_t bytes; // The memory used by the table and it's backing arrays, not including the keys and values
+} HashStats;
+
+// Formats stats on a single line
+String hash_stats_format(HashStats stats);
+
+// Produces the name a table is reported with, e.g. the table's type. Deleted tables with equal names are reported together
+typedef String (*FnHashStatsName) (pointer_t);
+
+// Produces the stats of a table
+typedef HashStats (*FnHashStats) (pointer_t);
+
+// Registers a table to report it's stats at exit, if HASH_STATS is set. Returns the table's id in the registry, or UINT32_MAX if not registered
+uint32_t hash_stats_register(pointer_t table, FnHashStatsName name, FnHashStats stats);
+
+// Takes the final stats of a table which is about to be deleted, and adds them to the total for it's name. It's id may then be reused
+void hash_stats_unregister(uint32_t id);
+
+// Group matching
+// Each returns a bitmask with bit i set if the control byte i of the group matches
+
+#ifdef __SSE2__
+
+static inline uint32_t hash_group_match(const uint8_t* group, uint8_t h2)
+{
+    __m128i control = _mm_loadu_si128((const __m128i*) group);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char) h2)));
+}
+
+static inline uint32_t hash_group_match_empty(const uint8_t* group)
+{
+    return hash_group_match(group, HASH_CONTROL_EMPTY);
+}
+
+// Matches slots which are either EMPTY or DELETED, which are exactly those with the high bit set
+static inline uint32_t hash_group_match_free(const uint8_t* group)
+{
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) group));
+}
+
+#else
+
+static inline uint32_t hash_group_match(const uint8_t* group, uint8_t h2)
+{
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        mask |= ((uint32_t) (group[i] == h2)) << i;
+    }
+    return mask;
+}
+
+static inline uint32_t hash_group_match_empty(const uint8_t* group)
+{
+    return hash_group_match(group, HASH_CONTROL_EMPTY);
+}
+
+static inline uint32_t hash_group_match_free(const uint8_t* group)
+{
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        mask |= ((uint32_t) (group[i] >> 7)) << i;
+    }
+    return mask;
+}
+
+#endif
+
+// Group probing
+// Shared by every group probed table: the Swiss engine of Map and Set (see hashtable.template.c), and PrimitiveMap.
+// The probe sequence of a (mixed) hash h starts at it's home group, selected by the low bits of h, and then moves 1, 2, 3, ... groups at a time. As the number of groups is a power of 2, this triangular sequence visits every group.
+
+typedef struct
+{
+    uint32_t index; // The first index of the current group
+    uint32_t mask; // The size of the table, minus one
+    uint32_t step; // The number of groups visited before the current one
+} HashGroupProbe;
+
+static inline HashGroupProbe hash_group_probe(uint32_t size, uint32_t h)
+{
+    return (HashGroupProbe) { h & (size - 1) & ~(HASH_GROUP_WIDTH - 1), size - 1, 0 };
+}
+
+static inline void hash_group_probe_next(HashGroupProbe* probe)
+{
+    probe->step++;
+    probe->index = (probe->index + probe->step * HASH_GROUP_WIDTH) & probe->mask;
+}
+
+// The first free (EMPTY or DELETED) slot of the probe sequence of h, which is where a key with hash h that is not in the table is placed
+static inline uint32_t hash_group_find_free(const uint8_t* control, uint32_t size, uint32_t h)
+{
+    HashGroupProbe probe = hash_group_probe(size, h);
+    uint32_t free_slots = hash_group_match_free(control + probe.index);
+    while (free_slots == 0)
+    {
+        hash_group_probe_next(&probe);
+        free_slots = hash_group_match_free(control + probe.index);
+    }
+    return probe.index + __builtin_ctz(free_slots);
+}
+
+// Marks the full slot at an index as free. Keys cannot be shifted between groups, so the slot is only marked EMPTY if it's group has another empty slot (as then no probe sequence passes through the group).
+// Otherwise, it is left as a DELETED tombstone, and this returns true. Tombstones count towards the load factor, until the table is rehashed
+static inline bool hash_group_erase(uint8_t* control, uint32_t index)
+{
+    bool tombstone = hash_group_match_empty(control + (index & ~(HASH_GROUP_WIDTH - 1))) == 0;
+    control[index] = tombstone ? HASH_CONTROL_DELETED : HASH_CONTROL_EMPTY;
+    return tombstone;
+}
+
+// The size to rehash a table to, once inserting one more key would reach threshold slots in use by keys or tombstones.
+// If tombstones make up a large part of the load, the table is rehashed at the same size, which clears them, rather than growing
+static inline uint32_t hash_rehash_size(uint32_t size, uint32_t length, uint32_t threshold)
+{
+    return 2 * (length + 1) < threshold ? size : size << 1;
+}
+
+#endif
@@ -0,0 +1,1208 @@
+// Template
+// Implementation of the open addressing probing engines shared by Map and Set
+// @param HashTable : The arguments to the template, as 'Class, prefix, keys, key_class, has_values, interleaved'
+//   Class : The table type, e.g. Map
+//   prefix : The prefix for the generated methods, e.g. map
+//   keys : The name of the key array member (for parallel arrays), or the slot array member (if interleaved)
+//   key_class : The name of the key class member
+//   has_values : 1 if the table has values (and a value_class member) stored with the keys. 0 otherwise
+//   interleaved : 1 if the keys, values and hashes are stored together in an array of slots, with 'key', 'value' and 'hash' fields. 0 if they are stored in parallel arrays, 'keys', 'values' and 'hashes'
+//
+// Usage:
+// #define HashTable Map, map, slots, key_class, 1, 1
+// #include "hashtable.template.c"
+//
+// All engines work over the same backing arrays (or array of slots), of a length that is a power of two. An empty slot is identified by a NULL key.
+// The hash of each key is cached in a parallel array. Resizing never calls hash(), and probes compare hashes before calling equals() on a key.
+// Linear probing inserts a key into the first empty slot after it's home index (the hash of the key, masked to the table size).
+// Robin Hood probing uses the distance of each key from it's home index (computed from it's cached hash). When inserting, a key will take the slot of any key closer to it's own home, which then continues probing in it's place.
+// The result is that keys in a cluster are ordered by their home index, and a lookup can stop as soon as it reaches a key which is closer to home than the key being searched for.
+// Group (Swiss) probing keeps an additional control byte per slot, see hashtable.h. The table is split into aligned groups of slots, which are probed in a triangular sequence, one group at a time.
+// A group is matched against the queried hash with a single SIMD comparison, and a lookup stops at the first group which contains an empty slot.
+
+// Local definitions
+// Undef'd at the end of this template
+#define HASH_TABLE_CLASS     REFLECT(ARG_1, HashTable)
+#define HASH_TABLE_PREFIX    REFLECT(ARG_2, HashTable)
+#define HASH_TABLE_KEYS      REFLECT(ARG_3, HashTable)
+#define HASH_TABLE_KEY_CLASS REFLECT(ARG_4, HashTable)
+#define HASH_TABLE_VALUES    REFLECT(ARG_5, HashTable)
+#define HASH_TABLE_INTERLEAVED REFLECT(ARG_6, HashTable)
+
+#define HASH_TABLE_METHOD(name) CONCAT3(HASH_TABLE_PREFIX, _, name)
+
+// Accessors for the key, value and hash of a slot, which hide the layout of the table
+#if HASH_TABLE_INTERLEAVED
+#define HASH_TABLE_KEY(table, index) ((table)->HASH_TABLE_KEYS[index].key)
+#define HASH_TABLE_VALUE(table, index) ((table)->HASH_TABLE_KEYS[index].value)
+#define HASH_TABLE_HASH(table, index) ((table)->HASH_TABLE_KEYS[index].hash)
+#else
+#define HASH_TABLE_KEY(table, index) ((table)->HASH_TABLE_KEYS[index])
+#define HASH_TABLE_VALUE(table, index) ((table)->values[index])
+#define HASH_TABLE_HASH(table, index) ((table)->hashes[index])
+#endif
+
+// The probe distance of the key at an index from it's home index
+#define HASH_TABLE_DISTANCE(table, index) (((index) - HASH_TABLE_HASH(table, index)) & ((table)->size - 1))
+
+// If the table stores mixed hashes. The group engine mixes the class hash, see hash_mix(), as does a table with a seed, so the seed changes every bit
+static inline bool HASH_TABLE_METHOD(mixed)(HASH_TABLE_CLASS table)
+{
+    return hash_engine(table->options) == HASH_SWISS || table->seed != 0;
+}
+
+// Converts the class hash of a key to the hash stored in the table
+static inline uint32_t HASH_TABLE_METHOD(stored_hash)(HASH_TABLE_CLASS table, uint32_t h)
+{
+    return HASH_TABLE_METHOD(mixed)(table) ? hash_mix(h ^ table->seed) : h;
+}
+
+// Computes the hash of a key, as stored in the table
+static uint32_t HASH_TABLE_METHOD(hash)(HASH_TABLE_CLASS table, pointer_t key)
+{
+    return HASH_TABLE_METHOD(stored_hash)(table, hash_c(table->HASH_TABLE_KEY_CLASS, key));
+}
+
+// Bloom Filter
+// With HASH_BLOOM, see hashtable.h. The filter belongs to the table, and is not freed with it's backing arrays.
+
+// The hash used by the filter. Plain hashes are mixed, as the filter uses both their low and high bits
+static inline uint32_t HASH_TABLE_METHOD(bloom_hash)(HASH_TABLE_CLASS table, uint32_t h)
+{
+    return HASH_TABLE_METHOD(mixed)(table) ? h : hash_mix(h);
+}
+
+// Sizes the filter to match the current size of the table, and empties it
+static void HASH_TABLE_METHOD(bloom_alloc)(HASH_TABLE_CLASS table)
+{
+    if (!(table->options & HASH_BLOOM))
+    {
+        return;
+    }
+
+    uint32_t blocks = max(table->size / (HASH_BLOOM_BLOCK_BITS / HASH_BLOOM_BITS_PER_SLOT), 1u);
+    if (table->bloom == NULL || table->bloom_blocks != blocks)
+    {
+        free(table->bloom);
+        table->bloom = aligned_alloc(HASH_BLOOM_BLOCK_BITS / 8, blocks * (HASH_BLOOM_BLOCK_BITS / 8));
+        panic_if_null(table->bloom, "Out of Memory: Cannot allocate a Bloom filter of %d blocks", blocks);
+        table->bloom_blocks = blocks;
+    }
+    memset(table->bloom, 0, blocks * (HASH_BLOOM_BLOCK_BITS / 8));
+}
+
+static inline void HASH_TABLE_METHOD(bloom_add)(HASH_TABLE_CLASS table, uint32_t h)
+{
+    if (table->bloom != NULL)
+    {
+        hash_bloom_add(table->bloom, table->bloom_blocks, HASH_TABLE_METHOD(bloom_hash)(table, h));
+    }
+}
+
+// Sizes and rebuilds the filter from every key in the table, including any in a previous table, using their cached hashes
+static void HASH_TABLE_METHOD(bloom_build)(HASH_TABLE_CLASS table)
+{
+    if (table->bloom == NULL)
+    {
+        return;
+    }
+
+    HASH_TABLE_METHOD(bloom_alloc)(table);
+    for (HASH_TABLE_CLASS source = table; source != NULL; source = source->previous)
+    {
+        for (uint32_t index = 0; index < source->size; index++)
+        {
+            if (HASH_TABLE_KEY(source, index) != NULL)
+            {
+                HASH_TABLE_METHOD(bloom_add)(table, HASH_TABLE_HASH(source, index));
+            }
+        }
+    }
+}
+
+static HashBloomStats HASH_TABLE_METHOD(bloom_report)(HASH_TABLE_CLASS table)
+{
+    HashBloomStats stats = { table->bloom_lookups, table->bloom_rejected, table->bloom_false_positives, 0, (uint64_t) table->bloom_blocks * (HASH_BLOOM_BLOCK_BITS / 8) };
+    uint64_t misses = stats.rejected + stats.false_positives;
+    stats.false_positive_rate = misses == 0 ? 0 : (double) stats.false_positives / misses;
+    return stats;
+}
+
+// Allocates empty backing arrays for the table, of a given size
+static void HASH_TABLE_METHOD(alloc)(HASH_TABLE_CLASS table, uint32_t size)
+{
+    bool group = hash_engine(table->options) == HASH_SWISS;
+    if (group)
+    {
+        size = max(size, HASH_GROUP_WIDTH); // Must hold at least one complete group
+    }
+
+    // Empty slots have NULL keys. Zeroed memory avoids touching every page of a large table up front
+#if HASH_TABLE_INTERLEAVED
+    table->HASH_TABLE_KEYS = safe_calloc(sizeof(*table->HASH_TABLE_KEYS) * size);
+#else
+    table->HASH_TABLE_KEYS = safe_calloc(sizeof(pointer_t) * size);
+#if HASH_TABLE_VALUES
+    table->values = safe_malloc(sizeof(pointer_t) * size);
+#endif
+    table->hashes = safe_malloc(sizeof(uint32_t) * size);
+#endif
+    table->control = group ? safe_malloc(sizeof(uint8_t) * size) : NULL;
+    table->filled = (table->options & HASH_REUSABLE) ? safe_malloc(sizeof(uint32_t) * max(size / HASH_REUSABLE_LOG_RATIO, 1u)) : NULL;
+    table->filled_length = 0;
+    table->size = size;
+    table->length = 0;
+    table->tombstones = 0;
+
+    if (group)
+    {
+        memset(table->control, HASH_CONTROL_EMPTY, size);
+    }
+}
+
+// Frees the backing arrays, including those of a previous table mid-migration. Does not delete any keys or values.
+static void HASH_TABLE_METHOD(free)(HASH_TABLE_CLASS table)
+{
+    free(table->HASH_TABLE_KEYS);
+#if !HASH_TABLE_INTERLEAVED
+#if HASH_TABLE_VALUES
+    free(table->values);
+#endif
+    free(table->hashes);
+#endif
+    free(table->control);
+    free(table->filled);
+    if (table->previous != NULL)
+    {
+        HASH_TABLE_METHOD(free)(table->previous);
+        free(table->previous);
+        table->previous = NULL;
+    }
+}
+
+// Records that an empty slot has been filled, with HASH_REUSABLE. Every slot which is not empty (including DELETED slots) was filled at some point since the last clear, so is in the log, unless it overflowed.
+static inline void HASH_TABLE_METHOD(mark)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    if (table->filled != NULL && table->filled_length != UINT32_MAX)
+    {
+        if (table->filled_length < table->size / HASH_REUSABLE_LOG_RATIO)
+        {
+            table->filled[table->filled_length++] = index;
+        }
+        else
+        {
+            table->filled_length = UINT32_MAX; // Overflowed, the next clear must visit every slot
+        }
+    }
+}
+
+// Places a key with hash h, known to be absent from the table, in the probe sequence starting at index, with the given probe distance.
+// Returns the index the key was placed at.
+static uint32_t HASH_TABLE_METHOD(place)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h, uint32_t index, uint32_t distance)
+{
+    uint32_t mask = (table->size - 1);
+    if (hash_engine(table->options) == HASH_ROBIN_HOOD)
+    {
+        uint32_t placed_index = UINT32_MAX;
+        while (HASH_TABLE_KEY(table, index) != NULL)
+        {
+            if (HASH_TABLE_DISTANCE(table, index) < distance)
+            {
+                if (placed_index == UINT32_MAX)
+                {
+                    placed_index = index;
+                }
+
+                // The current key is closer to it's home index, so swap it with the key being placed, and continue probing with the displaced key
+                pointer_t displaced_key = HASH_TABLE_KEY(table, index);
+                uint32_t displaced_hash = HASH_TABLE_HASH(table, index);
+                uint32_t displaced_distance = HASH_TABLE_DISTANCE(table, index);
+
+                HASH_TABLE_KEY(table, index) = key;
+                HASH_TABLE_HASH(table, index) = h;
+                key = displaced_key;
+                h = displaced_hash;
+                distance = displaced_distance;
+#if HASH_TABLE_VALUES
+                pointer_t displaced_value = HASH_TABLE_VALUE(table, index);
+                HASH_TABLE_VALUE(table, index) = value;
+                value = displaced_value;
+#endif
+            }
+            index = (index + 1) & mask;
+            distance++;
+        }
+        HASH_TABLE_METHOD(mark)(table, index);
+        HASH_TABLE_HASH(table, index) = h;
+        HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+        HASH_TABLE_VALUE(table, index) = value;
+#endif
+        return placed_index == UINT32_MAX ? index : placed_index;
+    }
+    else
+    {
+        while (HASH_TABLE_KEY(table, index) != NULL)
+        {
+            index = (index + 1) & mask;
+        }
+        HASH_TABLE_METHOD(mark)(table, index);
+        HASH_TABLE_HASH(table, index) = h;
+        HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+        HASH_TABLE_VALUE(table, index) = value;
+#endif
+        return index;
+    }
+}
+
+// Places a key with (mixed) hash h, known to be absent from the table, in the first free slot of it's group probe sequence.
+// Returns the index the key was placed at.
+static uint32_t HASH_TABLE_METHOD(place_group)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h)
+{
+    uint32_t index = hash_group_find_free(table->control, table->size, h);
+    if (table->control[index] == HASH_CONTROL_DELETED)
+    {
+        table->tombstones--;
+    }
+    HASH_TABLE_METHOD(mark)(table, index);
+    table->control[index] = hash_h2(h);
+    HASH_TABLE_HASH(table, index) = h;
+    HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+    HASH_TABLE_VALUE(table, index) = value;
+#endif
+    return index;
+}
+
+// Places a key with hash h, known to be absent from the table, using the table's engine. Returns the index the key was placed at.
+static uint32_t HASH_TABLE_METHOD(place_key)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h)
+{
+    HASH_TABLE_METHOD(bloom_add)(table, h);
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        return HASH_TABLE_METHOD(place_group)(table, key, value, h);
+    }
+    return HASH_TABLE_METHOD(place)(table, key, value, h, h & (table->size - 1), 0);
+}
+
+// Finds the index of a key with (mixed) hash h in a group probed table, or Err() if it is not present
+static Result(uint32_t) HASH_TABLE_METHOD(find_group)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h)
+{
+    uint8_t h2 = hash_h2(h);
+    for (HashGroupProbe probe = hash_group_probe(table->size, h);; hash_group_probe_next(&probe)) // The table must always have at least one empty slot, and the triangular sequence visits every group - so this is gaurenteed to terminate
+    {
+        const uint8_t* control = table->control + probe.index;
+        for (uint32_t match = hash_group_match(control, h2); match != 0; match &= match - 1)
+        {
+            uint32_t index = probe.index + __builtin_ctz(match);
+            if (HASH_TABLE_HASH(table, index) == h && equals_c(table->HASH_TABLE_KEY_CLASS, HASH_TABLE_KEY(table, index), key))
+            {
+                return Ok(uint32_t, index); // Key match
+            }
+        }
+        if (hash_group_match_empty(control) != 0)
+        {
+            return Err(uint32_t); // No match. Any key in a later group would have been placed in this one
+        }
+    }
+}
+
+// Probes a group probed table for a key with (mixed) hash h. Follows the semantics of probe_in()
+static bool HASH_TABLE_METHOD(probe_group)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h, uint32_t* index)
+{
+    uint8_t h2 = hash_h2(h);
+    uint32_t target = UINT32_MAX; // The first free slot seen, which is where the key will be inserted if it is not present
+
+    for (HashGroupProbe probe = hash_group_probe(table->size, h);; hash_group_probe_next(&probe))
+    {
+        const uint8_t* control = table->control + probe.index;
+        for (uint32_t match = hash_group_match(control, h2); match != 0; match &= match - 1)
+        {
+            uint32_t match_index = probe.index + __builtin_ctz(match);
+            if (HASH_TABLE_HASH(table, match_index) == h && equals_c(table->HASH_TABLE_KEY_CLASS, HASH_TABLE_KEY(table, match_index), key))
+            {
+                *index = match_index;
+                return true; // Key match
+            }
+        }
+        uint32_t free_slots = hash_group_match_free(control);
+        if (target == UINT32_MAX && free_slots != 0)
+        {
+            target = probe.index + __builtin_ctz(free_slots);
+        }
+        if (hash_group_match_empty(control) != 0)
+        {
+            *index = target;
+            return false; // The key is not present
+        }
+    }
+}
+
+// Finds the index of a key with hash h in the table (ignoring any previous table), or Err() if it is not present
+static Result(uint32_t) HASH_TABLE_METHOD(find_in)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h)
+{
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        return HASH_TABLE_METHOD(find_group)(table, key, h);
+    }
+
+    bool robin_hood = hash_engine(table->options) == HASH_ROBIN_HOOD;
+    uint32_t mask = (table->size - 1);
+    uint32_t index = h & mask;
+    uint32_t distance = 0;
+    pointer_t current_key = HASH_TABLE_KEY(table, index);
+
+    while (current_key != NULL) // The table must always have at least one empty spot - so this is gaurenteed to terminate
+    {
+        if (robin_hood && HASH_TABLE_DISTANCE(table, index) < distance)
+        {
+            break; // Any matching key would have displaced this one
+        }
+        if (HASH_TABLE_HASH(table, index) == h && equals_c(table->HASH_TABLE_KEY_CLASS, current_key, key))
+        {
+            return Ok(uint32_t, index); // Key match
+        }
+        index = (index + 1) & mask;
+        distance++;
+        current_key = HASH_TABLE_KEY(table, index);
+    }
+    return Err(uint32_t); // No match
+}
+
+// Probes the table (ignoring any previous table) for a key with hash h, with a single probe sequence. Returns true if the key is present, and sets index to it's index.
+// Otherwise, sets index and distance to where the key belongs, which can then be passed to fill().
+static bool HASH_TABLE_METHOD(probe_in)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h, uint32_t* index, uint32_t* distance)
+{
+    *distance = 0;
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        return HASH_TABLE_METHOD(probe_group)(table, key, h, index);
+    }
+
+    bool robin_hood = hash_engine(table->options) == HASH_ROBIN_HOOD;
+    uint32_t mask = (table->size - 1);
+    uint32_t current = h & mask;
+    pointer_t current_key = HASH_TABLE_KEY(table, current);
+
+    while (current_key != NULL)
+    {
+        if (robin_hood && HASH_TABLE_DISTANCE(table, current) < *distance)
+        {
+            break; // The key is not present, and belongs at this index
+        }
+        if (HASH_TABLE_HASH(table, current) == h && equals_c(table->HASH_TABLE_KEY_CLASS, current_key, key))
+        {
+            *index = current;
+            return true; // Key match
+        }
+        current = (current + 1) & mask;
+        (*distance)++;
+        current_key = HASH_TABLE_KEY(table, current);
+    }
+    *index = current;
+    return false; // No match
+}
+
+// Places a (key, value) pair, known to be absent from the table, at the index and distance returned by probe_in(). Returns the index the key was placed at.
+// The table must not have been modified since the probe.
+static uint32_t HASH_TABLE_METHOD(fill)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h, uint32_t index, uint32_t distance)
+{
+    table->length++;
+    HASH_TABLE_METHOD(bloom_add)(table, h);
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        if (table->control[index] == HASH_CONTROL_DELETED)
+        {
+            table->tombstones--;
+        }
+        HASH_TABLE_METHOD(mark)(table, index);
+        table->control[index] = hash_h2(h);
+        HASH_TABLE_HASH(table, index) = h;
+        HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+        HASH_TABLE_VALUE(table, index) = value;
+#endif
+        return index;
+    }
+    return HASH_TABLE_METHOD(place)(table, key, value, h, index, distance); // For Robin Hood probing, this displaces the rest of the cluster
+}
+
+// Removes the key (and value) at an index, without deleting them.
+// Linear and Robin Hood probing shift the following keys in the cluster back, so no tombstones are left behind.
+// Group probing cannot shift keys between groups, so may leave a DELETED tombstone, see hash_group_erase().
+// Tombstones count towards the load factor, and are cleared by the next rehash, see reserve_one()
+static void HASH_TABLE_METHOD(remove_at)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    uint32_t mask = (table->size - 1);
+    switch (hash_engine(table->options))
+    {
+        case HASH_SWISS:
+        {
+            table->tombstones += hash_group_erase(table->control, index);
+            break;
+        }
+        case HASH_ROBIN_HOOD:
+        {
+            // Shift back keys until reaching an empty slot, or a key which is already at it's home index
+            uint32_t next = (index + 1) & mask;
+            while (HASH_TABLE_KEY(table, next) != NULL && HASH_TABLE_DISTANCE(table, next) > 0)
+            {
+                HASH_TABLE_KEY(table, index) = HASH_TABLE_KEY(table, next);
+                HASH_TABLE_HASH(table, index) = HASH_TABLE_HASH(table, next);
+#if HASH_TABLE_VALUES
+                HASH_TABLE_VALUE(table, index) = HASH_TABLE_VALUE(table, next);
+#endif
+                index = next;
+                next = (next + 1) & mask;
+            }
+            break;
+        }
+        default:
+        {
+            // Shift back any key in the rest of the cluster whose home index does not lie (cyclically) between the hole and it's current index
+            for (uint32_t next = (index + 1) & mask; HASH_TABLE_KEY(table, next) != NULL; next = (next + 1) & mask)
+            {
+                if (HASH_TABLE_DISTANCE(table, next) >= ((next - index) & mask))
+                {
+                    HASH_TABLE_KEY(table, index) = HASH_TABLE_KEY(table, next);
+                    HASH_TABLE_HASH(table, index) = HASH_TABLE_HASH(table, next);
+#if HASH_TABLE_VALUES
+                    HASH_TABLE_VALUE(table, index) = HASH_TABLE_VALUE(table, next);
+#endif
+                    index = next;
+                }
+            }
+            break;
+        }
+    }
+    HASH_TABLE_KEY(table, index) = NULL;
+    table->length--;
+}
+
+// Incremental Resizing
+// With HASH_INCREMENTAL, growing the table moves the current backing arrays into a previous table, and allocates new, empty arrays.
+// Keys are then migrated from the previous table a few slots at a time, on each call to reserve_one(), i.e. before each insert(). Keys that are inserted or removed are migrated immediately.
+// Lookups (find()) search both tables, and never move keys, so it is safe to look up keys in a table while iterating it.
+// All slots in the previous table before the migration index are empty, and as removal only ever shifts keys backwards, no key is shifted behind it.
+
+// Migrates the key at an index in the previous table. Returns the index it was placed at in the table.
+static uint32_t HASH_TABLE_METHOD(migrate_one)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    HASH_TABLE_CLASS previous = table->previous;
+    pointer_t key = HASH_TABLE_KEY(previous, index);
+    uint32_t h = HASH_TABLE_HASH(previous, index);
+    pointer_t value = NULL;
+#if HASH_TABLE_VALUES
+    value = HASH_TABLE_VALUE(previous, index);
+#endif
+    HASH_TABLE_METHOD(remove_at)(previous, index);
+    return HASH_TABLE_METHOD(place_key)(table, key, value, h);
+}
+
+// Migrates up to a number of slots from the previous table, and releases the previous table once it is empty
+static void HASH_TABLE_METHOD(migrate)(HASH_TABLE_CLASS table, uint32_t slots)
+{
+    HASH_TABLE_CLASS previous = table->previous;
+    for (uint32_t work = 0; work < slots && table->migrated < previous->size; work++)
+    {
+        if (HASH_TABLE_KEY(previous, table->migrated) != NULL)
+        {
+            HASH_TABLE_METHOD(migrate_one)(table, table->migrated); // Removing may shift another key into this slot, so don't advance
+        }
+        else
+        {
+            table->migrated++;
+        }
+    }
+    if (table->migrated == previous->size || previous->length == 0)
+    {
+        HASH_TABLE_METHOD(free)(previous);
+        free(previous);
+        table->previous = NULL;
+    }
+}
+
+// Starts an incremental resize to a new size
+static void HASH_TABLE_METHOD(migrate_start)(HASH_TABLE_CLASS table, uint32_t new_size)
+{
+    HASH_TABLE_CLASS previous = class_malloc(HASH_TABLE_CLASS);
+    *previous = *table; // The previous table takes the current arrays, and all keys
+    previous->bloom = NULL; // But the filter stays with the table, and covers keys in both
+
+    HASH_TABLE_METHOD(alloc)(table, new_size);
+    table->length = previous->length; // The length of the table always counts keys in both tables
+    table->rehashes++;
+    table->previous = previous;
+    table->migrated = 0;
+    HASH_TABLE_METHOD(bloom_build)(table); // Reads only the cached hashes of the previous table
+}
+
+// Finds the index of a key with hash h in the table, or in a previous table, without migrating it
+// As with iterators, an index past the end of the table continues into the previous table, see slot_table() and slot_index()
+static Result(uint32_t) HASH_TABLE_METHOD(find_either)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h)
+{
+    Result(uint32_t) index = HASH_TABLE_METHOD(find_in)(table, key, h);
+    if (is_err(index) && table->previous != NULL)
+    {
+        Result(uint32_t) previous_index = HASH_TABLE_METHOD(find_in)(table->previous, key, h);
+        if (is_ok(previous_index))
+        {
+            return Ok(uint32_t, table->size + previous_index.value);
+        }
+    }
+    return index;
+}
+
+// The table, and the index within it, of an index returned by find(), which may refer to a slot in the previous table
+static inline HASH_TABLE_CLASS HASH_TABLE_METHOD(slot_table)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    return index < table->size ? table : table->previous;
+}
+
+static inline uint32_t HASH_TABLE_METHOD(slot_index)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    return index < table->size ? index : index - table->size;
+}
+
+// Finds the index of a key with hash h in the table, or Err() if it is not present. Does not modify the table, so it may be called while iterating it.
+// During an incremental resize, a key found in the previous table has an index past the end of the table, following the semantics of find_either().
+// With HASH_BLOOM, the filter is checked first, and a key which is not in the filter is not probed for.
+static Result(uint32_t) HASH_TABLE_METHOD(find_hashed)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h)
+{
+    if (table->bloom == NULL)
+    {
+        return HASH_TABLE_METHOD(find_either)(table, key, h);
+    }
+
+    table->bloom_lookups++;
+    if (!hash_bloom_test(table->bloom, table->bloom_blocks, HASH_TABLE_METHOD(bloom_hash)(table, h)))
+    {
+        table->bloom_rejected++;
+        return Err(uint32_t);
+    }
+    Result(uint32_t) index = HASH_TABLE_METHOD(find_either)(table, key, h);
+    if (is_err(index))
+    {
+        table->bloom_false_positives++;
+    }
+    return index;
+}
+
+// Finds the index of a key in the table, or Err() if it is not present, following the semantics of find_hashed()
+static inline Result(uint32_t) HASH_TABLE_METHOD(find)(HASH_TABLE_CLASS table, pointer_t key)
+{
+    return HASH_TABLE_METHOD(find_hashed)(table, key, HASH_TABLE_METHOD(hash)(table, key));
+}
+
+// Probes the table for a key with hash h, following the semantics of probe_in(). A key found in a previous table is migrated first.
+static bool HASH_TABLE_METHOD(probe)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h, uint32_t* index, uint32_t* distance)
+{
+    if (table->previous != NULL)
+    {
+        Result(uint32_t) previous_index = HASH_TABLE_METHOD(find_in)(table->previous, key, h);
+        if (is_ok(previous_index))
+        {
+            *index = HASH_TABLE_METHOD(migrate_one)(table, previous_index.value);
+            *distance = 0;
+            return true;
+        }
+    }
+    return HASH_TABLE_METHOD(probe_in)(table, key, h, index, distance);
+}
+
+// Inserts a (key, value) pair, where the key has hash h, following the semantics of insert(), below
+static bool HASH_TABLE_METHOD(insert_hashed)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h)
+{
+    uint32_t index, distance;
+    if (HASH_TABLE_METHOD(probe)(table, key, h, &index, &distance))
+    {
+        // Key match. Replace the key (and value) at this index.
+        // Delete the original key, keep the queried key intact. Ownership is given to the table (but borrowed in return)
+        del_c(table->HASH_TABLE_KEY_CLASS, HASH_TABLE_KEY(table, index));
+        HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+        del_c(table->value_class, HASH_TABLE_VALUE(table, index));
+        HASH_TABLE_VALUE(table, index) = value;
+#endif
+        return true; // Previous key found
+    }
+    // There was no matching key
+    HASH_TABLE_METHOD(fill)(table, key, value, h, index, distance);
+    return false;
+}
+
+// Inserts a (key, value) pair into the table. If an equal key is already present, both it and it's value are deleted and replaced.
+// Does not resize the table. Returns true if the key was already present.
+static bool HASH_TABLE_METHOD(insert)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value)
+{
+    return HASH_TABLE_METHOD(insert_hashed)(table, key, value, HASH_TABLE_METHOD(hash)(table, key));
+}
+
+// Removes a key (and value) with hash h from the table. Returns true if the key was present.
+// Ownership of the removed key and value are given to the caller, via removed_key and removed_value. If either is NULL, that part is deleted instead.
+static bool HASH_TABLE_METHOD(remove_key_hashed)(HASH_TABLE_CLASS table, pointer_t key, uint32_t h, pointer_t* removed_key, pointer_t* removed_value)
+{
+    Result(uint32_t) result = HASH_TABLE_METHOD(find_hashed)(table, key, h);
+    if (is_err(result))
+    {
+        return false;
+    }
+
+    uint32_t index = result.value;
+    if (index >= table->size)
+    {
+        index = HASH_TABLE_METHOD(migrate_one)(table, index - table->size); // A key in a previous table is migrated first
+    }
+    pointer_t current_key = HASH_TABLE_KEY(table, index);
+    pointer_t current_value = NULL;
+#if HASH_TABLE_VALUES
+    current_value = HASH_TABLE_VALUE(table, index);
+#endif
+    HASH_TABLE_METHOD(remove_at)(table, index);
+
+    if (removed_key != NULL)
+    {
+        *removed_key = current_key;
+    }
+    else
+    {
+        del_c(table->HASH_TABLE_KEY_CLASS, current_key);
+    }
+#if HASH_TABLE_VALUES
+    if (removed_value != NULL)
+    {
+        *removed_value = current_value;
+    }
+    else
+    {
+        del_c(table->value_class, current_value);
+    }
+#endif
+    return true;
+}
+
+// Removes a key (and value) from the table, following the semantics of remove_key_hashed()
+static inline bool HASH_TABLE_METHOD(remove_key)(HASH_TABLE_CLASS table, pointer_t key, pointer_t* removed_key, pointer_t* removed_value)
+{
+    return HASH_TABLE_METHOD(remove_key_hashed)(table, key, HASH_TABLE_METHOD(hash)(table, key), removed_key, removed_value);
+}
+
+// Parallel Placement
+// Rehashing or bulk inserting at least HASH_PARALLEL_THRESHOLD keys splits the table into HASH_PARALLEL_THREADS equal regions, and places keys with one thread per region.
+// Keys are first partitioned by the region of their home index (or home group). Each thread then places the keys whose home is in it's region, for as long as they stay within it.
+// With linear probing, a key whose probe sequence runs past the end of it's region is deferred, and with group probing, a key whose home group has no empty slot is deferred. Deferred keys are then placed by the calling thread.
+// Keys are partitioned and placed in their original order, so of any equal keys, the last is kept, as with insert().
+// Robin Hood probing places keys in order of their distance from home, which can move keys between regions, so it is never parallel.
+
+typedef struct
+{
+    HASH_TABLE_CLASS table; // The table being placed into
+    HASH_TABLE_CLASS source; // When rehashing, the table being placed from. Otherwise NULL
+    pointer_t* keys; // When inserting, the keys being inserted
+    pointer_t* values; // When inserting, the values being inserted, or NULL
+    uint32_t* hashes; // When inserting, the hashes of the keys, computed while partitioning
+    uint32_t length; // The number of slots in the source table, or the number of keys being inserted
+    uint32_t shift; // The shift from a home index to it's region
+    uint32_t phase; // The current phase, one of HASH_PARALLEL_COUNT, HASH_PARALLEL_PARTITION, or HASH_PARALLEL_PLACE
+    uint32_t* order; // Indices of the source slots or keys, partitioned by region
+    uint32_t counts[HASH_PARALLEL_THREADS][HASH_PARALLEL_THREADS]; // The number of keys in each [thread][region]. Replaced with the next index of order to write, while partitioning
+    uint32_t starts[HASH_PARALLEL_THREADS + 1]; // The start of each region in order
+    uint32_t deferred[HASH_PARALLEL_THREADS]; // The number of keys deferred by each region. Deferred keys are moved to the start of the region in order
+    uint32_t placed[HASH_PARALLEL_THREADS]; // The number of new keys placed by each region
+} CONCAT(HASH_TABLE_CLASS, __Parallel);
+
+typedef struct
+{
+    CONCAT(HASH_TABLE_CLASS, __Parallel)* parallel;
+    uint32_t id; // The index of the thread, which is also the index of it's region
+} CONCAT(HASH_TABLE_CLASS, __ParallelThread);
+
+#ifndef HASH_PARALLEL_PHASES
+#define HASH_PARALLEL_PHASES
+#define HASH_PARALLEL_COUNT 0
+#define HASH_PARALLEL_PARTITION 1
+#define HASH_PARALLEL_PLACE 2
+#endif
+
+// The home index of a hash, in the table. For the group engine, this is the first index of the home group
+static inline uint32_t HASH_TABLE_METHOD(home)(HASH_TABLE_CLASS table, uint32_t h)
+{
+    return hash_engine(table->options) == HASH_SWISS ? hash_group_probe(table->size, h).index : (h & (table->size - 1));
+}
+
+// Gets the key, value and hash at an index of the source. Returns false if it is an empty slot in the source table
+static inline bool HASH_TABLE_METHOD(parallel_source)(CONCAT(HASH_TABLE_CLASS, __Parallel)* parallel, uint32_t index, pointer_t* key, pointer_t* value, uint32_t* h)
+{
+    if (parallel->source != NULL)
+    {
+        *key = HASH_TABLE_KEY(parallel->source, index);
+        *h = HASH_TABLE_HASH(parallel->source, index);
+        *value = NULL;
+#if HASH_TABLE_VALUES
+        *value = HASH_TABLE_VALUE(parallel->source, index);
+#endif
+        return *key != NULL;
+    }
+    *key = parallel->keys[index];
+    *h = parallel->hashes[index];
+    *value = parallel->values != NULL ? parallel->values[index] : NULL;
+    return true;
+}
+
+// Places a key with hash h, whose home is in the region [start, end), without leaving the region. Returns false if the key must be deferred.
+// If the key is known to be distinct from all others in the table, equals() is not called. Otherwise, an equal key is replaced, as with insert(), and placed is not incremented.
+static bool HASH_TABLE_METHOD(place_region)(HASH_TABLE_CLASS table, pointer_t key, pointer_t value, uint32_t h, uint32_t end, bool distinct, uint32_t* placed)
+{
+    uint32_t index = HASH_TABLE_METHOD(home)(table, h);
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        const uint8_t* control = table->control + index;
+        if (!distinct)
+        {
+            for (uint32_t match = hash_group_match(control, hash_h2(h)); match != 0; match &= match - 1)
+            {
+                uint32_t match_index = index + __builtin_ctz(match);
+                if (HASH_TABLE_HASH(table, match_index) == h && equals_c(table->HASH_TABLE_KEY_CLASS, HASH_TABLE_KEY(table, match_index), key))
+                {
+                    index = match_index;
+                    goto replace;
+                }
+            }
+        }
+        uint32_t empty = hash_group_match_empty(control);
+        if (empty == 0)
+        {
+            return false; // The key may be in, or belong in, a later group
+        }
+        index += __builtin_ctz(empty); // Use an EMPTY slot, not a DELETED one, so the tombstone count is unchanged
+        table->control[index] = hash_h2(h);
+    }
+    else
+    {
+        for (;; index++)
+        {
+            if (index == end)
+            {
+                return false; // The probe sequence leaves the region
+            }
+            pointer_t current_key = HASH_TABLE_KEY(table, index);
+            if (current_key == NULL)
+            {
+                break;
+            }
+            if (!distinct && HASH_TABLE_HASH(table, index) == h && equals_c(table->HASH_TABLE_KEY_CLASS, current_key, key))
+            {
+                goto replace;
+            }
+        }
+    }
+    HASH_TABLE_HASH(table, index) = h;
+    HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+    HASH_TABLE_VALUE(table, index) = value;
+#endif
+    (*placed)++;
+    return true;
+
+replace:
+    del_c(table->HASH_TABLE_KEY_CLASS, HASH_TABLE_KEY(table, index));
+    HASH_TABLE_KEY(table, index) = key;
+#if HASH_TABLE_VALUES
+    del_c(table->value_class, HASH_TABLE_VALUE(table, index));
+    HASH_TABLE_VALUE(table, index) = value;
+#endif
+    return true;
+}
+
+// The body of each thread. Runs one phase, for the thread's chunk of the source (when counting and partitioning), or it's region (when placing)
+static void* HASH_TABLE_METHOD(parallel_thread)(void* arg)
+{
+    CONCAT(HASH_TABLE_CLASS, __ParallelThread)* thread = arg;
+    CONCAT(HASH_TABLE_CLASS, __Parallel)* parallel = thread->parallel;
+    HASH_TABLE_CLASS table = parallel->table;
+    uint32_t id = thread->id;
+
+    pointer_t key, value;
+    uint32_t h;
+    if (parallel->phase == HASH_PARALLEL_PLACE)
+    {
+        bool distinct = parallel->source != NULL;
+        uint32_t end = (id + 1) << parallel->shift;
+        uint32_t deferred = parallel->starts[id];
+        for (uint32_t i = parallel->starts[id]; i < parallel->starts[id + 1]; i++)
+        {
+            uint32_t index = parallel->order[i];
+            HASH_TABLE_METHOD(parallel_source)(parallel, index, &key, &value, &h);
+            if (!HASH_TABLE_METHOD(place_region)(table, key, value, h, end, distinct, &parallel->placed[id]))
+            {
+                parallel->order[deferred++] = index;
+            }
+        }
+        parallel->deferred[id] = deferred - parallel->starts[id];
+        return NULL;
+    }
+
+    uint32_t start = (uint32_t) (((uint64_t) parallel->length * id) / HASH_PARALLEL_THREADS);
+    uint32_t end = (uint32_t) (((uint64_t) parallel->length * (id + 1)) / HASH_PARALLEL_THREADS);
+    uint32_t* counts = parallel->counts[id];
+    for (uint32_t index = start; index < end; index++)
+    {
+        if (parallel->phase == HASH_PARALLEL_COUNT && parallel->source == NULL)
+        {
+            parallel->hashes[index] = HASH_TABLE_METHOD(hash)(table, parallel->keys[index]);
+        }
+        if (HASH_TABLE_METHOD(parallel_source)(parallel, index, &key, &value, &h))
+        {
+            uint32_t region = HASH_TABLE_METHOD(home)(table, h) >> parallel->shift;
+            if (parallel->phase == HASH_PARALLEL_COUNT)
+            {
+                counts[region]++;
+            }
+            else
+            {
+                parallel->order[counts[region]++] = index;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Runs a phase on all threads, and waits for them to complete
+static void HASH_TABLE_METHOD(parallel_run)(CONCAT(HASH_TABLE_CLASS, __Parallel)* parallel, uint32_t phase)
+{
+    pthread_t threads[HASH_PARALLEL_THREADS];
+    CONCAT(HASH_TABLE_CLASS, __ParallelThread) args[HASH_PARALLEL_THREADS];
+
+    parallel->phase = phase;
+    for (uint32_t id = 0; id < HASH_PARALLEL_THREADS; id++)
+    {
+        args[id] = (CONCAT(HASH_TABLE_CLASS, __ParallelThread)) { parallel, id };
+        panic_if(pthread_create(&threads[id], NULL, HASH_TABLE_METHOD(parallel_thread), &args[id]) != 0, "Unable to create thread %d", id);
+    }
+    for (uint32_t id = 0; id < HASH_PARALLEL_THREADS; id++)
+    {
+        pthread_join(threads[id], NULL);
+    }
+}
+
+// Places keys from a source table (when rehashing), or from arrays of keys and values (when inserting) using multiple threads, see above.
+// The table must be able to hold all keys without resizing, and must not have a previous table.
+static void HASH_TABLE_METHOD(place_parallel)(HASH_TABLE_CLASS table, HASH_TABLE_CLASS source, uint32_t length, pointer_t* keys, pointer_t* values)
+{
+    CONCAT(HASH_TABLE_CLASS, __Parallel) parallel = { 0 };
+    parallel.table = table;
+    parallel.source = source;
+    parallel.keys = keys;
+    parallel.values = values;
+    parallel.hashes = source == NULL ? safe_malloc(sizeof(uint32_t) * length) : NULL;
+    parallel.length = length;
+    parallel.shift = __builtin_ctz(table->size) - __builtin_ctz(HASH_PARALLEL_THREADS);
+
+    HASH_TABLE_METHOD(parallel_run)(&parallel, HASH_PARALLEL_COUNT);
+
+    // Lay out the regions in order, with the keys of each region ordered by thread, and replace counts with where each thread writes it's keys for each region
+    uint32_t total = 0;
+    for (uint32_t region = 0; region < HASH_PARALLEL_THREADS; region++)
+    {
+        parallel.starts[region] = total;
+        for (uint32_t id = 0; id < HASH_PARALLEL_THREADS; id++)
+        {
+            uint32_t count = parallel.counts[id][region];
+            parallel.counts[id][region] = total;
+            total += count;
+        }
+    }
+    parallel.starts[HASH_PARALLEL_THREADS] = total;
+    parallel.order = safe_malloc(sizeof(uint32_t) * max(total, 1u));
+
+    HASH_TABLE_METHOD(parallel_run)(&parallel, HASH_PARALLEL_PARTITION);
+    HASH_TABLE_METHOD(parallel_run)(&parallel, HASH_PARALLEL_PLACE);
+
+    // Place deferred keys, region by region, which keeps them in their original order
+    uint32_t placed = 0;
+    pointer_t key, value;
+    uint32_t h;
+    for (uint32_t region = 0; region < HASH_PARALLEL_THREADS; region++)
+    {
+        placed += parallel.placed[region];
+        for (uint32_t i = parallel.starts[region]; i < parallel.starts[region] + parallel.deferred[region]; i++)
+        {
+            HASH_TABLE_METHOD(parallel_source)(&parallel, parallel.order[i], &key, &value, &h);
+            if (source != NULL)
+            {
+                HASH_TABLE_METHOD(place_key)(table, key, value, h);
+                placed++;
+            }
+            else
+            {
+                HASH_TABLE_METHOD(insert_hashed)(table, key, value, h); // Counts the key in the length itself, if it is new
+            }
+        }
+    }
+    table->length += placed;
+    if (table->filled != NULL)
+    {
+        table->filled_length = UINT32_MAX; // Keys placed by other threads are not logged
+    }
+    HASH_TABLE_METHOD(bloom_build)(table); // Nor added to the filter
+
+    free(parallel.order);
+    free(parallel.hashes);
+}
+
+// Resizes the table to a new size, which must be a power of two able to hold all current keys
+static void HASH_TABLE_METHOD(rehash)(HASH_TABLE_CLASS table, uint32_t new_size)
+{
+    if (table->previous != NULL)
+    {
+        HASH_TABLE_METHOD(migrate)(table, UINT32_MAX); // Complete any incremental resize first
+    }
+
+    // Save a copy of the table, which keeps a reference to the existing arrays
+    struct CONCAT(HASH_TABLE_CLASS, __struct) old = *table;
+
+    HASH_TABLE_METHOD(alloc)(table, new_size);
+    HASH_TABLE_METHOD(bloom_alloc)(table); // Resized, and emptied of any removed keys. Keys are added again as they are placed
+    table->rehashes++;
+
+    if (old.length >= HASH_PARALLEL_THRESHOLD && hash_engine(table->options) != HASH_ROBIN_HOOD)
+    {
+        HASH_TABLE_METHOD(place_parallel)(table, &old, old.size, NULL, NULL);
+    }
+    else
+    {
+        // Insert all old keys. They are all known to be distinct, so they can be placed directly, with their cached hashes
+        for (uint32_t index = 0; index < old.size; index++)
+        {
+            pointer_t old_key = HASH_TABLE_KEY(&old, index);
+            if (old_key != NULL)
+            {
+                pointer_t old_value = NULL;
+#if HASH_TABLE_VALUES
+                old_value = HASH_TABLE_VALUE(&old, index);
+#endif
+                HASH_TABLE_METHOD(place_key)(table, old_key, old_value, HASH_TABLE_HASH(&old, index));
+            }
+        }
+    }
+    table->length = old.length;
+
+    // Free now-unused old arrays
+    HASH_TABLE_METHOD(free)(&old);
+}
+
+// Grows the table, if needed, so it can hold a total number of keys without resizing again.
+// This always resizes immediately, completing any incremental resize.
+static void HASH_TABLE_METHOD(reserve_all)(HASH_TABLE_CLASS table, uint32_t length)
+{
+    uint32_t new_size = table->size;
+    while (length + table->tombstones + 1 >= (uint32_t) (table->load_factor * new_size))
+    {
+        new_size <<= 1;
+    }
+    if (new_size != table->size)
+    {
+        HASH_TABLE_METHOD(rehash)(table, new_size);
+    }
+}
+
+// Inserts each (key, value) pair from parallel arrays, following the semantics of insert(). The table is resized at most once, before inserting any keys.
+// values may be NULL, in which case all values are NULL.
+static void HASH_TABLE_METHOD(insert_all)(HASH_TABLE_CLASS table, uint32_t length, pointer_t* keys, pointer_t* values)
+{
+    for (uint32_t i = 0; i < length; i++)
+    {
+        panic_if_null(keys[i], "Null Pointer: Key %d must not be null", i);
+    }
+
+    HASH_TABLE_METHOD(reserve_all)(table, table->length + length);
+    if (length >= HASH_PARALLEL_THRESHOLD && table->previous == NULL && hash_engine(table->options) != HASH_ROBIN_HOOD)
+    {
+        HASH_TABLE_METHOD(place_parallel)(table, NULL, length, keys, values);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < length; i++)
+        {
+            HASH_TABLE_METHOD(insert)(table, keys[i], values != NULL ? values[i] : NULL);
+        }
+    }
+}
+
+// Deletes all keys (and values) in the table, leaving it empty
+static void HASH_TABLE_METHOD(remove_all)(HASH_TABLE_CLASS table)
+{
+    if (table->previous != NULL)
+    {
+        HASH_TABLE_METHOD(remove_all)(table->previous);
+        HASH_TABLE_METHOD(free)(table->previous);
+        free(table->previous);
+        table->previous = NULL;
+    }
+
+    // With HASH_REUSABLE, only the slots filled since the last clear are visited, unless the log overflowed
+    bool logged = table->filled != NULL && table->filled_length != UINT32_MAX;
+    uint32_t end = logged ? table->filled_length : table->size;
+    for (uint32_t i = 0; i < end; i++)
+    {
+        uint32_t index = logged ? table->filled[i] : i;
+        pointer_t key = HASH_TABLE_KEY(table, index);
+        if (key != NULL)
+        {
+            del_c(table->HASH_TABLE_KEY_CLASS, key);
+#if HASH_TABLE_VALUES
+            del_c(table->value_class, HASH_TABLE_VALUE(table, index));
+#endif
+            // Keys need to be nulled as they are checked against null for existance (and a slot may be logged more than once)
+            // Values only exist with a non-null key, so they don't need to be nulled.
+            HASH_TABLE_KEY(table, index) = NULL;
+        }
+        if (logged && table->control != NULL)
+        {
+            table->control[index] = HASH_CONTROL_EMPTY;
+        }
+    }
+    if (!logged && table->control != NULL)
+    {
+        memset(table->control, HASH_CONTROL_EMPTY, table->size);
+    }
+    if (table->bloom != NULL)
+    {
+        memset(table->bloom, 0, table->bloom_blocks * (HASH_BLOOM_BLOCK_BITS / 8));
+    }
+    table->filled_length = 0;
+    table->length = 0;
+    table->tombstones = 0;
+}
+
+// Grows the table if inserting one more key would exceed the maximum load factor.
+// During an incremental resize, also migrates the next few slots of the previous table.
+static void HASH_TABLE_METHOD(reserve_one)(HASH_TABLE_CLASS table)
+{
+    if (table->previous != NULL)
+    {
+        HASH_TABLE_METHOD(migrate)(table, HASH_MIGRATE_SLOTS);
+    }
+
+    // In order to gaurentee proper function, the table must have always at least one empty entry
+    // Tombstones take up slots just as keys do, and are cleared by a rehash, see hash_rehash_size()
+    uint32_t threshold = (uint32_t) (table->load_factor * table->size);
+    if (table->length + table->tombstones + 1 >= threshold)
+    {
+        uint32_t new_size = hash_rehash_size(table->size, table->length, threshold);
+        if (table->options & HASH_INCREMENTAL)
+        {
+            if (table->previous != NULL)
+            {
+                HASH_TABLE_METHOD(migrate)(table, UINT32_MAX); // Only in the rare case the table has filled before the last resize completed
+            }
+            HASH_TABLE_METHOD(migrate_start)(table, new_size);
+        }
+        else
+        {
+            HASH_TABLE_METHOD(rehash)(table, new_size);
+        }
+    }
+}
+
+// Diagnostics
+// See HashStats in hashtable.h
+
+// The number of slots (or for the group engine, groups) a lookup of the key at an index visits, up to and including it's own
+static uint32_t HASH_TABLE_METHOD(probe_length)(HASH_TABLE_CLASS table, uint32_t index)
+{
+    if (hash_engine(table->options) == HASH_SWISS)
+    {
+        // Follow the triangular sequence from the home group, as in find_group()
+        HashGroupProbe probe = hash_group_probe(table->size, HASH_TABLE_HASH(table, index));
+        while (probe.index != (index & ~(HASH_GROUP_WIDTH - 1)))
+        {
+            hash_group_probe_next(&probe);
+        }
+        return probe.step + 1;
+    }
+    return HASH_TABLE_DISTANCE(table, index) + 1;
+}
+
+// The memory used by a table (ignoring any previous table), and it's backing arrays
+static uint64_t HASH_TABLE_METHOD(bytes)(HASH_TABLE_CLASS table)
+{
+#if HASH_TABLE_INTERLEAVED
+    uint64_t slot = sizeof(*table->HASH_TABLE_KEYS);
+#else
+    uint64_t slot = sizeof(pointer_t) * (1 + HASH_TABLE_VALUES) + sizeof(uint32_t);
+#endif
+    if (table->control != NULL)
+    {
+        slot += sizeof(uint8_t);
+    }
+    uint64_t bytes = sizeof(struct CONCAT(HASH_TABLE_CLASS, __struct)) + slot * table->size;
+    if (table->filled != NULL)
+    {
+        bytes += sizeof(uint32_t) * max(table->size / HASH_REUSABLE_LOG_RATIO, 1u);
+    }
+    if (table->bloom != NULL)
+    {
+        bytes += (uint64_t) table->bloom_blocks * (HASH_BLOOM_BLOCK_BITS / 8);
+    }
+    return bytes;
+}
+
+// Computes the stats of the table. During an incremental resize, keys in the previous table are included, with their probe lengths in the previous table
+static HashStats HASH_TABLE_METHOD(stats_report)(HASH_TABLE_CLASS table)
+{
+    HashStats stats = { 0 };
+    stats.length = table->length;
+    stats.capacity = table->size;
+    stats.load_factor = (double) table->length / table->size;
+    stats.max_load_factor = table->load_factor;
+    stats.tombstones = table->tombstones;
+    stats.rehashes = table->rehashes;
+
+    uint64_t total_probe_length = 0, keys = 0;
+    for (HASH_TABLE_CLASS source = table; source != NULL; source = source->previous)
+    {
+        stats.bytes += HASH_TABLE_METHOD(bytes)(source);
+
+        // Start after an empty slot (there is always at least one), so a cluster which wraps around the end of the table is counted once
+        uint32_t mask = source->size - 1, start = 0, cluster = 0;
+        while (HASH_TABLE_KEY(source, start) != NULL)
+        {
+            start++;
+        }
+        for (uint32_t i = 1; i <= source->size; i++)
+        {
+            uint32_t index = (start + i) & mask;
+            if (HASH_TABLE_KEY(source, index) != NULL)
+            {
+                uint32_t probe_length = HASH_TABLE_METHOD(probe_length)(source, index);
+                total_probe_length += probe_length;
+                stats.max_probe_length = max(stats.max_probe_length, probe_length);
+                keys++;
+                cluster++;
+            }
+            else if (cluster > 0)
+            {
+                stats.clusters[min(31 - __builtin_clz(cluster), HASH_STATS_BUCKETS - 1)]++;
+                cluster = 0;
+            }
+        }
+    }
+    stats.mean_probe_length = keys == 0 ? 0 : (double) total_probe_length / keys;
+    return stats;
+}
+
+// Clear local definitions
+#undef HASH_TABLE_CLASS
+#undef HASH_TABLE_PREFIX
+#undef HASH_TABLE_KEYS
+#undef HASH_TABLE_KEY_CLASS
+#undef HASH_TABLE_VALUES
+#undef HASH_TABLE_INTERLEAVED
+#undef HASH_TABLE_KEY
+#undef HASH_TABLE_VALUE
+#undef HASH_TABLE_HASH
+#undef HASH_TABLE_METHOD
+#undef HASH_TABLE_DISTANCE
+#undef HashTable
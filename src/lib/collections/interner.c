@@ -0,0 +1,141 @@
+#include "interner.h"
+
+// Private Methods
+
+static uint32_t intern_probe(Interner interner, pointer_t value, uint32_t hash);
+static void intern_resize(Interner interner);
+
+
+Interner Interner__new(uint32_t initial_size, Class value_class)
+{
+    Interner interner = class_malloc(Interner);
+
+    interner->value_class = value_class;
+    interner->size = max(initial_size, 1u);
+    interner->index_size = next_highest_power_of_two(max(interner->size * 2, 16u));
+    interner->length = 0;
+    interner->values = safe_malloc(sizeof(pointer_t) * interner->size);
+    interner->hashes = safe_malloc(sizeof(uint32_t) * interner->size);
+    interner->index = safe_calloc(sizeof(uint32_t) * interner->index_size); // Every slot empty
+
+    return interner;
+}
+
+void Interner__del(Interner interner)
+{
+    for iter(Interner, it, interner)
+    {
+        del_c(interner->value_class, it.value);
+    }
+    free(interner->values);
+    free(interner->hashes);
+    free(interner->index);
+    free(interner);
+}
+
+String Interner__format(Interner interner)
+{
+    String s = new(String, "Interner<");
+    str_append(s, interner->value_class->name);
+    str_append(s, ">{");
+    if (interner->length == 0)
+    {
+        str_append(s, "}");
+        return s;
+    }
+    else
+    {
+        for iter(Interner, it, interner)
+        {
+            str_append(s, str_format("%u: ", it.index));
+            str_append(s, format_c(interner->value_class, it.value));
+            str_append(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append(s, "}");
+    return s;
+}
+
+
+// Instance Methods
+
+uint32_t intern_put(Interner interner, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: Interner value must not be null");
+
+    uint32_t hash = hash_c(interner->value_class, value);
+    uint32_t slot = intern_probe(interner, value, hash);
+    if (interner->index[slot] != 0)
+    {
+        del_c(interner->value_class, value);
+        return interner->index[slot] - 1;
+    }
+
+    uint32_t id = interner->length++;
+    if (id == interner->size)
+    {
+        interner->size *= 2;
+        safe_realloc(interner->values, sizeof(pointer_t) * interner->size);
+        safe_realloc(interner->hashes, sizeof(uint32_t) * interner->size);
+    }
+    interner->values[id] = value;
+    interner->hashes[id] = hash;
+    interner->index[slot] = id + 1;
+
+    if (interner->length * 2 > interner->index_size)
+    {
+        intern_resize(interner);
+    }
+    return id;
+}
+
+Result(uint32_t) intern_find(Interner interner, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: Interner value must not be null");
+
+    uint32_t slot = intern_probe(interner, value, hash_c(interner->value_class, value));
+    return interner->index[slot] != 0 ? Ok(uint32_t, interner->index[slot] - 1) : Err(uint32_t);
+}
+
+pointer_t intern_get(Interner interner, uint32_t id)
+{
+    panic_if(id >= interner->length, "Interner id %u out of range for length %u", id, interner->length);
+    return interner->values[id];
+}
+
+
+// Private Methods
+
+// Finds the slot of the index which holds the id of a value, or the empty slot where it's id would be inserted
+static uint32_t intern_probe(Interner interner, pointer_t value, uint32_t hash)
+{
+    uint32_t mask = interner->index_size - 1;
+    for (uint32_t slot = hash_mix(hash) & mask;; slot = (slot + 1) & mask)
+    {
+        uint32_t entry = interner->index[slot];
+        if (entry == 0 || (interner->hashes[entry - 1] == hash && equals_c(interner->value_class, interner->values[entry - 1], value)))
+        {
+            return slot;
+        }
+    }
+}
+
+// Doubles the index, and re-inserts every id by it's cached hash
+static void intern_resize(Interner interner)
+{
+    free(interner->index);
+    interner->index_size *= 2;
+    interner->index = safe_calloc(sizeof(uint32_t) * interner->index_size);
+
+    uint32_t mask = interner->index_size - 1;
+    for (uint32_t id = 0; id < interner->length; id++)
+    {
+        uint32_t slot = hash_mix(interner->hashes[id]) & mask;
+        while (interner->index[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        interner->index[slot] = id + 1;
+    }
+}
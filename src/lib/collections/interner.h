@@ -0,0 +1,61 @@
+// An interning (hash-consing) store for generic value types
+// Each distinct value is stored once, and given a dense id: the first value interned is 0, the next distinct value 1, and so on.
+// A value is found from it's id in O(1), so code can work with ids in place of values, where equality is an integer compare, and memory is used only once per distinct value.
+// Values are never removed, so ids are stable for the life of the interner.
+// Cannot contain NULL values
+
+#include "../lib.h"
+
+#ifndef COLLECTIONS_INTERNER_H
+#define COLLECTIONS_INTERNER_H
+
+struct Interner__struct
+{
+    pointer_t* values; // The value of each id
+    uint32_t* hashes; // The hash of each id's value, so the index can be resized without hashing any values again
+    uint32_t* index; // Open addressed, linear probing index of ids by hash. Each slot holds an id + 1, or 0 if empty
+    Class value_class; // The value class
+    uint32_t size; // The length of the values and hashes arrays
+    uint32_t index_size; // The length of the index. Must be a power of 2, and at least twice the length
+    uint32_t length; // The number of values, which is also the next id
+};
+
+typedef struct Interner__struct * Interner;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+
+// The interner can hold initial_size values before resizing
+declare_constructor(Interner, uint32_t initial_size, Class value_class);
+
+void Interner__del(Interner interner);
+String Interner__format(Interner interner);
+
+// Iterator
+// Iterates the values in order of their ids. The id of each value is it's index
+
+typedef struct
+{
+    uint32_t index;
+    pointer_t value;
+} Iterator(Interner);
+
+#define Interner__iterator__start(interner) { 0, NULL }
+#define Interner__iterator__test(it, interner) ((it)->index < (interner)->length ? ((it)->value = (interner)->values[(it)->index], true) : false)
+#define Interner__iterator__next(it, interner) (it)->index++
+
+
+// Public Instance Methods - these all borrow the interner
+
+// Interns a value, and returns it's id. If the value is new, it's id is the previous length of the interner.
+// Ownership of the value is given to the interner. If an equal value was already present, the value is deleted, and the id of the present value is returned.
+uint32_t intern_put(Interner interner, pointer_t value);
+
+// Returns the id of a value, or Err if it has not been interned. This borrows the value
+Result(uint32_t) intern_find(Interner interner, pointer_t value);
+
+// Returns the value with a given id. This is borrowed from the interner. Panics if the id is out of range
+pointer_t intern_get(Interner interner, uint32_t id);
+
+#endif
@@ -1,43 +1,59 @@
 #include "map.h"
 
-#define LOAD_FACTOR 0.75
+// Probing engines
+#define HashTable Map, map, slots, key_class, 1, 1
+#include "hashtable.template.c"
 
 // Private Methods
 
-static Result(pointer_t) map_get_internal(Map map, pointer_t key);
-static void map_rehash(Map map);
+static Result(pointer_t) map_get_internal(Map map, pointer_t key, uint32_t h);
+static String map_stats_name(Map map);
 
 
-Map Map__new(uint32_t initial_size, Class key_class, Class value_class)
+// The name is parenthesized, as Map__new() is also a macro supplying the default options
+Map (Map__new)(uint32_t initial_size, Class key_class, Class value_class, HashOptions options)
 {
     initial_size = next_highest_power_of_two(initial_size);
     Map map = class_malloc(Map);
 
-    map->keys = safe_malloc(sizeof(pointer_t) * initial_size);
-    map->values = safe_malloc(sizeof(pointer_t) * initial_size);
     map->key_class = key_class;
     map->value_class = value_class;
-    map->size = initial_size;
-    map->length = 0;
+    map->options = options;
+    map->seed = options & HASH_SEEDED ? hash_random_seed() : 0;
+    map->load_factor = hash_load_factor(options);
+    map->previous = NULL;
+    map->migrated = 0;
+    map->bloom = NULL;
+    map->bloom_blocks = 0;
+    map->bloom_lookups = 0;
+    map->bloom_rejected = 0;
+    map->bloom_false_positives = 0;
+    map->rehashes = 0;
+    map_alloc(map, initial_size);
+    map_bloom_alloc(map);
+    map->stats_id = hash_stats_register(map, (FnHashStatsName) &map_stats_name, (FnHashStats) &map_stats);
 
-    for (uint32_t i = 0; i < initial_size; i++)
-    {
-        map->keys[i] = NULL;
-        map->values[i] = NULL;
-    }
+    return map;
+}
 
+// The name is parenthesized, as map_from_arrays() is also a macro supplying the default options
+Map (map_from_arrays)(uint32_t length, pointer_t* keys, pointer_t* values, Class key_class, Class value_class, HashOptions options)
+{
+    Map map = new(Map, 16, key_class, value_class, options);
+    map_put_all(map, length, keys, values);
     return map;
 }
 
 void Map__del(Map map)
 {
+    hash_stats_unregister(map->stats_id);
     for iter(Map, it, map)
     {
         del_c(map->key_class, it.key);
         del_c(map->value_class, it.value);
     }
-    free(map->keys);
-    free(map->values);
+    map_free(map);
+    free(map->bloom);
     free(map);
 }
 
@@ -71,15 +87,19 @@ String Map__format(Map map)
 
 // Iterator
 
+// During an incremental resize, indices past the end of the map continue into the previous map
 bool Map__iterator__test(Iterator(Map)* it, Map map)
 {
-    for (;it->index < map->size; it->index++) // Don't iterate off the end of the map
+    uint32_t end = map->size + (map->previous != NULL ? map->previous->size : 0);
+    for (;it->index < end; it->index++) // Don't iterate off the end of the map
     {
-        pointer_t key = map->keys[it->index]; // Stop at valid key locations
-        if (key != NULL)
+        Map table = it->index < map->size ? map : map->previous;
+        uint32_t index = it->index < map->size ? it->index : it->index - map->size;
+        MapSlot* slot = &table->slots[index];
+        if (slot->key != NULL) // Stop at valid key locations
         {
-            it->key = key;
-            it->value = map->values[it->index];
+            it->key = slot->key;
+            it->value = slot->value;
             return true;
         }
     }
@@ -88,128 +108,156 @@ bool Map__iterator__test(Iterator(Map)* it, Map map)
 
 
 // Instance Methods
+// The names of methods which also accept a SmallMap are parenthesized, as they are also macros, see smallmap.h
 
-bool map_put(Map map, pointer_t key, pointer_t value)
+bool (map_put)(Map map, pointer_t key, pointer_t value)
 {
     panic_if_null(key, "Null Pointer: Map key must not be null");
 
-    // In order to gaurentee proper map function, the map must have always at least one empty entry
-    // This means we need to re-hash the map when inserting at specific sizes
-    if (map->length + 1 >= (uint32_t) (LOAD_FACTOR * map->size))
-    {
-        map_rehash(map);
-    }
+    return map_put_hashed(map, key, value, hash_c(map->key_class, key));
+}
 
-    uint32_t mask = (map->size - 1);
-    uint32_t index = hash_c(map->key_class, key) & mask;
-    pointer_t current_key = map->keys[index];
+bool (map_contains_key)(Map map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: Map key must not be null.");
 
-    while (current_key != NULL)
-    {
-        // Test current key
-        if (equals_c(map->key_class, current_key, key))
-        {
-            // Key match. Replace the value at this index.
-            // Delete the original key, keep the queried key intact. Ownership is given to the map (but borrowed in return)
-            del_c(map->key_class, current_key);
-            del_c(map->value_class, map->values[index]);
-            map->keys[index] = key;
-            map->values[index] = value;
-            return true; // Previous value found
-        }
-        index = (index + 1) & mask;
-        current_key = map->keys[index];
-    }
-    // Found a null key position before a match, there was no matching element
-    map->keys[index] = key;
-    map->values[index] = value;
-    map->length++;
-    return false;
+    return map_contains_key_hashed(map, key, hash_c(map->key_class, key));
 }
 
-bool map_contains_key(Map map, pointer_t key)
+pointer_t (map_get)(Map map, pointer_t key)
 {
-    return is_ok(map_get_internal(map, key));
+    panic_if_null(key, "Null Pointer: Map key must not be null.");
+
+    return map_get_hashed(map, key, hash_c(map->key_class, key));
 }
 
-pointer_t map_get(Map map, pointer_t key)
+bool (map_remove)(Map map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value)
 {
-    return unwrap_default(map_get_internal(map, key));
+    panic_if_null(key, "Null Pointer: Map key must not be null.");
+
+    return map_remove_hashed(map, key, hash_c(map->key_class, key), removed_key, removed_value);
 }
 
-void map_clear(Map map)
+void (map_clear)(Map map)
 {
-    for iter(Map, it, map)
-    {
-        del_c(map->key_class, it.key);
-        del_c(map->value_class, it.value);
+    map_remove_all(map);
+}
 
-        // Keys need to be nulled as they are checked against null for existance
-        // Values only exist with a non-null key, so they don't need to be nulled.
-        map->keys[it.index] = NULL;
-    }
-    map->length = 0;
+void map_reserve(Map map, uint32_t length)
+{
+    map_reserve_all(map, length);
 }
 
+void map_put_all(Map map, uint32_t length, pointer_t* keys, pointer_t* values)
+{
+    map_insert_all(map, length, keys, values);
+}
 
-// Private Methods
+HashBloomStats map_bloom_stats(Map map)
+{
+    return map_bloom_report(map);
+}
 
-// Get, but returns the value as a result
-// Allows NULL values, but identifies if the key was present in the map or not.
-static Result(pointer_t) map_get_internal(Map map, pointer_t key)
+HashStats map_stats(Map map)
+{
+    return map_stats_report(map);
+}
+
+
+// Pre-hashed Instance Methods
+// h is the hash of the key, as returned by hash_c()
+
+bool map_put_hashed(Map map, pointer_t key, pointer_t value, uint32_t h)
+{
+    map_reserve_one(map);
+    return map_insert_hashed(map, key, value, map_stored_hash(map, h));
+}
+
+bool map_contains_key_hashed(Map map, pointer_t key, uint32_t h)
+{
+    return is_ok(map_get_internal(map, key, h));
+}
+
+pointer_t map_get_hashed(Map map, pointer_t key, uint32_t h)
+{
+    return unwrap_default(map_get_internal(map, key, h));
+}
+
+bool map_remove_hashed(Map map, pointer_t key, uint32_t h, pointer_t* removed_key, pointer_t* removed_value)
+{
+    return map_remove_key_hashed(map, key, map_stored_hash(map, h), removed_key, removed_value);
+}
+
+
+// Entry API
+
+MapEntry map_entry(Map map, pointer_t key)
 {
     panic_if_null(key, "Null Pointer: Map key must not be null.");
 
-    uint32_t mask = (map->size - 1);
-    uint32_t index = hash_c(map->key_class, key) & mask;
-    pointer_t current_key = map->keys[index];
-    
-    while (current_key != NULL) // The map must always have at least one empty spot - so this is gaurenteed to terminate
-    {
-        // Test current key
-        if (equals_c(map->key_class, current_key, key))
-        {
-            return Ok(pointer_t, map->values[index]); // Key match
-        }
-        index = (index + 1) & mask;
-        current_key = map->keys[index];
-    }
-    return Err(pointer_t); // No match
+    return map_entry_hashed(map, key, hash_c(map->key_class, key));
+}
+
+MapEntry map_entry_hashed(Map map, pointer_t key, uint32_t h)
+{
+    // Reserve space before probing, as resizing (or migrating) would move the slot the entry refers to
+    map_reserve_one(map);
+
+    MapEntry entry = { map, key, map_stored_hash(map, h), 0, 0, false };
+    entry.occupied = map_probe(map, key, entry.hash, &entry.index, &entry.distance);
+    return entry;
+}
+
+pointer_t* map_entry_value(MapEntry* entry)
+{
+    return entry->occupied ? &entry->map->slots[entry->index].value : NULL;
+}
+
+pointer_t* map_entry_insert(MapEntry* entry, pointer_t value)
+{
+    panic_if(entry->occupied, "Map entry is already occupied");
+
+    entry->index = map_fill(entry->map, entry->key, value, entry->hash, entry->index, entry->distance);
+    entry->occupied = true;
+    return &entry->map->slots[entry->index].value;
 }
 
-static void map_rehash(Map map)
+pointer_t map_get_or_insert(Map map, pointer_t key, pointer_t value)
 {
-    // Save a reference to the existing keys and values arrays
-    pointer_t* old_keys = map->keys;
-    pointer_t* old_values = map->values;
-    uint32_t old_size = map->size;
-    uint32_t new_size = old_size << 1;
+    panic_if_null(key, "Null Pointer: Map key must not be null.");
 
-    // Reallocate the new arrays
-    map->keys = safe_malloc(sizeof(pointer_t) * new_size);
-    map->values = safe_malloc(sizeof(pointer_t) * new_size);
+    return map_get_or_insert_hashed(map, key, value, hash_c(map->key_class, key));
+}
 
-    for (uint32_t i = 0; i < new_size; i++)
+pointer_t map_get_or_insert_hashed(Map map, pointer_t key, pointer_t value, uint32_t h)
+{
+    MapEntry entry = map_entry_hashed(map, key, h);
+    if (entry.occupied)
     {
-        map->keys[i] = NULL;
-        map->values[i] = NULL;
+        del_c(map->key_class, key);
+        del_c(map->value_class, value);
+        return *map_entry_value(&entry);
     }
+    return *map_entry_insert(&entry, value);
+}
 
-    // Set the map to empty
-    map->size = new_size;
-    map->length = 0;
 
-    // Insert all old values
-    for (uint32_t index = 0; index < old_size; index++)
+// Private Methods
+
+// Get, by the hash of the key, but returns the value as a result
+// Allows NULL values, but identifies if the key was present in the map or not.
+static Result(pointer_t) map_get_internal(Map map, pointer_t key, uint32_t h)
+{
+    Result(uint32_t) index = map_find_hashed(map, key, map_stored_hash(map, h));
+    if (is_ok(index))
     {
-        pointer_t old_key = old_keys[index];
-        if (old_key != NULL)
-        {
-            map_put(map, old_key, old_values[index]);
-        }
+        return Ok(pointer_t, map_slot_table(map, index.value)->slots[map_slot_index(map, index.value)].value); // Key match, in either the map or a previous map
     }
+    return Err(pointer_t); // No match
+}
 
-    // Free now-unused old keys and values arrays
-    free(old_keys);
-    free(old_values);
-}
\ No newline at end of file
+// The name the map is reported with, with HASH_STATS
+static String map_stats_name(Map map)
+{
+    return str_format("Map<%s, %s>", map->key_class->name, map->value_class->name);
+}
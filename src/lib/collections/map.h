@@ -1,19 +1,43 @@
 // An Array backed Hash Map for generic key and value types
-// Uses a simple backing array with linear probing for hash collisions
+// Uses a simple backing array with open addressing for hash collisions. The probing engine is selected by the HashOptions passed to the constructor
+// Each slot holds a key, it's value, and the key's cached hash together, so a lookup which finds it's key reads a single cache line
 
 #include "../lib.h"
+#include "hashtable.h"
 
 #ifndef COLLECTIONS_MAP_H
 #define COLLECTIONS_MAP_H
 
+typedef struct
+{
+    pointer_t key; // The key, or NULL for an empty slot
+    pointer_t value; // The value. Only valid for a non-NULL key
+    uint32_t hash; // The cached hash of the key. For the Swiss engine, or with a seed, this is the mixed hash
+} MapSlot;
+
 struct Map__struct
 {
-    pointer_t* keys; // Key array
-    pointer_t* values; // Value array
+    MapSlot* slots; // Slot array
+    uint8_t* control; // Control bytes for each slot. Only used by the Swiss engine
+    struct Map__struct* previous; // During an incremental resize, the map being migrated from. NULL otherwise
+    uint32_t migrated; // During an incremental resize, the index in the previous map up to which all keys have been migrated
+    uint32_t* filled; // With HASH_REUSABLE, the index of each slot filled since the last clear, possibly repeated. NULL otherwise
+    uint32_t filled_length; // The number of indices in the filled log, or UINT32_MAX if more slots were filled than the log can hold
+    uint64_t* bloom; // With HASH_BLOOM, the Bloom filter of keys, shared with any previous map. NULL otherwise
+    uint32_t bloom_blocks; // The number of blocks in the Bloom filter. A power of 2
+    uint64_t bloom_lookups; // The number of lookups which checked the Bloom filter
+    uint64_t bloom_rejected; // The number of lookups which the Bloom filter answered as missing
+    uint64_t bloom_false_positives; // The number of lookups which passed the Bloom filter, but were missing
+    uint32_t rehashes; // The number of times the backing arrays were replaced, by a resize, or a rehash to clear tombstones
+    uint32_t stats_id; // With HASH_STATS set in the environment, the map's entry in the stats registry. UINT32_MAX otherwise
     Class key_class; // The key class
     Class value_class; // The value class
+    HashOptions options; // The options this map was created with
+    uint32_t seed; // With HASH_SEEDED, a random seed which is mixed into the hash of every key, so each map places keys differently. 0 otherwise. May be set before inserting
+    double load_factor; // The maximum ratio of length to size before the backing arrays are resized. May be tuned before inserting
     uint32_t size; // The length of the backing array. Must be a power of 2
-    uint32_t length; // The number of entries
+    uint32_t tombstones; // The number of DELETED slots. Only used by the Swiss engine
+    uint32_t length; // The number of entries, including those not yet migrated from a previous map
 };
 
 typedef struct Map__struct * Map;
@@ -22,11 +46,21 @@ typedef struct Map__struct * Map;
 // It does not have a Class<T> object, nor implement all methods of the class
 // However, it can still be used with new(), del(), and format()
 
-declare_constructor(Map, uint32_t initial_size, Class key_class, Class value_class);
+declare_constructor(Map, uint32_t initial_size, Class key_class, Class value_class, HashOptions options);
+
+// The options are optional, new(Map, initial_size, key_class, value_class) will use HASH_DEFAULT
+#define Map__new(initial_size, key_class, value_class, options...) Map__new(initial_size, key_class, value_class, ARG_2(~, ## options, HASH_DEFAULT))
 
 void Map__del(Map map);
 String Map__format(Map map);
 
+// Creates a map from parallel arrays of keys and values, sized once to hold all of them. Ownership of every key and value is given to the map, but the arrays themselves are borrowed.
+// If any keys are equal, the last is kept, as with map_put(). Above HASH_PARALLEL_THRESHOLD keys, they are hashed and placed using multiple threads.
+Map map_from_arrays(uint32_t length, pointer_t* keys, pointer_t* values, Class key_class, Class value_class, HashOptions options);
+
+// The options are optional, as with new(Map, ...)
+#define map_from_arrays(length, keys, values, key_class, value_class, options...) map_from_arrays(length, keys, values, key_class, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
 // Iterator
 // test() is defined as a function in order to skip otherwise empty entries
 // We still increment during next() (but do not assign key/value) in order to assign *after* the test passes, and avoid running off the end of the array.
@@ -56,7 +90,67 @@ bool map_contains_key(Map map, pointer_t key);
 // Gets the current value associated to a particular key, or NULL if there was none
 pointer_t map_get(Map map, pointer_t key);
 
-// Clears the map
+// Removes a key from the map. Returns true if the key was present.
+// Ownership of the key and value stored in the map is given to the caller, through removed_key and removed_value. Either may be NULL, in which case it is deleted instead.
+// The queried key is only borrowed, and may be a different (but equal) instance to the removed key.
+bool map_remove(Map map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value);
+
+// Clears the map. With HASH_REUSABLE, this only visits the slots filled since the last clear
 void map_clear(Map map);
 
+// Grows the map, if needed, so it can hold a total of length keys without resizing again. In incremental mode, this resizes immediately.
+void map_reserve(Map map, uint32_t length);
+
+// Puts each (key, value) pair from parallel arrays into the map, as with map_put(), resizing at most once. Ownership of every key and value is given to the map, but the arrays themselves are borrowed.
+void map_put_all(Map map, uint32_t length, pointer_t* keys, pointer_t* values);
+
+// Gets the counts of lookups answered by the Bloom filter, with HASH_BLOOM, and the filter's false positive rate: the fraction of lookups of missing keys which it did not answer. Without HASH_BLOOM, every count is zero.
+HashBloomStats map_bloom_stats(Map map);
+
+// Gets the size, load, probe lengths and clustering of the map, see HashStats. Visits every slot.
+HashStats map_stats(Map map);
+
+
+// Pre-hashed Instance Methods
+// As the above, but given h, the hash of the key as returned by hash_c(), so a caller which has already hashed the key (i.e. to select a shard of a ConcurrentMap) need not hash it again.
+// The key must not be NULL.
+
+bool map_put_hashed(Map map, pointer_t key, pointer_t value, uint32_t h);
+bool map_contains_key_hashed(Map map, pointer_t key, uint32_t h);
+pointer_t map_get_hashed(Map map, pointer_t key, uint32_t h);
+bool map_remove_hashed(Map map, pointer_t key, uint32_t h, pointer_t* removed_key, pointer_t* removed_value);
+
+
+// Entry API
+// An entry is the result of a single probe for a key, and refers to the slot where the key is, or where it would be inserted.
+// It can then be read, filled or updated without hashing or probing the key again.
+// An entry is only valid until the map is next modified, other than through the entry itself.
+
+typedef struct
+{
+    Map map; // The map this entry belongs to
+    pointer_t key; // The queried key. Borrowed, unless the entry is inserted
+    uint32_t hash; // The hash of the queried key, as stored in the map
+    uint32_t index; // The index of the key's slot if occupied, otherwise where it would be placed
+    uint32_t distance; // The probe distance of index, if vacant
+    bool occupied; // true if the key is present in the map
+} MapEntry;
+
+// Probes the map for a key, reserving space to insert it if it is absent. The key is borrowed.
+MapEntry map_entry(Map map, pointer_t key);
+MapEntry map_entry_hashed(Map map, pointer_t key, uint32_t h);
+
+// Gets a pointer to the value of an occupied entry, which may be read, or assigned to update the value in place. Returns NULL for a vacant entry.
+// The value is borrowed. When assigning a new value, the previous value must be deleted (or taken) by the caller.
+pointer_t* map_entry_value(MapEntry* entry);
+
+// Inserts a value for a vacant entry. Ownership of both the entry's key and the value is given to the map. Panics if the entry is occupied.
+// Returns a pointer to the inserted value.
+pointer_t* map_entry_insert(MapEntry* entry, pointer_t value);
+
+// Gets the value associated to a key, or inserts (key, value) if it is absent, with a single probe. Returns the value now in the map, which is borrowed.
+// Ownership of both the key and value is given to the map. If the key was already present, they are deleted.
+pointer_t map_get_or_insert(Map map, pointer_t key, pointer_t value);
+pointer_t map_get_or_insert_hashed(Map map, pointer_t key, pointer_t value, uint32_t h);
+
 #endif
\ No newline at end of file
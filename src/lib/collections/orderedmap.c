@@ -0,0 +1,349 @@
+#include "orderedmap.h"
+
+// Private Methods
+
+static uint32_t omap_usable(uint32_t size);
+static uint32_t omap_width(uint32_t size);
+static uint32_t omap_slot(OrderedMap map, uint32_t slot);
+static void omap_set_slot(OrderedMap map, uint32_t slot, uint32_t value);
+static uint32_t omap_hash(OrderedMap map, pointer_t key);
+static bool omap_probe(OrderedMap map, pointer_t key, uint32_t h, uint32_t* slot);
+static void omap_unlink(OrderedMap map, uint32_t slot);
+static void omap_rebuild(OrderedMap map, uint32_t size);
+static void omap_reserve_one(OrderedMap map);
+
+
+OrderedMap OrderedMap__new(uint32_t initial_size, Class key_class, Class value_class)
+{
+    uint32_t size = next_highest_power_of_two(max(initial_size, 8u));
+    OrderedMap map = class_malloc(OrderedMap);
+
+    map->key_class = key_class;
+    map->value_class = value_class;
+    map->width = omap_width(size);
+    map->size = size;
+    map->index = safe_calloc(map->width * size); // Empty slots
+    map->capacity = omap_usable(size);
+    map->entries = safe_malloc(sizeof(OrderedMapEntry) * map->capacity);
+    map->hashes = safe_malloc(sizeof(uint32_t) * map->capacity);
+    map->used = 0;
+    map->length = 0;
+
+    return map;
+}
+
+void OrderedMap__del(OrderedMap map)
+{
+    for iter(OrderedMap, it, map)
+    {
+        del_c(map->key_class, it.key);
+        del_c(map->value_class, it.value);
+    }
+    free(map->index);
+    free(map->entries);
+    free(map->hashes);
+    free(map);
+}
+
+String OrderedMap__format(OrderedMap map)
+{
+    String s = new(String, "OrderedMap<");
+    str_append(s, map->key_class->name);
+    str_append(s, ", ");
+    str_append(s, map->value_class->name);
+    str_append(s, ">{");
+    if (map->length == 0)
+    {
+        str_append(s, "}");
+        return s;
+    }
+    else
+    {
+        for iter(OrderedMap, it, map)
+        {
+            str_append(s, format_c(map->key_class, it.key));
+            str_append(s, ": ");
+            str_append(s, format_c(map->value_class, it.value));
+            str_append(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append(s, "}");
+    return s;
+}
+
+
+// Iterator
+
+bool OrderedMap__iterator__test(Iterator(OrderedMap)* it, OrderedMap map)
+{
+    for (;it->index < map->used; it->index++) // Don't iterate off the end of the entries
+    {
+        OrderedMapEntry* entry = &map->entries[it->index];
+        if (entry->key != NULL) // Skip removed entries
+        {
+            it->key = entry->key;
+            it->value = entry->value;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// Instance Methods
+
+bool omap_put(OrderedMap map, pointer_t key, pointer_t value)
+{
+    panic_if_null(key, "Null Pointer: OrderedMap key must not be null");
+
+    // Reserve space before probing, as rebuilding the index would move the slot
+    omap_reserve_one(map);
+
+    uint32_t h = omap_hash(map, key), slot;
+    if (omap_probe(map, key, h, &slot))
+    {
+        // Key match. Replace the key and value of the entry, which keeps it's position
+        OrderedMapEntry* entry = &map->entries[omap_slot(map, slot) - 1];
+        del_c(map->key_class, entry->key);
+        del_c(map->value_class, entry->value);
+        entry->key = key;
+        entry->value = value;
+        return true;
+    }
+
+    // Append a new entry, and point the empty slot at it
+    map->entries[map->used] = (OrderedMapEntry) { key, value };
+    map->hashes[map->used] = h;
+    map->used++;
+    map->length++;
+    omap_set_slot(map, slot, map->used);
+    return false;
+}
+
+bool omap_contains_key(OrderedMap map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: OrderedMap key must not be null");
+
+    uint32_t slot;
+    return omap_probe(map, key, omap_hash(map, key), &slot);
+}
+
+pointer_t omap_get(OrderedMap map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: OrderedMap key must not be null");
+
+    uint32_t slot;
+    if (omap_probe(map, key, omap_hash(map, key), &slot))
+    {
+        return map->entries[omap_slot(map, slot) - 1].value;
+    }
+    return NULL;
+}
+
+bool omap_remove(OrderedMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value)
+{
+    panic_if_null(key, "Null Pointer: OrderedMap key must not be null");
+
+    uint32_t slot;
+    if (!omap_probe(map, key, omap_hash(map, key), &slot))
+    {
+        return false;
+    }
+
+    OrderedMapEntry* entry = &map->entries[omap_slot(map, slot) - 1];
+    if (removed_key != NULL)
+    {
+        *removed_key = entry->key;
+    }
+    else
+    {
+        del_c(map->key_class, entry->key);
+    }
+    if (removed_value != NULL)
+    {
+        *removed_value = entry->value;
+    }
+    else
+    {
+        del_c(map->value_class, entry->value);
+    }
+
+    // The entry is left as a hole, so later entries keep their numbers. Once holes outnumber the remaining entries, they are compacted away, so iteration stays O(length)
+    entry->key = NULL;
+    entry->value = NULL;
+    map->length--;
+    omap_unlink(map, slot);
+
+    if (map->used - map->length > map->length + 8)
+    {
+        uint32_t size = map->size;
+        while (size > 8 && omap_usable(size >> 1) >= 2 * map->length)
+        {
+            size >>= 1;
+        }
+        omap_rebuild(map, size);
+    }
+    return true;
+}
+
+void omap_clear(OrderedMap map)
+{
+    uint32_t mask = map->size - 1;
+    for (uint32_t i = 0; i < map->used; i++)
+    {
+        OrderedMapEntry* entry = &map->entries[i];
+        if (entry->key != NULL)
+        {
+            del_c(map->key_class, entry->key);
+            del_c(map->value_class, entry->value);
+
+            // Empty the rest of the cluster from this entry's home slot. Every key in the cluster is being removed, and the first slot of a cluster is always the home of it's key, so this empties every cluster in O(length)
+            for (uint32_t slot = map->hashes[i] & mask; omap_slot(map, slot) != 0; slot = (slot + 1) & mask)
+            {
+                omap_set_slot(map, slot, 0);
+            }
+        }
+    }
+    map->used = 0;
+    map->length = 0;
+}
+
+
+// Private Methods
+
+// The maximum number of entries for an index of a given size, which keeps the load factor at most HASH_LINEAR_LOAD_FACTOR
+static uint32_t omap_usable(uint32_t size)
+{
+    return (uint32_t) (size * HASH_LINEAR_LOAD_FACTOR);
+}
+
+// The width of each index slot, which must hold every entry number plus one, and 0
+static uint32_t omap_width(uint32_t size)
+{
+    return size <= (1 << 8) ? sizeof(uint8_t) : size <= (1 << 16) ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+// Reads the index slot, which is 0 if empty, or an entry number plus one
+static uint32_t omap_slot(OrderedMap map, uint32_t slot)
+{
+    switch (map->width)
+    {
+        case sizeof(uint8_t): return ((uint8_t*) map->index)[slot];
+        case sizeof(uint16_t): return ((uint16_t*) map->index)[slot];
+        default: return ((uint32_t*) map->index)[slot];
+    }
+}
+
+static void omap_set_slot(OrderedMap map, uint32_t slot, uint32_t value)
+{
+    switch (map->width)
+    {
+        case sizeof(uint8_t): ((uint8_t*) map->index)[slot] = (uint8_t) value; break;
+        case sizeof(uint16_t): ((uint16_t*) map->index)[slot] = (uint16_t) value; break;
+        default: ((uint32_t*) map->index)[slot] = value; break;
+    }
+}
+
+// The class hash is mixed, as the index is masked to it's low bits, which class hashes such as identity hashes for integers do not fill
+static uint32_t omap_hash(OrderedMap map, pointer_t key)
+{
+    return hash_mix(hash_c(map->key_class, key));
+}
+
+// Probes the index for a key with hash h. Returns true if it was found, and sets slot to it's index slot, or to the empty slot where it would be inserted.
+static bool omap_probe(OrderedMap map, pointer_t key, uint32_t h, uint32_t* slot)
+{
+    uint32_t mask = map->size - 1;
+    for (uint32_t index = h & mask;; index = (index + 1) & mask)
+    {
+        uint32_t value = omap_slot(map, index);
+        if (value == 0)
+        {
+            *slot = index;
+            return false;
+        }
+        if (map->hashes[value - 1] == h && equals_c(map->key_class, map->entries[value - 1].key, key))
+        {
+            *slot = index;
+            return true;
+        }
+    }
+}
+
+// Empties an index slot, shifting back any later slots in the same cluster which may be moved closer to their home slot, so no tombstones are needed
+static void omap_unlink(OrderedMap map, uint32_t slot)
+{
+    uint32_t mask = map->size - 1;
+    for (uint32_t index = (slot + 1) & mask;; index = (index + 1) & mask)
+    {
+        uint32_t value = omap_slot(map, index);
+        if (value == 0)
+        {
+            break;
+        }
+        uint32_t home = map->hashes[value - 1] & mask;
+        if (((index - slot) & mask) <= ((index - home) & mask))
+        {
+            // The empty slot lies between this slot's home and itself, so it can be moved back
+            omap_set_slot(map, slot, value);
+            slot = index;
+        }
+    }
+    omap_set_slot(map, slot, 0);
+}
+
+// Compacts the entries, removing any holes while keeping their order, and rebuilds the index with a given size
+static void omap_rebuild(OrderedMap map, uint32_t size)
+{
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < map->used; i++)
+    {
+        if (map->entries[i].key != NULL)
+        {
+            map->entries[used] = map->entries[i];
+            map->hashes[used] = map->hashes[i];
+            used++;
+        }
+    }
+    map->used = used;
+
+    if (map->capacity > omap_usable(size))
+    {
+        map->capacity = omap_usable(size);
+        safe_realloc(map->entries, sizeof(OrderedMapEntry) * map->capacity);
+        safe_realloc(map->hashes, sizeof(uint32_t) * map->capacity);
+    }
+
+    free(map->index);
+    map->width = omap_width(size);
+    map->size = size;
+    map->index = safe_calloc(map->width * size);
+
+    uint32_t mask = size - 1;
+    for (uint32_t i = 0; i < used; i++)
+    {
+        uint32_t slot = map->hashes[i] & mask;
+        while (omap_slot(map, slot) != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        omap_set_slot(map, slot, i + 1);
+    }
+}
+
+// Ensures there is space to append one more entry
+// The index is rebuilt once the entries reach the maximum for it's size, doubling it unless at least half of the entries are holes. Otherwise, the entries array alone grows, by half again.
+static void omap_reserve_one(OrderedMap map)
+{
+    if (map->used == omap_usable(map->size))
+    {
+        omap_rebuild(map, map->length >= map->used / 2 ? map->size << 1 : map->size);
+    }
+    if (map->used == map->capacity)
+    {
+        map->capacity = min(map->capacity + max(map->capacity >> 1, 8u), omap_usable(map->size));
+        safe_realloc(map->entries, sizeof(OrderedMapEntry) * map->capacity);
+        safe_realloc(map->hashes, sizeof(uint32_t) * map->capacity);
+    }
+}
@@ -0,0 +1,78 @@
+// An insertion ordered Hash Map for generic key and value types (a compact dict)
+// Entries are stored densely, in insertion order, and a separate index array of entry numbers is probed with linear probing.
+// Iterating, formatting, clearing or deleting the map walks the entries, which costs O(length) rather than O(size) as with Map.
+// The index is much smaller than a Map's slots, as each index slot is a 1, 2 or 4 byte entry number (depending on the size of the index), and the entries array grows independently of it.
+
+#include "../lib.h"
+#include "hashtable.h"
+
+#ifndef COLLECTIONS_ORDERED_MAP_H
+#define COLLECTIONS_ORDERED_MAP_H
+
+typedef struct
+{
+    pointer_t key; // The key, or NULL for an entry which has been removed
+    pointer_t value; // The value. Only valid for a non-NULL key
+} OrderedMapEntry;
+
+struct OrderedMap__struct
+{
+    void* index; // Index array. Each slot holds an entry number plus one, or 0 for an empty slot, as a 1, 2 or 4 byte integer
+    OrderedMapEntry* entries; // Entry array, in insertion order
+    uint32_t* hashes; // The (mixed) hash of each entry's key, parallel to the entries array
+    Class key_class; // The key class
+    Class value_class; // The value class
+    uint32_t width; // The number of bytes of each index slot
+    uint32_t size; // The length of the index array. Must be a power of 2
+    uint32_t capacity; // The length of the entries array. At most HASH_LINEAR_LOAD_FACTOR * size
+    uint32_t used; // The number of entries used, including removed entries. Entries are always appended, at this position
+    uint32_t length; // The number of entries which have not been removed
+};
+
+typedef struct OrderedMap__struct * OrderedMap;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+
+declare_constructor(OrderedMap, uint32_t initial_size, Class key_class, Class value_class);
+
+void OrderedMap__del(OrderedMap map);
+String OrderedMap__format(OrderedMap map);
+
+// Iterator
+// Entries are iterated in the order their keys were first inserted. Removed entries are skipped, but there are never more removed entries than remaining ones.
+
+typedef struct
+{
+    uint32_t index;
+    pointer_t key;
+    pointer_t value;
+} Iterator(OrderedMap);
+
+bool OrderedMap__iterator__test(Iterator(OrderedMap)* it, OrderedMap map);
+
+#define OrderedMap__iterator__start(map) { 0, NULL, NULL }
+#define OrderedMap__iterator__next(it, map) (it)->index++
+
+
+// Public Instance Methods - these all borrow the map
+
+// Puts a (key, value) pair into the map. Returns true if the key was already in the map
+// A key which was already present keeps it's position in the iteration order, but the previous key and value are deleted and replaced, as with map_put()
+bool omap_put(OrderedMap map, pointer_t key, pointer_t value);
+
+// Checks if a key is present in the map.
+bool omap_contains_key(OrderedMap map, pointer_t key);
+
+// Gets the current value associated to a particular key, or NULL if there was none
+pointer_t omap_get(OrderedMap map, pointer_t key);
+
+// Removes a key from the map. Returns true if the key was present.
+// Ownership of the key and value stored in the map is given to the caller, through removed_key and removed_value. Either may be NULL, in which case it is deleted instead.
+bool omap_remove(OrderedMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value);
+
+// Clears the map. This is O(length), and keeps the allocated index and entries arrays
+void omap_clear(OrderedMap map);
+
+#endif
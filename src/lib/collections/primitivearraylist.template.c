@@ -1,6 +1,7 @@
 // Template
 // Implementation for PrimitiveArrayList(type)
 // @param type : The type of the array list
+// @param sum_type : The type of the sum of the list, int64_t or uint64_t
 
 // Local definitions
 // Undef'd at the end of this template
@@ -13,10 +14,7 @@ impl_class(PrimitiveArrayList_t);
 PrimitiveArrayList_t CONCAT3(al_, type, _from_array)(type array[], uint32_t size)
 {
     PrimitiveArrayList_t list = new(PrimitiveArrayList_t, size);
-    for (uint32_t i = 0; i < size; i++)
-    {
-        list->values[i] = array[i];
-    }
+    memcpy(list->values, array, sizeof(type) * size);
     list->length = size;
     return list;
 }
@@ -43,11 +41,8 @@ void CONCAT3(ArrayList_, type, __del)(PrimitiveArrayList_t list)
 
 PrimitiveArrayList_t CONCAT3(ArrayList_, type, __copy)(PrimitiveArrayList_t list)
 {
-    PrimitiveArrayList_t new_list = new(PrimitiveArrayList_t, list->length);
-    for iter(PrimitiveArrayList_t, it, list)
-    {
-        new_list->values[it.index] = it.value;
-    }
+    PrimitiveArrayList_t new_list = new(PrimitiveArrayList_t, max(list->length, 1u));
+    memcpy(new_list->values, list->values, sizeof(type) * list->length);
     new_list->length = list->length;
     return new_list;
 }
@@ -94,7 +89,7 @@ uint32_t CONCAT3(ArrayList_, type, __hash)(PrimitiveArrayList_t instance)
     uint32_t h = 0;
     for iter(PrimitiveArrayList_t, it, instance)
     {
-        h = (31 * h + hash(type, it.value));
+        h = hash_combine(h, hash(type, it.value));
     }
     return h;
 }
@@ -114,6 +109,150 @@ int32_t CONCAT3(ArrayList_, type, __compare)(PrimitiveArrayList_t left, Primitiv
     return compare(uint32_t, left->length, right->length);
 }
 
+// Kernels
+// Each is a plain loop, written so that the compiler vectorizes it for both SSE2 and AVX2. The array must not be empty
+
+ARRAY_LIST_KERNEL(sum_type, CONCAT3(al_, type, _sum_kernel), (const type* values, uint32_t length), (values, length), {
+    sum_type sum = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        sum += values[i];
+    }
+    return sum;
+})
+
+ARRAY_LIST_KERNEL(type, CONCAT3(al_, type, _min_kernel), (const type* values, uint32_t length), (values, length), {
+    type min_value = values[0];
+    for (uint32_t i = 1; i < length; i++)
+    {
+        min_value = values[i] < min_value ? values[i] : min_value;
+    }
+    return min_value;
+})
+
+ARRAY_LIST_KERNEL(type, CONCAT3(al_, type, _max_kernel), (const type* values, uint32_t length), (values, length), {
+    type max_value = values[0];
+    for (uint32_t i = 1; i < length; i++)
+    {
+        max_value = values[i] > max_value ? values[i] : max_value;
+    }
+    return max_value;
+})
+
+ARRAY_LIST_KERNEL(void, CONCAT3(al_, type, _minmax_kernel), (const type* values, uint32_t length, type* min_value, type* max_value), (values, length, min_value, max_value), {
+    type low = values[0], high = values[0];
+    for (uint32_t i = 1; i < length; i++)
+    {
+        low = values[i] < low ? values[i] : low;
+        high = values[i] > high ? values[i] : high;
+    }
+    *min_value = low;
+    *max_value = high;
+})
+
+// A loop which tracks the index of the maximum can't be vectorized, so this finds the maximum of each block with a loop that can, and only tracks the first block with the overall maximum
+ARRAY_LIST_KERNEL(uint32_t, CONCAT3(al_, type, _argmax_kernel), (const type* values, uint32_t length), (values, length), {
+    type max_value = values[0];
+    uint32_t max_block = 0;
+    for (uint32_t start = 0; start < length; start += ARRAY_LIST_ARGMAX_BLOCK)
+    {
+        uint32_t end = min(start + ARRAY_LIST_ARGMAX_BLOCK, length);
+        type block_max = values[start];
+        for (uint32_t i = start + 1; i < end; i++)
+        {
+            block_max = values[i] > block_max ? values[i] : block_max;
+        }
+        if (block_max > max_value)
+        {
+            max_value = block_max;
+            max_block = start;
+        }
+    }
+    uint32_t index = max_block;
+    while (values[index] != max_value)
+    {
+        index++;
+    }
+    return index;
+})
+
+ARRAY_LIST_KERNEL(uint32_t, CONCAT3(al_, type, _count_kernel), (const type* values, uint32_t length, type value), (values, length, value), {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        count += values[i] == value;
+    }
+    return count;
+})
+
+// Returns the first index of a value, or length if it is not present
+ARRAY_LIST_KERNEL(uint32_t, CONCAT3(al_, type, _index_of_kernel), (const type* values, uint32_t length, type value), (values, length, value), {
+    for (uint32_t start = 0; start < length; start += ARRAY_LIST_SEARCH_BLOCK)
+    {
+        uint32_t end = min(start + ARRAY_LIST_SEARCH_BLOCK, length), matches = 0;
+        for (uint32_t i = start; i < end; i++)
+        {
+            matches += values[i] == value;
+        }
+        if (matches != 0)
+        {
+            uint32_t index = start;
+            while (values[index] != value)
+            {
+                index++;
+            }
+            return index;
+        }
+    }
+    return length;
+})
+
+// Returns the last index of a value, or length if it is not present. Blocks are aligned to the end of the array
+ARRAY_LIST_KERNEL(uint32_t, CONCAT3(al_, type, _last_index_of_kernel), (const type* values, uint32_t length, type value), (values, length, value), {
+    for (uint32_t end = length; end > 0;)
+    {
+        uint32_t start = end > ARRAY_LIST_SEARCH_BLOCK ? end - ARRAY_LIST_SEARCH_BLOCK : 0, matches = 0;
+        for (uint32_t i = start; i < end; i++)
+        {
+            matches += values[i] == value;
+        }
+        if (matches != 0)
+        {
+            uint32_t index = end - 1;
+            while (values[index] != value)
+            {
+                index--;
+            }
+            return index;
+        }
+        end = start;
+    }
+    return length;
+})
+
+// Sorting
+// The key of a value, whose bytes, compared as unsigned, order values the same as the values themselves
+// For signed types, this flips the sign bit, so negative values are ordered first
+static inline uint64_t CONCAT3(al_, type, _radix_key)(type value)
+{
+    bool is_signed = (type) -1 < (type) 1; // Not compared with 0, which warns for unsigned types
+    return (uint64_t) value ^ (is_signed ? (uint64_t) 1 << (8 * sizeof(type) - 1) : 0);
+}
+
+static void CONCAT3(al_, type, _insertion_sort)(type* values, uint32_t length)
+{
+    for (uint32_t i = 1; i < length; i++)
+    {
+        type value = values[i];
+        uint32_t j = i;
+        for (; j > 0 && values[j - 1] > value; j--)
+        {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+}
+
 // Instance Methods
 type CONCAT3(al_, type, _get)(PrimitiveArrayList_t list, uint32_t index)
 {
@@ -131,22 +270,171 @@ void CONCAT3(al_, type, _append)(PrimitiveArrayList_t list, type value)
 {
     if (list->length == list->size)
     {
-        // Resize the array
-        uint32_t old_size = list->size;
-        uint32_t new_size = old_size * 2;
-        type* new_array = safe_malloc(sizeof(type) * new_size);
-
-        memcpy(new_array, list->values, sizeof(type) * old_size);
-        free(list->values);
-
-        list->values = new_array;
-        list->size = new_size;
+        CONCAT3(al_, type, _reserve)(list, list->size * 2);
     }
     // Append at index length
     list->values[list->length] = value;
     list->length++;
 }
 
+void CONCAT3(al_, type, _extend)(PrimitiveArrayList_t list, PrimitiveArrayList_t other)
+{
+    // Resize before reading the values of other, as it may be the same list
+    uint32_t length = other->length;
+    if (list->length + length > list->size)
+    {
+        CONCAT3(al_, type, _reserve)(list, max(list->length + length, list->size * 2));
+    }
+    memcpy(list->values + list->length, other->values, sizeof(type) * length);
+    list->length += length;
+}
+
+void CONCAT3(al_, type, _extend_array)(PrimitiveArrayList_t list, type array[], uint32_t length)
+{
+    if (list->length + length > list->size)
+    {
+        CONCAT3(al_, type, _reserve)(list, max(list->length + length, list->size * 2));
+    }
+    memcpy(list->values + list->length, array, sizeof(type) * length);
+    list->length += length;
+}
+
+void CONCAT3(al_, type, _reserve)(PrimitiveArrayList_t list, uint32_t size)
+{
+    if (size > list->size)
+    {
+        // realloc() can often extend the array in place, where malloc() and copying never can
+        safe_realloc(list->values, sizeof(type) * size);
+        list->size = size;
+    }
+}
+
+void CONCAT3(al_, type, _shrink_to_fit)(PrimitiveArrayList_t list)
+{
+    uint32_t size = max(list->length, 1u); // The size must remain positive, so the list can still grow by doubling
+    if (size < list->size)
+    {
+        safe_realloc(list->values, sizeof(type) * size);
+        list->size = size;
+    }
+}
+
+sum_type CONCAT3(al_, type, _sum)(PrimitiveArrayList_t list)
+{
+    return list->length == 0 ? 0 : CONCAT3(al_, type, _sum_kernel)(list->values, list->length);
+}
+
+Result(type) CONCAT3(al_, type, _min)(PrimitiveArrayList_t list)
+{
+    return list->length == 0 ? Err(type) : Ok(type, CONCAT3(al_, type, _min_kernel)(list->values, list->length));
+}
+
+Result(type) CONCAT3(al_, type, _max)(PrimitiveArrayList_t list)
+{
+    return list->length == 0 ? Err(type) : Ok(type, CONCAT3(al_, type, _max_kernel)(list->values, list->length));
+}
+
+bool CONCAT3(al_, type, _minmax)(PrimitiveArrayList_t list, type* min_value, type* max_value)
+{
+    if (list->length == 0)
+    {
+        return false;
+    }
+    CONCAT3(al_, type, _minmax_kernel)(list->values, list->length, min_value, max_value);
+    return true;
+}
+
+Result(uint32_t) CONCAT3(al_, type, _argmax)(PrimitiveArrayList_t list)
+{
+    return list->length == 0 ? Err(uint32_t) : Ok(uint32_t, CONCAT3(al_, type, _argmax_kernel)(list->values, list->length));
+}
+
+Result(uint32_t) CONCAT3(al_, type, _index_of)(PrimitiveArrayList_t list, type value)
+{
+    uint32_t index = CONCAT3(al_, type, _index_of_kernel)(list->values, list->length, value);
+    return index == list->length ? Err(uint32_t) : Ok(uint32_t, index);
+}
+
+Result(uint32_t) CONCAT3(al_, type, _last_index_of)(PrimitiveArrayList_t list, type value)
+{
+    uint32_t index = CONCAT3(al_, type, _last_index_of_kernel)(list->values, list->length, value);
+    return index == list->length ? Err(uint32_t) : Ok(uint32_t, index);
+}
+
+uint32_t CONCAT3(al_, type, _count)(PrimitiveArrayList_t list, type value)
+{
+    return CONCAT3(al_, type, _count_kernel)(list->values, list->length, value);
+}
+
+bool CONCAT3(al_, type, _contains)(PrimitiveArrayList_t list, type value)
+{
+    return CONCAT3(al_, type, _index_of_kernel)(list->values, list->length, value) != list->length;
+}
+
+// Counts every byte of every key in one pass, and then for each byte from the least significant, moves the values into order by that byte, alternating between the list and a single scratch array.
+// Bytes which are the same for every value, such as the high bytes of small values, are skipped.
+void CONCAT3(al_, type, _sort)(PrimitiveArrayList_t list)
+{
+    uint32_t length = list->length;
+    if (length < ARRAY_LIST_RADIX_MIN_LENGTH)
+    {
+        CONCAT3(al_, type, _insertion_sort)(list->values, length);
+        return;
+    }
+
+    uint32_t counts[sizeof(type)][256] = { 0 };
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint64_t key = CONCAT3(al_, type, _radix_key)(list->values[i]);
+        for (uint32_t digit = 0; digit < sizeof(type); digit++)
+        {
+            counts[digit][(key >> (8 * digit)) & 0xFF]++;
+        }
+    }
+
+    type* from = list->values;
+    type* to = NULL;
+    type* scratch = NULL;
+    for (uint32_t digit = 0; digit < sizeof(type); digit++)
+    {
+        uint32_t shift = 8 * digit;
+        uint32_t* count = counts[digit];
+        if (count[(CONCAT3(al_, type, _radix_key)(from[0]) >> shift) & 0xFF] == length)
+        {
+            continue; // Every value has the same byte
+        }
+        if (scratch == NULL)
+        {
+            scratch = safe_malloc(sizeof(type) * length);
+            to = scratch;
+        }
+
+        // Convert the counts into the index of the first value with each byte
+        // These are copied to a local array, as writes to the values might otherwise alias the counts, and force them to be reloaded after every write
+        uint32_t offsets[256];
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            offsets[i] = offset;
+            offset += count[i];
+        }
+        for (uint32_t i = 0; i < length; i++)
+        {
+            to[offsets[(CONCAT3(al_, type, _radix_key)(from[i]) >> shift) & 0xFF]++] = from[i];
+        }
+
+        type* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != list->values)
+    {
+        memcpy(list->values, from, sizeof(type) * length);
+    }
+    free(scratch);
+}
+
 void CONCAT3(al_, type, _clear)(PrimitiveArrayList_t list)
 {
     // This is the simplest way to remove all values
@@ -155,4 +443,5 @@ void CONCAT3(al_, type, _clear)(PrimitiveArrayList_t list)
 }
 
 #undef type
+#undef sum_type
 #undef PrimitiveArrayList_t
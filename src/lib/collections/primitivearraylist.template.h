@@ -1,6 +1,7 @@
 // Template
 // Header for PrimitiveArrayList(type)
 // @param type : The type of the array list
+// @param sum_type : The type of the sum of the list, int64_t or uint64_t
 
 // Local definitions
 // Undef'd at the end of this template
@@ -34,8 +35,27 @@ type CONCAT3(al_, type, _get)(PrimitiveArrayList_t list, uint32_t index);
 
 void CONCAT3(al_, type, _set)(PrimitiveArrayList_t list, uint32_t index, type value);
 void CONCAT3(al_, type, _append)(PrimitiveArrayList_t list, type value);
+void CONCAT3(al_, type, _extend)(PrimitiveArrayList_t list, PrimitiveArrayList_t other);
+void CONCAT3(al_, type, _extend_array)(PrimitiveArrayList_t list, type array[], uint32_t length);
+
+void CONCAT3(al_, type, _reserve)(PrimitiveArrayList_t list, uint32_t size);
+void CONCAT3(al_, type, _shrink_to_fit)(PrimitiveArrayList_t list);
+
+sum_type CONCAT3(al_, type, _sum)(PrimitiveArrayList_t list);
+Result(type) CONCAT3(al_, type, _min)(PrimitiveArrayList_t list);
+Result(type) CONCAT3(al_, type, _max)(PrimitiveArrayList_t list);
+bool CONCAT3(al_, type, _minmax)(PrimitiveArrayList_t list, type* min_value, type* max_value);
+Result(uint32_t) CONCAT3(al_, type, _argmax)(PrimitiveArrayList_t list);
+
+Result(uint32_t) CONCAT3(al_, type, _index_of)(PrimitiveArrayList_t list, type value);
+Result(uint32_t) CONCAT3(al_, type, _last_index_of)(PrimitiveArrayList_t list, type value);
+uint32_t CONCAT3(al_, type, _count)(PrimitiveArrayList_t list, type value);
+bool CONCAT3(al_, type, _contains)(PrimitiveArrayList_t list, type value);
+
+void CONCAT3(al_, type, _sort)(PrimitiveArrayList_t list);
 
 void CONCAT3(al_, type, _clear)(PrimitiveArrayList_t list);
 
 #undef type
+#undef sum_type
 #undef PrimitiveArrayList_t
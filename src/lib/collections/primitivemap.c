@@ -0,0 +1,24 @@
+// Primitive Hash Maps
+
+#include "primitivemap.h"
+
+// Primitive Map Implementations
+// Uses Templating to achieve similar classes with proper line number references
+
+#define type char
+#include "primitivemap.template.c"
+
+#define type bool
+#include "primitivemap.template.c"
+
+#define type int32_t
+#include "primitivemap.template.c"
+
+#define type int64_t
+#include "primitivemap.template.c"
+
+#define type uint32_t
+#include "primitivemap.template.c"
+
+#define type uint64_t
+#include "primitivemap.template.c"
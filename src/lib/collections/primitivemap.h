@@ -0,0 +1,73 @@
+// Primitive Hash Maps
+// A hash map with keys and values of the same primitive type, e.g. PrimitiveMap(int32_t) maps int32_t keys to int32_t values
+// - Keys and values are stored inline in the slot array, so entries require no allocations, and there are no ownership semantics
+// - Keys are hashed and compared directly, rather than through Class function pointers
+// - Collisions are handled with the group probing (Swiss table) engine of Map, see hashtable.h
+// - They are typed as PrimitiveMap(type), and methods are delegated through _Generic macros with the 'pm' prefix
+
+#include "../lib.h"
+#include "hashtable.h"
+
+#ifndef COLLECTIONS_PRIMITIVE_MAP_H
+#define COLLECTIONS_PRIMITIVE_MAP_H
+
+#define PrimitiveMap(cls) CONCAT(Map_, cls)
+
+#define PRIMITIVE_MAP_GENERIC_PREFIX(map, method) _Generic((map), \
+    Map_char : pm_char_ ## method, \
+    Map_bool : pm_bool_ ## method, \
+    Map_int32_t : pm_int32_t_ ## method, \
+    Map_int64_t : pm_int64_t_ ## method, \
+    Map_uint32_t : pm_uint32_t_ ## method, \
+    Map_uint64_t : pm_uint64_t_ ## method)
+
+// All PrimitiveMap Instance Methods - Delegated through generic prefixing
+
+#define pm_put(map, key, value) PRIMITIVE_MAP_GENERIC_PREFIX(map, put) (map, key, value) // Puts a (key, value) pair into the map. Returns true if the key was already in the map
+#define pm_contains_key(map, key) PRIMITIVE_MAP_GENERIC_PREFIX(map, contains_key) (map, key) // Checks if a key is present in the map
+#define pm_get(map, key) PRIMITIVE_MAP_GENERIC_PREFIX(map, get) (map, key) // Gets the value associated with a key, or the default value of the type (e.g. 0) if there was none
+#define pm_remove(map, key) PRIMITIVE_MAP_GENERIC_PREFIX(map, remove) (map, key) // Removes a key from the map. Returns true if the key was present
+#define pm_clear(map) PRIMITIVE_MAP_GENERIC_PREFIX(map, clear) (map) // Clears the map
+
+// Primitive Maps
+// Uses Templating to achieve similar classes with proper line number references
+
+#define type char
+#include "primitivemap.template.h"
+
+#define type bool
+#include "primitivemap.template.h"
+
+#define type int32_t
+#include "primitivemap.template.h"
+
+#define type int64_t
+#include "primitivemap.template.h"
+
+#define type uint32_t
+#include "primitivemap.template.h"
+
+#define type uint64_t
+#include "primitivemap.template.h"
+
+// Iterators
+// test() is defined as a function in order to skip empty slots, as with Map
+
+#define Map_primitive__iterator__start(map) { 0, 0, 0 }
+#define Map_primitive__iterator__next(it, map) (it)->index++
+
+#define Map_char__iterator__start(map) Map_primitive__iterator__start(map)
+#define Map_bool__iterator__start(map) Map_primitive__iterator__start(map)
+#define Map_int32_t__iterator__start(map) Map_primitive__iterator__start(map)
+#define Map_int64_t__iterator__start(map) Map_primitive__iterator__start(map)
+#define Map_uint32_t__iterator__start(map) Map_primitive__iterator__start(map)
+#define Map_uint64_t__iterator__start(map) Map_primitive__iterator__start(map)
+
+#define Map_char__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+#define Map_bool__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+#define Map_int32_t__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+#define Map_int64_t__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+#define Map_uint32_t__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+#define Map_uint64_t__iterator__next(it, map) Map_primitive__iterator__next(it, map)
+
+#endif
@@ -0,0 +1,211 @@
+// Template
+// Implementation for PrimitiveMap(type)
+// @param type : The type of both the keys and values of the map
+//
+// The probing is the same as the Swiss engine of Map (see hashtable.template.c), over an array of (key, value) slots, and uses the same group probing functions (see hashtable.h).
+// The control byte of a slot identifies if it is full. Hashes are not cached, as hashing a primitive key is cheaper than reading a hash.
+
+// Local definitions
+// Undef'd at the end of this template
+#define PrimitiveMap_t CONCAT(Map_, type)
+#define PrimitiveMapSlot_t CONCAT(MapSlot_, type)
+
+#define PRIMITIVE_MAP_METHOD(name) CONCAT4(pm_, type, _, name)
+
+// The mixed hash of a key, see hash_mix()
+#define primitive_map_hash(key) hash_mix(hash(type, key))
+
+// Result(T) can't be inspected within this template, as it has a member named 'type'. So find() returns this index instead of Err()
+#define PRIMITIVE_MAP_NOT_FOUND UINT32_MAX
+
+// Private Methods
+
+// Allocates an empty slot array of a given size
+static void PRIMITIVE_MAP_METHOD(alloc)(PrimitiveMap_t map, uint32_t size)
+{
+    size = max(size, HASH_GROUP_WIDTH); // Must hold at least one complete group
+
+    map->slots = safe_malloc(sizeof(PrimitiveMapSlot_t) * size);
+    map->control = safe_malloc(sizeof(uint8_t) * size);
+    map->size = size;
+    map->length = 0;
+    map->tombstones = 0;
+
+    memset(map->control, HASH_CONTROL_EMPTY, size);
+}
+
+// Finds the index of a key with (mixed) hash h, or PRIMITIVE_MAP_NOT_FOUND if it is not present
+static uint32_t PRIMITIVE_MAP_METHOD(find)(PrimitiveMap_t map, type key, uint32_t h)
+{
+    uint8_t h2 = hash_h2(h);
+    for (HashGroupProbe probe = hash_group_probe(map->size, h);; hash_group_probe_next(&probe)) // The map must always have at least one empty slot, and the triangular sequence visits every group - so this is gaurenteed to terminate
+    {
+        const uint8_t* control = map->control + probe.index;
+        for (uint32_t match = hash_group_match(control, h2); match != 0; match &= match - 1)
+        {
+            uint32_t index = probe.index + __builtin_ctz(match);
+            if (map->slots[index].key == key)
+            {
+                return index; // Key match
+            }
+        }
+        if (hash_group_match_empty(control) != 0)
+        {
+            return PRIMITIVE_MAP_NOT_FOUND; // No match
+        }
+    }
+}
+
+// Places a key with (mixed) hash h, known to be absent from the map, in the first free slot of it's group probe sequence
+static void PRIMITIVE_MAP_METHOD(place)(PrimitiveMap_t map, type key, type value, uint32_t h)
+{
+    uint32_t index = hash_group_find_free(map->control, map->size, h);
+    if (map->control[index] == HASH_CONTROL_DELETED)
+    {
+        map->tombstones--;
+    }
+    map->control[index] = hash_h2(h);
+    map->slots[index].key = key;
+    map->slots[index].value = value;
+    map->length++;
+}
+
+// Resizes the map to a new size, which must be a power of two able to hold all current keys
+static void PRIMITIVE_MAP_METHOD(rehash)(PrimitiveMap_t map, uint32_t new_size)
+{
+    PrimitiveMapSlot_t* old_slots = map->slots;
+    uint8_t* old_control = map->control;
+    uint32_t old_size = map->size;
+
+    PRIMITIVE_MAP_METHOD(alloc)(map, new_size);
+
+    for (uint32_t index = 0; index < old_size; index++)
+    {
+        if (!(old_control[index] & HASH_CONTROL_EMPTY)) // Full slots have the high bit clear
+        {
+            PrimitiveMapSlot_t slot = old_slots[index];
+            PRIMITIVE_MAP_METHOD(place)(map, slot.key, slot.value, primitive_map_hash(slot.key));
+        }
+    }
+
+    free(old_slots);
+    free(old_control);
+}
+
+// Class Methods
+
+PrimitiveMap_t CONCAT(PrimitiveMap_t, __new)(uint32_t initial_size)
+{
+    PrimitiveMap_t map = class_malloc(PrimitiveMap_t);
+
+    map->load_factor = HASH_SWISS_LOAD_FACTOR;
+    PRIMITIVE_MAP_METHOD(alloc)(map, next_highest_power_of_two(initial_size));
+
+    return map;
+}
+
+void CONCAT(PrimitiveMap_t, __del)(PrimitiveMap_t map)
+{
+    free(map->slots);
+    free(map->control);
+    free(map);
+}
+
+String CONCAT(PrimitiveMap_t, __format)(PrimitiveMap_t map)
+{
+    String s = new(String, "PrimitiveMap<" LITERAL(type) ">{");
+    if (map->length == 0)
+    {
+        str_append_char(s, '}');
+        return s;
+    }
+    else
+    {
+        for iter(PrimitiveMap_t, it, map)
+        {
+            str_append_string(s, format(type, it.key));
+            str_append_slice(s, ": ");
+            str_append_string(s, format(type, it.value));
+            str_append_slice(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append_char(s, '}');
+    return s;
+}
+
+// Iterator
+
+bool CONCAT(PrimitiveMap_t, __iterator__test)(Iterator(PrimitiveMap_t)* it, PrimitiveMap_t map)
+{
+    for (;it->index < map->size; it->index++) // Don't iterate off the end of the map
+    {
+        if (!(map->control[it->index] & HASH_CONTROL_EMPTY)) // Stop at full slots
+        {
+            it->key = map->slots[it->index].key;
+            it->value = map->slots[it->index].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Instance Methods
+
+bool PRIMITIVE_MAP_METHOD(put)(PrimitiveMap_t map, type key, type value)
+{
+    uint32_t h = primitive_map_hash(key);
+    uint32_t index = PRIMITIVE_MAP_METHOD(find)(map, key, h);
+    if (index != PRIMITIVE_MAP_NOT_FOUND)
+    {
+        map->slots[index].value = value;
+        return true;
+    }
+
+    // In order to gaurentee proper function, the map must have always at least one empty slot
+    uint32_t threshold = (uint32_t) (map->load_factor * map->size);
+    if (map->length + map->tombstones + 1 >= threshold)
+    {
+        PRIMITIVE_MAP_METHOD(rehash)(map, hash_rehash_size(map->size, map->length, threshold));
+    }
+    PRIMITIVE_MAP_METHOD(place)(map, key, value, h);
+    return false;
+}
+
+bool PRIMITIVE_MAP_METHOD(contains_key)(PrimitiveMap_t map, type key)
+{
+    return PRIMITIVE_MAP_METHOD(find)(map, key, primitive_map_hash(key)) != PRIMITIVE_MAP_NOT_FOUND;
+}
+
+type PRIMITIVE_MAP_METHOD(get)(PrimitiveMap_t map, type key)
+{
+    uint32_t index = PRIMITIVE_MAP_METHOD(find)(map, key, primitive_map_hash(key));
+    return index != PRIMITIVE_MAP_NOT_FOUND ? map->slots[index].value : default_value(type);
+}
+
+bool PRIMITIVE_MAP_METHOD(remove)(PrimitiveMap_t map, type key)
+{
+    uint32_t index = PRIMITIVE_MAP_METHOD(find)(map, key, primitive_map_hash(key));
+    if (index == PRIMITIVE_MAP_NOT_FOUND)
+    {
+        return false;
+    }
+
+    map->tombstones += hash_group_erase(map->control, index);
+    map->length--;
+    return true;
+}
+
+void PRIMITIVE_MAP_METHOD(clear)(PrimitiveMap_t map)
+{
+    memset(map->control, HASH_CONTROL_EMPTY, map->size);
+    map->length = 0;
+    map->tombstones = 0;
+}
+
+#undef type
+#undef PrimitiveMap_t
+#undef PrimitiveMapSlot_t
+#undef PRIMITIVE_MAP_METHOD
+#undef primitive_map_hash
+#undef PRIMITIVE_MAP_NOT_FOUND
@@ -0,0 +1,53 @@
+// Template
+// Header for PrimitiveMap(type)
+// @param type : The type of both the keys and values of the map
+
+// Local definitions
+// Undef'd at the end of this template
+#define PrimitiveMap_t CONCAT(Map_, type)
+
+typedef struct
+{
+    type key;
+    type value;
+} CONCAT(MapSlot_, type);
+
+struct CONCAT3(Map_, type, __struct)
+{
+    CONCAT(MapSlot_, type)* slots; // Slot array
+    uint8_t* control; // Control bytes for each slot, as in the Swiss engine of Map. A slot is full if it's control byte is not EMPTY or DELETED
+    double load_factor; // The maximum ratio of (length + tombstones) to size before the slot array is resized. May be tuned before inserting
+    uint32_t size; // The length of the slot array. Must be a power of 2, and at least HASH_GROUP_WIDTH
+    uint32_t tombstones; // The number of DELETED slots
+    uint32_t length; // The number of entries
+};
+
+typedef struct CONCAT3(Map_, type, __struct) * PrimitiveMap_t;
+
+// This is a pseudo class, like Map
+// It can be used with new(), del(), and format()
+declare_constructor(PrimitiveMap_t, uint32_t initial_size);
+
+void CONCAT(PrimitiveMap_t, __del)(PrimitiveMap_t map);
+String CONCAT(PrimitiveMap_t, __format)(PrimitiveMap_t map);
+
+// Iterator
+typedef struct
+{
+    uint32_t index;
+    type key;
+    type value;
+} Iterator(PrimitiveMap_t);
+
+bool CONCAT(PrimitiveMap_t, __iterator__test)(Iterator(PrimitiveMap_t)* it, PrimitiveMap_t map);
+
+// Instance Methods
+bool CONCAT3(pm_, type, _put)(PrimitiveMap_t map, type key, type value);
+bool CONCAT3(pm_, type, _contains_key)(PrimitiveMap_t map, type key);
+type CONCAT3(pm_, type, _get)(PrimitiveMap_t map, type key);
+bool CONCAT3(pm_, type, _remove)(PrimitiveMap_t map, type key);
+
+void CONCAT3(pm_, type, _clear)(PrimitiveMap_t map);
+
+#undef type
+#undef PrimitiveMap_t
@@ -0,0 +1,200 @@
+#include "rcumap.h"
+
+// Private Methods
+
+static Map rmap_snapshot_copy(Map writer);
+static void rmap_snapshot_free(Map snapshot);
+static void rmap_retire(RcuMap map, pointer_t instance, Class cls);
+static void rmap_reclaim(RcuMap map, bool all);
+
+
+// The name is parenthesized, as RcuMap__new() is also a macro supplying the default options
+RcuMap (RcuMap__new)(uint32_t initial_size, Class key_class, Class value_class, HashOptions options)
+{
+    RcuMap map = class_malloc(RcuMap);
+
+    map->writer = new(Map, initial_size, key_class, value_class, options & ~(HASH_INCREMENTAL | HASH_BLOOM)); // Snapshots are copies of the writer, and readers must not modify them. A snapshot must be a complete table, without a previous table mid-migration, and a lookup in a map with a Bloom filter counts it
+    atomic_init(&map->snapshot, rmap_snapshot_copy(map->writer));
+    atomic_init(&map->epoch, 1);
+    for (uint32_t i = 0; i < RCU_MAP_MAX_READERS; i++)
+    {
+        atomic_init(&map->readers[i].epoch, 0);
+        atomic_init(&map->readers[i].registered, false);
+    }
+    map->retired = NULL;
+    map->retired_length = 0;
+    map->retired_size = 0;
+
+    return map;
+}
+
+void RcuMap__del(RcuMap map)
+{
+    rmap_reclaim(map, true);
+    rmap_snapshot_free(atomic_load(&map->snapshot));
+    del(Map, map->writer);
+    free(map->retired);
+    free(map);
+}
+
+String RcuMap__format(RcuMap map)
+{
+    String s = new(String, "Rcu");
+    str_append(s, format(Map, atomic_load(&map->snapshot))); // Consumes the formatted snapshot
+    return s;
+}
+
+
+// Reader Methods
+
+uint32_t rmap_register(RcuMap map)
+{
+    for (uint32_t i = 0; i < RCU_MAP_MAX_READERS; i++)
+    {
+        bool registered = false;
+        if (atomic_compare_exchange_strong(&map->readers[i].registered, &registered, true))
+        {
+            return i;
+        }
+    }
+    panic("Too many readers: maximum = %d", RCU_MAP_MAX_READERS);
+    return 0;
+}
+
+void rmap_unregister(RcuMap map, uint32_t reader)
+{
+    atomic_store(&map->readers[reader].registered, false);
+}
+
+// A reader announces the epoch it started reading in, before it loads the snapshot.
+// The writer retires the previous snapshot after publishing the next, and increments the epoch, so a reader which announces a later epoch can only see a later snapshot.
+Map rmap_read_begin(RcuMap map, uint32_t reader)
+{
+    atomic_store(&map->readers[reader].epoch, atomic_load(&map->epoch));
+    return atomic_load(&map->snapshot);
+}
+
+void rmap_read_end(RcuMap map, uint32_t reader)
+{
+    atomic_store_explicit(&map->readers[reader].epoch, 0, memory_order_release);
+}
+
+pointer_t rmap_get(RcuMap map, uint32_t reader, pointer_t key)
+{
+    Map snapshot = rmap_read_begin(map, reader);
+    pointer_t value = map_get(snapshot, key);
+    value = value != NULL ? copy_c(snapshot->value_class, value) : NULL; // Copy before the value may be reclaimed
+    rmap_read_end(map, reader);
+    return value;
+}
+
+
+// Writer Methods
+
+bool rmap_put(RcuMap map, pointer_t key, pointer_t value)
+{
+    MapEntry entry = map_entry(map->writer, key);
+    if (entry.occupied)
+    {
+        // The current snapshot may contain the previous value, so it is retired rather than deleted. The stored key is kept, and the queried key was never published
+        pointer_t* current = map_entry_value(&entry);
+        rmap_retire(map, *current, map->writer->value_class);
+        *current = value;
+        del_c(map->writer->key_class, key);
+        return true;
+    }
+    map_entry_insert(&entry, value);
+    return false;
+}
+
+bool rmap_remove(RcuMap map, pointer_t key)
+{
+    pointer_t removed_key, removed_value;
+    if (map_remove(map->writer, key, &removed_key, &removed_value))
+    {
+        rmap_retire(map, removed_key, map->writer->key_class);
+        rmap_retire(map, removed_value, map->writer->value_class);
+        return true;
+    }
+    return false;
+}
+
+void rmap_publish(RcuMap map)
+{
+    Map previous = atomic_exchange(&map->snapshot, rmap_snapshot_copy(map->writer));
+    rmap_retire(map, previous, NULL);
+    atomic_fetch_add(&map->epoch, 1);
+    rmap_reclaim(map, false);
+}
+
+
+// Private Methods
+
+// Copies the backing arrays of the writer's map into a new snapshot. Keys and values are shared with the writer
+static Map rmap_snapshot_copy(Map writer)
+{
+    Map snapshot = class_malloc(Map);
+    *snapshot = *writer;
+    snapshot->slots = safe_malloc(sizeof(MapSlot) * writer->size);
+    memcpy(snapshot->slots, writer->slots, sizeof(MapSlot) * writer->size);
+    if (writer->control != NULL)
+    {
+        snapshot->control = safe_malloc(sizeof(uint8_t) * writer->size);
+        memcpy(snapshot->control, writer->control, sizeof(uint8_t) * writer->size);
+    }
+    return snapshot;
+}
+
+// Frees the arrays of a snapshot, but not any keys or values
+static void rmap_snapshot_free(Map snapshot)
+{
+    free(snapshot->slots);
+    free(snapshot->control);
+    free(snapshot);
+}
+
+static void rmap_retire(RcuMap map, pointer_t instance, Class cls)
+{
+    if (instance == NULL)
+    {
+        return;
+    }
+    if (map->retired_length == map->retired_size)
+    {
+        map->retired_size = max(map->retired_size * 2, 16u);
+        safe_realloc(map->retired, sizeof(RcuMapRetired) * map->retired_size);
+    }
+    map->retired[map->retired_length++] = (RcuMapRetired) { instance, cls, atomic_load(&map->epoch) };
+}
+
+// Reclaims all retired objects which no reader can be using. An object retired at an epoch is still in use if the epoch has not been incremented since (so it is in the current snapshot), or if any reader started reading at or before that epoch.
+// If all is true, reclaims everything, which is only safe if there are no readers.
+static void rmap_reclaim(RcuMap map, bool all)
+{
+    uint64_t safe_epoch = atomic_load(&map->epoch); // Objects retired before this epoch can be reclaimed
+    for (uint32_t i = 0; i < RCU_MAP_MAX_READERS; i++)
+    {
+        uint64_t reader_epoch = atomic_load(&map->readers[i].epoch);
+        if (reader_epoch != 0)
+        {
+            safe_epoch = min(safe_epoch, reader_epoch);
+        }
+    }
+
+    // Retired objects are in order of their epoch, so reclaim a prefix, and shift the remainder back
+    uint32_t reclaimed = 0;
+    for (; reclaimed < map->retired_length && (all || map->retired[reclaimed].epoch < safe_epoch); reclaimed++)
+    {
+        RcuMapRetired* retired = &map->retired[reclaimed];
+        if (retired->cls == NULL)
+        {
+            rmap_snapshot_free(retired->instance);
+        }
+        else
+        {
+            del_c(retired->cls, retired->instance);
+        }
+    }
+    memmove(map->retired, map->retired + reclaimed, sizeof(RcuMapRetired) * (map->retired_length - reclaimed));
+    map->retired_length -= reclaimed;
+}
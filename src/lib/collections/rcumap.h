@@ -0,0 +1,90 @@
+// A Hash Map for one writer and many readers, where readers never lock
+// Readers see an immutable snapshot of the map, which is an ordinary Map, and can be queried with map_get(), map_contains_key(), and iterated as usual.
+// The writer modifies it's own private Map, and publishes a copy of it as a new snapshot atomically.
+// Snapshots, and any keys and values replaced or removed by the writer, are reclaimed once no reader can still be using them, using epoch based reclamation.
+
+#include "../lib.h"
+#include "hashtable.h"
+#include "map.h"
+
+#include <stdatomic.h>
+
+#ifndef COLLECTIONS_RCU_MAP_H
+#define COLLECTIONS_RCU_MAP_H
+
+// The maximum number of readers which may be registered at once
+#define RCU_MAP_MAX_READERS 64
+
+typedef struct
+{
+    _Alignas(64) _Atomic(uint64_t) epoch; // The global epoch when the reader started reading, or 0 if it is not reading
+    _Atomic(bool) registered; // If this reader slot is in use
+} RcuMapReader;
+
+typedef struct
+{
+    pointer_t instance; // The retired snapshot, key or value
+    Class cls; // The class of the instance, used to delete it. NULL for a snapshot, which only frees it's arrays
+    uint64_t epoch; // The global epoch when it was retired. It can be reclaimed once no reader started reading at or before this epoch
+} RcuMapRetired;
+
+struct RcuMap__struct
+{
+    _Atomic(Map) snapshot; // The current snapshot, read by readers
+    Map writer; // The writer's map, which owns all keys and values
+    _Atomic(uint64_t) epoch; // The global epoch, which starts at 1, and is incremented by each publish
+    RcuMapReader readers[RCU_MAP_MAX_READERS];
+    RcuMapRetired* retired; // Retired objects, in order of their epoch
+    uint32_t retired_length;
+    uint32_t retired_size;
+};
+
+typedef struct RcuMap__struct * RcuMap;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+// Neither del() nor format() are thread safe. format() formats the current snapshot
+
+// The options are passed to the writer's Map. Snapshots are never resized, so HASH_INCREMENTAL is ignored. Readers must not modify a snapshot, so HASH_BLOOM (which counts lookups) is also ignored
+declare_constructor(RcuMap, uint32_t initial_size, Class key_class, Class value_class, HashOptions options);
+
+// The options are optional, new(RcuMap, initial_size, key_class, value_class) will use HASH_DEFAULT
+#define RcuMap__new(initial_size, key_class, value_class, options...) RcuMap__new(initial_size, key_class, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
+void RcuMap__del(RcuMap map);
+String RcuMap__format(RcuMap map);
+
+
+// Reader Methods - these are thread safe, and never lock
+
+// Registers a new reader, and returns it's id. Each reading thread should register once, and use it's id for all reads
+uint32_t rmap_register(RcuMap map);
+
+// Unregisters a reader. The reader must not be reading
+void rmap_unregister(RcuMap map, uint32_t reader);
+
+// Starts reading, and returns the current snapshot. The snapshot, and all keys and values in it, are borrowed, and valid until rmap_read_end().
+// The snapshot must not be modified.
+Map rmap_read_begin(RcuMap map, uint32_t reader);
+
+// Stops reading. Any snapshot returned by rmap_read_begin() must not be used after this
+void rmap_read_end(RcuMap map, uint32_t reader);
+
+// Gets a copy of the value associated to a key in the current snapshot, or NULL if there was none. The returned value is owned by the caller.
+pointer_t rmap_get(RcuMap map, uint32_t reader, pointer_t key);
+
+
+// Writer Methods - these must only be called by a single writer thread
+// Changes are only seen by readers once published
+
+// Puts a (key, value) pair into the writer's map. Ownership of both the key and value is given to the map. Returns true if the key was already in the map
+bool rmap_put(RcuMap map, pointer_t key, pointer_t value);
+
+// Removes a key from the writer's map. Returns true if the key was present
+bool rmap_remove(RcuMap map, pointer_t key);
+
+// Publishes a copy of the writer's map as the new snapshot, and reclaims any retired objects which are no longer in use by readers.
+void rmap_publish(RcuMap map);
+
+#endif
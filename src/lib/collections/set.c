@@ -1,36 +1,56 @@
 #include "set.h"
 
-#define LOAD_FACTOR 0.75
+// Probing engines
+#define HashTable Set, set, values, value_class, 0, 0
+#include "hashtable.template.c"
 
 // Private Methods
 
-static void set_rehash(Set set);
+static String set_stats_name(Set set);
 
-Set Set__new(uint32_t initial_size, Class value_class)
+
+// The name is parenthesized, as Set__new() is also a macro supplying the default options
+Set (Set__new)(uint32_t initial_size, Class value_class, HashOptions options)
 {
     initial_size = next_highest_power_of_two(initial_size);
     Set set = class_malloc(Set);
 
-    set->values = safe_malloc(sizeof(pointer_t) * initial_size);
     set->value_class = value_class;
-    set->size = initial_size;
-    set->length = 0;
+    set->options = options;
+    set->seed = options & HASH_SEEDED ? hash_random_seed() : 0;
+    set->load_factor = hash_load_factor(options);
+    set->previous = NULL;
+    set->migrated = 0;
+    set->bloom = NULL;
+    set->bloom_blocks = 0;
+    set->bloom_lookups = 0;
+    set->bloom_rejected = 0;
+    set->bloom_false_positives = 0;
+    set->rehashes = 0;
+    set_alloc(set, initial_size);
+    set_bloom_alloc(set);
+    set->stats_id = hash_stats_register(set, (FnHashStatsName) &set_stats_name, (FnHashStats) &set_stats);
 
-    for (uint32_t i = 0; i < initial_size; i++)
-    {
-        set->values[i] = NULL;
-    }
+    return set;
+}
 
+// The name is parenthesized, as set_from_array() is also a macro supplying the default options
+Set (set_from_array)(uint32_t length, pointer_t* values, Class value_class, HashOptions options)
+{
+    Set set = new(Set, 16, value_class, options);
+    set_put_all(set, length, values);
     return set;
 }
 
 void Set__del(Set set)
 {
+    hash_stats_unregister(set->stats_id);
     for iter(Set, it, set)
     {
         del_c(set->value_class, it.value);
     }
-    free(set->values);
+    set_free(set);
+    free(set->bloom);
     free(set);
 }
 
@@ -60,11 +80,13 @@ String Set__format(Set set)
 
 // Iterator
 
+// During an incremental resize, indices past the end of the set continue into the previous set
 bool Set__iterator__test(Iterator(Set)* it, Set set)
 {
-    for (;it->index < set->size; it->index++) // Don't iterate off the end of the set
+    uint32_t end = set->size + (set->previous != NULL ? set->previous->size : 0);
+    for (;it->index < end; it->index++) // Don't iterate off the end of the set
     {
-        pointer_t value = set->values[it->index]; // Stop at valid locations
+        pointer_t value = it->index < set->size ? set->values[it->index] : set->previous->values[it->index - set->size]; // Stop at valid locations
         if (value != NULL)
         {
             it->value = value;
@@ -76,105 +98,326 @@ bool Set__iterator__test(Iterator(Set)* it, Set set)
 
 
 // Instance Methods
+// The names of methods which also accept a SmallSet are parenthesized, as they are also macros, see smallset.h
 
-bool set_put(Set set, pointer_t value)
+bool (set_put)(Set set, pointer_t value)
 {
     panic_if_null(value, "Null Pointer: Set value must not be null");
 
-    // In order to gaurentee proper set function, the set must have always at least one empty entry
-    // This means we need to re-hash the set when inserting at specific sizes
-    if (set->length + 1 >= (uint32_t) (LOAD_FACTOR * set->size))
+    set_reserve_one(set);
+    return set_insert(set, value, NULL);
+}
+
+bool (set_contains)(Set set, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: Set value must not be null.");
+
+    return is_ok(set_find(set, value));
+}
+
+bool (set_remove)(Set set, pointer_t value, pointer_t* removed_value)
+{
+    panic_if_null(value, "Null Pointer: Set value must not be null.");
+
+    return set_remove_key(set, value, removed_value, NULL);
+}
+
+void (set_clear)(Set set)
+{
+    set_remove_all(set);
+}
+
+void set_reserve(Set set, uint32_t length)
+{
+    set_reserve_all(set, length);
+}
+
+void set_put_all(Set set, uint32_t length, pointer_t* values)
+{
+    set_insert_all(set, length, values, NULL);
+}
+
+HashBloomStats set_bloom_stats(Set set)
+{
+    return set_bloom_report(set);
+}
+
+HashStats set_stats(Set set)
+{
+    return set_stats_report(set);
+}
+
+
+// Set Algebra
+
+static uint32_t set_hash_from(Set set, Set source, pointer_t value, uint32_t h);
+static bool set_next_hashed(Set* table, uint32_t* index, pointer_t* value, uint32_t* h);
+static void set_place_copy(Set set, Set source, pointer_t value, uint32_t h);
+static void set_remove_matching(Set set, Set other, bool contained);
+static Set set_new_like(Set set, uint32_t length);
+
+void set_union(Set set, Set other)
+{
+    panic_if(set->value_class != other->value_class, "Set classes must match");
+    if (set == other)
     {
-        set_rehash(set);
+        return;
     }
 
-    uint32_t mask = (set->size - 1);
-    uint32_t index = hash_c(set->value_class, value) & mask;
-    pointer_t current_value = set->values[index];
+    set_reserve_all(set, max(set->length, other->length));
 
-    while (current_value != NULL)
+    Set table = other;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
     {
-        // Test current value
-        if (equals_c(set->value_class, current_value, value))
+        // Reserve space before probing, as resizing (or migrating) would move the slot that is probed
+        set_reserve_one(set);
+
+        uint32_t set_h = set_hash_from(set, other, value, h), set_index, distance;
+        if (!set_probe(set, value, set_h, &set_index, &distance))
         {
-            // Value match. Replace the value at this index.
-            // Delete the original value, keep the queried value intact. Ownership is given to the set (but borrowed in return)
-            del_c(set->value_class, set->values[index]);
-            set->values[index] = value;
-            return true; // Previous value found
+            set_fill(set, copy_c(set->value_class, value), NULL, set_h, set_index, distance);
         }
-        index = (index + 1) & mask;
-        current_value = set->values[index];
     }
-    // Found a null value position before a match, there was no matching element
-    set->values[index] = value;
-    set->length++;
-    return false;
 }
 
-bool set_contains(Set set, pointer_t value)
+void set_intersect(Set set, Set other)
 {
-    panic_if_null(value, "Null Pointer: Set value must not be null.");
+    panic_if(set->value_class != other->value_class, "Set classes must match");
+    if (set == other)
+    {
+        return;
+    }
 
-    uint32_t mask = (set->size - 1);
-    uint32_t index = hash_c(set->value_class, value) & mask;
-    pointer_t current_value = set->values[index];
-    
-    while (current_value != NULL) // The set must always have at least one empty spot - so this is gaurenteed to terminate
+    if (other->length < set->length)
     {
-        // Test current value
-        if (equals_c(set->value_class, current_value, value))
+        // Take the values of set which are in other, by iterating other, then clear set and put them back
+        // Clearing still visits each slot of set, but the larger set is never probed
+        pointer_t* kept = safe_malloc(sizeof(pointer_t) * max(other->length, 1u));
+        uint32_t* kept_hashes = safe_malloc(sizeof(uint32_t) * max(other->length, 1u));
+        uint32_t length = 0;
+
+        Set table = other;
+        pointer_t value;
+        uint32_t h;
+        for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
+        {
+            uint32_t set_h = set_hash_from(set, other, value, h);
+            if (set_remove_key_hashed(set, value, set_h, &kept[length], NULL))
+            {
+                kept_hashes[length++] = set_h;
+            }
+        }
+
+        set_remove_all(set);
+        for (uint32_t i = 0; i < length; i++)
         {
-            return true; // Value match
+            set_place_key(set, kept[i], NULL, kept_hashes[i]);
         }
-        index = (index + 1) & mask;
-        current_value = set->values[index];
+        set->length = length;
+
+        free(kept);
+        free(kept_hashes);
+    }
+    else
+    {
+        set_remove_matching(set, other, false);
     }
-    return false; // No match
 }
 
-void set_clear(Set set)
+void set_difference(Set set, Set other)
 {
-    for iter(Set, it, set)
+    panic_if(set->value_class != other->value_class, "Set classes must match");
+    if (set == other)
     {
-        del_c(set->value_class, it.value);
-        set->values[it.index] = NULL;
+        set_remove_all(set);
+        return;
+    }
+
+    if (other->length < set->length)
+    {
+        // Remove each value of other from set directly
+        Set table = other;
+        pointer_t value;
+        uint32_t h;
+        for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
+        {
+            set_remove_key_hashed(set, value, set_hash_from(set, other, value, h), NULL, NULL);
+        }
+    }
+    else
+    {
+        set_remove_matching(set, other, true);
     }
-    set->length = 0;
 }
 
+bool set_is_subset(Set set, Set other)
+{
+    panic_if(set->value_class != other->value_class, "Set classes must match");
+    if (set == other)
+    {
+        return true;
+    }
+    if (set->length > other->length)
+    {
+        return false;
+    }
 
-// Private Methods
+    Set table = set;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
+    {
+        if (is_err(set_find_hashed(other, value, set_hash_from(other, set, value, h))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-static void set_rehash(Set set)
+Set set_union_new(Set set, Set other)
 {
-    // Save a reference to the existing values array
-    pointer_t* old_values = set->values;
-    uint32_t old_size = set->size;
-    uint32_t new_size = old_size << 1;
+    panic_if(set->value_class != other->value_class, "Set classes must match");
 
-    // Reallocate the new array
-    set->values = safe_malloc(sizeof(pointer_t) * new_size);
+    // Copy the larger set, whose values are known to be distinct, without probing for them, and then add the smaller set
+    Set larger = set->length >= other->length ? set : other, smaller = larger == set ? other : set;
+    Set result = set_new_like(set, larger->length);
 
-    for (uint32_t i = 0; i < new_size; i++)
+    Set table = larger;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
     {
-        set->values[i] = NULL;
+        set_place_copy(result, larger, value, h);
     }
+    set_union(result, smaller);
+    return result;
+}
+
+Set set_intersect_new(Set set, Set other)
+{
+    panic_if(set->value_class != other->value_class, "Set classes must match");
 
-    // Set the set to empty
-    set->size = new_size;
-    set->length = 0;
+    Set smaller = set->length <= other->length ? set : other, larger = smaller == set ? other : set;
+    Set result = set_new_like(set, smaller->length);
 
-    // Insert all old values
-    for (uint32_t index = 0; index < old_size; index++)
+    Set table = smaller;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
     {
-        pointer_t old_value = old_values[index];
-        if (old_value != NULL)
+        if (smaller == larger || is_ok(set_find_hashed(larger, value, set_hash_from(larger, smaller, value, h))))
         {
-            set_put(set, old_value);
+            set_place_copy(result, smaller, value, h);
         }
     }
+    return result;
+}
+
+Set set_difference_new(Set set, Set other)
+{
+    panic_if(set->value_class != other->value_class, "Set classes must match");
 
-    // Free now-unused old values array
-    free(old_values);
-}
\ No newline at end of file
+    Set result = set_new_like(set, set == other ? 0 : set->length);
+    if (set == other)
+    {
+        return result;
+    }
+
+    Set table = set;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
+    {
+        if (is_err(set_find_hashed(other, value, set_hash_from(other, set, value, h))))
+        {
+            set_place_copy(result, set, value, h);
+        }
+    }
+    return result;
+}
+
+
+// Private Methods
+
+// Converts the cached hash h of a value in source, to the hash of the value as stored in set.
+// Tables with the same kind of hash, and the same seed, share it. A mixed hash is computed from a plain one (which is the class hash), but the reverse, or between seeds, needs the value to be hashed again.
+static uint32_t set_hash_from(Set set, Set source, pointer_t value, uint32_t h)
+{
+    bool mixed = set_mixed(set), source_mixed = set_mixed(source);
+    if (mixed == source_mixed && set->seed == source->seed)
+    {
+        return h;
+    }
+    return mixed && !source_mixed ? set_stored_hash(set, h) : set_hash(set, value);
+}
+
+// Iterates the values of a set, and their cached hashes, including any in a previous set during an incremental resize
+// table must start as the set, and index at 0, and index must be incremented after each value
+static bool set_next_hashed(Set* table, uint32_t* index, pointer_t* value, uint32_t* h)
+{
+    for (; *table != NULL; *table = (*table)->previous, *index = 0)
+    {
+        for (; *index < (*table)->size; (*index)++)
+        {
+            if ((*table)->values[*index] != NULL)
+            {
+                *value = (*table)->values[*index];
+                *h = (*table)->hashes[*index];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Places a copy of a value from source, known to be absent from set. set must have space for it
+static void set_place_copy(Set set, Set source, pointer_t value, uint32_t h)
+{
+    set_place_key(set, copy_c(set->value_class, value), NULL, set_hash_from(set, source, value, h));
+    set->length++;
+}
+
+// Removes every value from set which is (or is not) in other, by iterating set and probing other
+// Values are removed after iterating, as removing shifts values within set
+static void set_remove_matching(Set set, Set other, bool contained)
+{
+    pointer_t* removed = safe_malloc(sizeof(pointer_t) * max(set->length, 1u));
+    uint32_t* removed_hashes = safe_malloc(sizeof(uint32_t) * max(set->length, 1u));
+    uint32_t length = 0;
+
+    Set table = set;
+    pointer_t value;
+    uint32_t h;
+    for (uint32_t index = 0; set_next_hashed(&table, &index, &value, &h); index++)
+    {
+        if (is_ok(set_find_hashed(other, value, set_hash_from(other, set, value, h))) == contained)
+        {
+            removed[length] = value;
+            removed_hashes[length++] = h;
+        }
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        set_remove_key_hashed(set, removed[i], removed_hashes[i], NULL, NULL); // The value is used as the query, until it is deleted
+    }
+
+    free(removed);
+    free(removed_hashes);
+}
+
+// Creates an empty set with the class and options of set, sized to hold length values without resizing
+static Set set_new_like(Set set, uint32_t length)
+{
+    Set result = new(Set, 16, set->value_class, set->options);
+    set_reserve_all(result, length);
+    return result;
+}
+
+// The name the set is reported with, with HASH_STATS
+static String set_stats_name(Set set)
+{
+    return str_format("Set<%s>", set->value_class->name);
+}
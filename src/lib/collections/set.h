@@ -3,6 +3,7 @@
 // Cannot contain NULL values
 
 #include "../lib.h"
+#include "hashtable.h"
 
 #ifndef COLLECTIONS_SET_H
 #define COLLECTIONS_SET_H
@@ -10,9 +11,26 @@
 struct Set__struct
 {
     pointer_t* values; // Value array
+    uint32_t* hashes; // The cached hash of each value. For the Swiss engine, or with a seed, this is the mixed hash
+    uint8_t* control; // Control bytes for each slot. Only used by the Swiss engine
+    struct Set__struct* previous; // During an incremental resize, the set being migrated from. NULL otherwise
+    uint32_t migrated; // During an incremental resize, the index in the previous set up to which all keys have been migrated
+    uint32_t* filled; // With HASH_REUSABLE, the index of each slot filled since the last clear, possibly repeated. NULL otherwise
+    uint32_t filled_length; // The number of indices in the filled log, or UINT32_MAX if more slots were filled than the log can hold
+    uint64_t* bloom; // With HASH_BLOOM, the Bloom filter of keys, shared with any previous set. NULL otherwise
+    uint32_t bloom_blocks; // The number of blocks in the Bloom filter. A power of 2
+    uint64_t bloom_lookups; // The number of lookups which checked the Bloom filter
+    uint64_t bloom_rejected; // The number of lookups which the Bloom filter answered as missing
+    uint64_t bloom_false_positives; // The number of lookups which passed the Bloom filter, but were missing
+    uint32_t rehashes; // The number of times the backing arrays were replaced, by a resize, or a rehash to clear tombstones
+    uint32_t stats_id; // With HASH_STATS set in the environment, the set's entry in the stats registry. UINT32_MAX otherwise
     Class value_class; // The value class
+    HashOptions options; // The options this set was created with
+    uint32_t seed; // With HASH_SEEDED, a random seed which is mixed into the hash of every key, so each set places keys differently. 0 otherwise. May be set before inserting
+    double load_factor; // The maximum ratio of length to size before the backing array is resized. May be tuned before inserting
     uint32_t size; // The length of the backing array. Must be a power of 2
-    uint32_t length; // The number of entries
+    uint32_t tombstones; // The number of DELETED slots. Only used by the Swiss engine
+    uint32_t length; // The number of entries, including those not yet migrated from a previous set
 };
 
 typedef struct Set__struct * Set;
@@ -21,11 +39,21 @@ typedef struct Set__struct * Set;
 // It does not have a Class<T> object, nor implement all methods of the class
 // However, it can still be used with new(), del(), and format()
 
-declare_constructor(Set, uint32_t initial_size, Class value_class);
+declare_constructor(Set, uint32_t initial_size, Class value_class, HashOptions options);
+
+// The options are optional, new(Set, initial_size, value_class) will use HASH_DEFAULT
+#define Set__new(initial_size, value_class, options...) Set__new(initial_size, value_class, ARG_2(~, ## options, HASH_DEFAULT))
 
 void Set__del(Set set);
 String Set__format(Set set);
 
+// Creates a set from an array of values, sized once to hold all of them. Ownership of every value is given to the set, but the array itself is borrowed.
+// If any values are equal, the last is kept, as with set_put(). Above HASH_PARALLEL_THRESHOLD values, they are hashed and placed using multiple threads.
+Set set_from_array(uint32_t length, pointer_t* values, Class value_class, HashOptions options);
+
+// The options are optional, as with new(Set, ...)
+#define set_from_array(length, values, value_class, options...) set_from_array(length, values, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
 // Iterator
 // test() is defined as a function in order to skip otherwise empty entries
 // We still increment during next() (but do not assign key/value) in order to assign *after* the test passes, and avoid running off the end of the array.
@@ -51,7 +79,51 @@ bool set_put(Set set, pointer_t value);
 // Checks if a value is present in the set.
 bool set_contains(Set set, pointer_t value);
 
-// Clears the set
+// Removes a value from the set. Returns true if the value was present.
+// Ownership of the value stored in the set is given to the caller, through removed_value. If it is NULL, the value is deleted instead.
+// The queried value is only borrowed, and may be a different (but equal) instance to the removed value.
+bool set_remove(Set set, pointer_t value, pointer_t* removed_value);
+
+// Clears the set. With HASH_REUSABLE, this only visits the slots filled since the last clear
 void set_clear(Set set);
 
+// Grows the set, if needed, so it can hold a total of length values without resizing again. In incremental mode, this resizes immediately.
+void set_reserve(Set set, uint32_t length);
+
+// Puts each value from an array into the set, as with set_put(), resizing at most once. Ownership of every value is given to the set, but the array itself is borrowed.
+void set_put_all(Set set, uint32_t length, pointer_t* values);
+
+// Gets the counts of lookups answered by the Bloom filter, with HASH_BLOOM, and the filter's false positive rate: the fraction of lookups of missing keys which it did not answer. Without HASH_BLOOM, every count is zero.
+HashBloomStats set_bloom_stats(Set set);
+
+// Gets the size, load, probe lengths and clustering of the set, see HashStats. Visits every slot.
+HashStats set_stats(Set set);
+
+
+// Set Algebra
+// Each operation iterates the smaller set where it can, and probes the other with the cached hash of each value, so values are only hashed again when the two sets store different kinds of hash, or have different seeds.
+// Both sets must have the same value class. The other set is borrowed, and values taken from it are copied with copy(), so it is unchanged.
+// The in place operations modify set, deleting any values they remove. The other variants return a new set, with the options of the first set, which holds copies of it's values.
+
+// Puts a copy of every value in other which is not already in set. Values already in set are kept
+void set_union(Set set, Set other);
+
+// Removes every value in set which is not in other
+void set_intersect(Set set, Set other);
+
+// Removes every value in set which is in other
+void set_difference(Set set, Set other);
+
+// Checks if every value in set is in other
+bool set_is_subset(Set set, Set other);
+
+// Returns a new set of every value in either set
+Set set_union_new(Set set, Set other);
+
+// Returns a new set of every value in both sets
+Set set_intersect_new(Set set, Set other);
+
+// Returns a new set of every value in set, which is not in other
+Set set_difference_new(Set set, Set other);
+
 #endif
\ No newline at end of file
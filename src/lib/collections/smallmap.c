@@ -0,0 +1,224 @@
+#include "smallmap.h"
+
+// Private Methods
+
+static bool smap_large(SmallMap map);
+static int32_t smap_find(SmallMap map, pointer_t key);
+
+
+// The name is parenthesized, as SmallMap__new() is also a macro supplying the default options
+SmallMap (SmallMap__new)(uint32_t initial_size, Class key_class, Class value_class, HashOptions options)
+{
+    SmallMap map = class_malloc(SmallMap);
+
+    map->map = NULL;
+    map->key_class = key_class;
+    map->value_class = value_class;
+    map->initial_size = initial_size;
+    map->options = options;
+    map->length = 0;
+
+    return map;
+}
+
+void SmallMap__del(SmallMap map)
+{
+    for (uint32_t i = 0; i < map->length; i++)
+    {
+        del_c(map->key_class, map->keys[i]);
+        del_c(map->value_class, map->values[i]);
+    }
+    if (map->map != NULL)
+    {
+        del(Map, map->map);
+    }
+    free(map);
+}
+
+String SmallMap__format(SmallMap map)
+{
+    String s = new(String, "SmallMap<");
+    str_append(s, map->key_class->name);
+    str_append(s, ", ");
+    str_append(s, map->value_class->name);
+    str_append(s, ">{");
+    if (map->length == 0 && !smap_large(map))
+    {
+        str_append(s, "}");
+        return s;
+    }
+    else
+    {
+        for iter(SmallMap, it, map)
+        {
+            str_append(s, format_c(map->key_class, it.key));
+            str_append(s, ": ");
+            str_append(s, format_c(map->value_class, it.value));
+            str_append(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append(s, "}");
+    return s;
+}
+
+
+// Iterator
+
+bool SmallMap__iterator__test(Iterator(SmallMap)* it, SmallMap map)
+{
+    if (smap_large(map))
+    {
+        Iterator(Map) map_it = { it->index, NULL, NULL };
+        bool valid = Map__iterator__test(&map_it, map->map);
+        it->index = map_it.index;
+        it->key = map_it.key;
+        it->value = map_it.value;
+        return valid;
+    }
+    if (it->index < map->length)
+    {
+        it->key = map->keys[it->index];
+        it->value = map->values[it->index];
+        return true;
+    }
+    return false;
+}
+
+
+// Instance Methods
+
+bool smap_put(SmallMap map, pointer_t key, pointer_t value)
+{
+    panic_if_null(key, "Null Pointer: SmallMap key must not be null");
+
+    if (smap_large(map))
+    {
+        return map_put(map->map, key, value);
+    }
+
+    int32_t index = smap_find(map, key);
+    if (index != -1)
+    {
+        // Replace the key and value, as with map_put()
+        del_c(map->key_class, map->keys[index]);
+        del_c(map->value_class, map->values[index]);
+        map->keys[index] = key;
+        map->values[index] = value;
+        return true;
+    }
+
+    if (map->length == SMALL_MAP_INLINE)
+    {
+        // Outgrown the inline entries, so move them into the Map
+        if (map->map == NULL)
+        {
+            map->map = new(Map, map->initial_size, map->key_class, map->value_class, map->options);
+        }
+        map_put_all(map->map, map->length, map->keys, map->values);
+        map->length = 0;
+        return map_put(map->map, key, value);
+    }
+
+    map->keys[map->length] = key;
+    map->values[map->length] = value;
+    map->length++;
+    return false;
+}
+
+bool smap_contains_key(SmallMap map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: SmallMap key must not be null");
+
+    if (smap_large(map))
+    {
+        return map_contains_key(map->map, key);
+    }
+    return smap_find(map, key) != -1;
+}
+
+pointer_t smap_get(SmallMap map, pointer_t key)
+{
+    panic_if_null(key, "Null Pointer: SmallMap key must not be null");
+
+    if (smap_large(map))
+    {
+        return map_get(map->map, key);
+    }
+    int32_t index = smap_find(map, key);
+    return index != -1 ? map->values[index] : NULL;
+}
+
+bool smap_remove(SmallMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value)
+{
+    panic_if_null(key, "Null Pointer: SmallMap key must not be null");
+
+    if (smap_large(map))
+    {
+        return map_remove(map->map, key, removed_key, removed_value);
+    }
+
+    int32_t index = smap_find(map, key);
+    if (index == -1)
+    {
+        return false;
+    }
+    if (removed_key != NULL)
+    {
+        *removed_key = map->keys[index];
+    }
+    else
+    {
+        del_c(map->key_class, map->keys[index]);
+    }
+    if (removed_value != NULL)
+    {
+        *removed_value = map->values[index];
+    }
+    else
+    {
+        del_c(map->value_class, map->values[index]);
+    }
+
+    // Maps are unordered, so the last entry fills the hole
+    map->length--;
+    map->keys[index] = map->keys[map->length];
+    map->values[index] = map->values[map->length];
+    return true;
+}
+
+void smap_clear(SmallMap map)
+{
+    for (uint32_t i = 0; i < map->length; i++)
+    {
+        del_c(map->key_class, map->keys[i]);
+        del_c(map->value_class, map->values[i]);
+    }
+    map->length = 0;
+    if (map->map != NULL)
+    {
+        map_clear(map->map); // Kept, for the next time the map is large
+    }
+}
+
+
+// Private Methods
+
+// If the entries are held in the Map, rather than inline. Once the Map is emptied, by clearing or removing, the entries are held inline again
+static bool smap_large(SmallMap map)
+{
+    return map->map != NULL && map->map->length > 0;
+}
+
+// Finds the index of an inline key, or -1 if it is not present
+static int32_t smap_find(SmallMap map, pointer_t key)
+{
+    for (uint32_t i = 0; i < map->length; i++)
+    {
+        if (equals_c(map->key_class, map->keys[i], key))
+        {
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,74 @@
+// A hash map optimized for a small number of entries, such as one built for each line or record of an input
+// Up to SMALL_MAP_INLINE entries are stored inline, in arrays, and found by comparing each key with equals(). No table is allocated, and keys are never hashed.
+// Once it outgrows the arrays, every entry is moved into a Map, which is kept (although emptied) when the map is cleared, and used from then on whenever the map is large.
+// The Map methods map_put(), map_contains_key(), map_get(), map_remove() and map_clear() also accept a SmallMap, so code using a Map only needs to change it's type to use a SmallMap.
+// Cannot contain NULL keys
+
+#include "../lib.h"
+#include "map.h"
+
+#ifndef COLLECTIONS_SMALL_MAP_H
+#define COLLECTIONS_SMALL_MAP_H
+
+// The number of entries stored inline
+#define SMALL_MAP_INLINE 16
+
+struct SmallMap__struct
+{
+    pointer_t keys[SMALL_MAP_INLINE]; // Inline keys, while the map is small
+    pointer_t values[SMALL_MAP_INLINE]; // Inline values, parallel to the keys
+    Map map; // Once the map has outgrown the inline entries, the Map that holds them, while the map is large. NULL until then
+    Class key_class; // The key class
+    Class value_class; // The value class
+    uint32_t initial_size; // The initial size of the Map
+    HashOptions options; // The options of the Map
+    uint32_t length; // The number of inline entries. While the map is large, this is 0
+};
+
+typedef struct SmallMap__struct * SmallMap;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+
+// The parameters are as for a Map, and are used to create the Map once the inline entries are outgrown
+declare_constructor(SmallMap, uint32_t initial_size, Class key_class, Class value_class, HashOptions options);
+
+// The options are optional, new(SmallMap, initial_size, key_class, value_class) will use HASH_DEFAULT
+#define SmallMap__new(initial_size, key_class, value_class, options...) SmallMap__new(initial_size, key_class, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
+void SmallMap__del(SmallMap map);
+String SmallMap__format(SmallMap map);
+
+// Iterator
+// While the map is large, this iterates the Map
+
+typedef struct
+{
+    uint32_t index;
+    pointer_t key;
+    pointer_t value;
+} Iterator(SmallMap);
+
+bool SmallMap__iterator__test(Iterator(SmallMap)* it, SmallMap map);
+
+#define SmallMap__iterator__start(map) { 0, NULL, NULL }
+#define SmallMap__iterator__next(it, map) (it)->index++
+
+
+// Public Instance Methods - these all borrow the map, and follow the semantics of the Map methods of the same name
+
+bool smap_put(SmallMap map, pointer_t key, pointer_t value);
+bool smap_contains_key(SmallMap map, pointer_t key);
+pointer_t smap_get(SmallMap map, pointer_t key);
+bool smap_remove(SmallMap map, pointer_t key, pointer_t* removed_key, pointer_t* removed_value);
+void smap_clear(SmallMap map);
+
+// The Map methods, which select the SmallMap method by the type of map
+#define map_put(map, key, value) _Generic((map), SmallMap: smap_put, default: map_put)(map, key, value)
+#define map_contains_key(map, key) _Generic((map), SmallMap: smap_contains_key, default: map_contains_key)(map, key)
+#define map_get(map, key) _Generic((map), SmallMap: smap_get, default: map_get)(map, key)
+#define map_remove(map, key, removed_key, removed_value) _Generic((map), SmallMap: smap_remove, default: map_remove)(map, key, removed_key, removed_value)
+#define map_clear(map) _Generic((map), SmallMap: smap_clear, default: map_clear)(map)
+
+#endif
@@ -0,0 +1,189 @@
+#include "smallset.h"
+
+// Private Methods
+
+static bool sset_large(SmallSet set);
+static int32_t sset_find(SmallSet set, pointer_t value);
+
+
+// The name is parenthesized, as SmallSet__new() is also a macro supplying the default options
+SmallSet (SmallSet__new)(uint32_t initial_size, Class value_class, HashOptions options)
+{
+    SmallSet set = class_malloc(SmallSet);
+
+    set->set = NULL;
+    set->value_class = value_class;
+    set->initial_size = initial_size;
+    set->options = options;
+    set->length = 0;
+
+    return set;
+}
+
+void SmallSet__del(SmallSet set)
+{
+    for (uint32_t i = 0; i < set->length; i++)
+    {
+        del_c(set->value_class, set->values[i]);
+    }
+    if (set->set != NULL)
+    {
+        del(Set, set->set);
+    }
+    free(set);
+}
+
+String SmallSet__format(SmallSet set)
+{
+    String s = new(String, "SmallSet<");
+    str_append(s, set->value_class->name);
+    str_append(s, ">{");
+    if (set->length == 0 && !sset_large(set))
+    {
+        str_append(s, "}");
+        return s;
+    }
+    else
+    {
+        for iter(SmallSet, it, set)
+        {
+            str_append(s, format_c(set->value_class, it.value));
+            str_append(s, ", ");
+        }
+    }
+    str_pop(s, 2); // Pop the last ', '
+    str_append(s, "}");
+    return s;
+}
+
+
+// Iterator
+
+bool SmallSet__iterator__test(Iterator(SmallSet)* it, SmallSet set)
+{
+    if (sset_large(set))
+    {
+        Iterator(Set) set_it = { it->index, NULL };
+        bool valid = Set__iterator__test(&set_it, set->set);
+        it->index = set_it.index;
+        it->value = set_it.value;
+        return valid;
+    }
+    if (it->index < set->length)
+    {
+        it->value = set->values[it->index];
+        return true;
+    }
+    return false;
+}
+
+
+// Instance Methods
+
+bool sset_put(SmallSet set, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: SmallSet value must not be null");
+
+    if (sset_large(set))
+    {
+        return set_put(set->set, value);
+    }
+
+    int32_t index = sset_find(set, value);
+    if (index != -1)
+    {
+        // Replace the value, as with set_put()
+        del_c(set->value_class, set->values[index]);
+        set->values[index] = value;
+        return true;
+    }
+
+    if (set->length == SMALL_SET_INLINE)
+    {
+        // Outgrown the inline values, so move them into the Set
+        if (set->set == NULL)
+        {
+            set->set = new(Set, set->initial_size, set->value_class, set->options);
+        }
+        set_put_all(set->set, set->length, set->values);
+        set->length = 0;
+        return set_put(set->set, value);
+    }
+
+    set->values[set->length++] = value;
+    return false;
+}
+
+bool sset_contains(SmallSet set, pointer_t value)
+{
+    panic_if_null(value, "Null Pointer: SmallSet value must not be null");
+
+    if (sset_large(set))
+    {
+        return set_contains(set->set, value);
+    }
+    return sset_find(set, value) != -1;
+}
+
+bool sset_remove(SmallSet set, pointer_t value, pointer_t* removed_value)
+{
+    panic_if_null(value, "Null Pointer: SmallSet value must not be null");
+
+    if (sset_large(set))
+    {
+        return set_remove(set->set, value, removed_value);
+    }
+
+    int32_t index = sset_find(set, value);
+    if (index == -1)
+    {
+        return false;
+    }
+    if (removed_value != NULL)
+    {
+        *removed_value = set->values[index];
+    }
+    else
+    {
+        del_c(set->value_class, set->values[index]);
+    }
+
+    // Sets are unordered, so the last value fills the hole
+    set->values[index] = set->values[--set->length];
+    return true;
+}
+
+void sset_clear(SmallSet set)
+{
+    for (uint32_t i = 0; i < set->length; i++)
+    {
+        del_c(set->value_class, set->values[i]);
+    }
+    set->length = 0;
+    if (set->set != NULL)
+    {
+        set_clear(set->set); // Kept, for the next time the set is large
+    }
+}
+
+
+// Private Methods
+
+// If the values are held in the Set, rather than inline. Once the Set is emptied, by clearing or removing, the values are held inline again
+static bool sset_large(SmallSet set)
+{
+    return set->set != NULL && set->set->length > 0;
+}
+
+// Finds the index of an inline value, or -1 if it is not present
+static int32_t sset_find(SmallSet set, pointer_t value)
+{
+    for (uint32_t i = 0; i < set->length; i++)
+    {
+        if (equals_c(set->value_class, set->values[i], value))
+        {
+            return (int32_t) i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,69 @@
+// A hash set optimized for a small number of values, such as one built for each line or record of an input
+// Up to SMALL_SET_INLINE values are stored inline, in an array, and found by comparing each with equals(). No table is allocated, and values are never hashed.
+// Once it outgrows the array, every value is moved into a Set, which is kept (although emptied) when the set is cleared, and used from then on whenever the set is large.
+// The Set methods set_put(), set_contains(), set_remove() and set_clear() also accept a SmallSet, so code using a Set only needs to change it's type to use a SmallSet.
+// Cannot contain NULL values
+
+#include "../lib.h"
+#include "set.h"
+
+#ifndef COLLECTIONS_SMALL_SET_H
+#define COLLECTIONS_SMALL_SET_H
+
+// The number of values stored inline
+#define SMALL_SET_INLINE 16
+
+struct SmallSet__struct
+{
+    pointer_t values[SMALL_SET_INLINE]; // Inline values, while the set is small
+    Set set; // Once the set has outgrown the inline values, the Set that holds them, while the set is large. NULL until then
+    Class value_class; // The value class
+    uint32_t initial_size; // The initial size of the Set
+    HashOptions options; // The options of the Set
+    uint32_t length; // The number of inline values. While the set is large, this is 0
+};
+
+typedef struct SmallSet__struct * SmallSet;
+
+// This is a pseudo class
+// It does not have a Class<T> object, nor implement all methods of the class
+// However, it can still be used with new(), del(), and format()
+
+// The parameters are as for a Set, and are used to create the Set once the inline values are outgrown
+declare_constructor(SmallSet, uint32_t initial_size, Class value_class, HashOptions options);
+
+// The options are optional, new(SmallSet, initial_size, value_class) will use HASH_DEFAULT
+#define SmallSet__new(initial_size, value_class, options...) SmallSet__new(initial_size, value_class, ARG_2(~, ## options, HASH_DEFAULT))
+
+void SmallSet__del(SmallSet set);
+String SmallSet__format(SmallSet set);
+
+// Iterator
+// While the set is large, this iterates the Set
+
+typedef struct
+{
+    uint32_t index;
+    pointer_t value;
+} Iterator(SmallSet);
+
+bool SmallSet__iterator__test(Iterator(SmallSet)* it, SmallSet set);
+
+#define SmallSet__iterator__start(set) { 0, NULL }
+#define SmallSet__iterator__next(it, set) (it)->index++
+
+
+// Public Instance Methods - these all borrow the set, and follow the semantics of the Set methods of the same name
+
+bool sset_put(SmallSet set, pointer_t value);
+bool sset_contains(SmallSet set, pointer_t value);
+bool sset_remove(SmallSet set, pointer_t value, pointer_t* removed_value);
+void sset_clear(SmallSet set);
+
+// The Set methods, which select the SmallSet method by the type of set
+#define set_put(set, value) _Generic((set), SmallSet: sset_put, default: set_put)(set, value)
+#define set_contains(set, value) _Generic((set), SmallSet: sset_contains, default: set_contains)(set, value)
+#define set_remove(set, value, removed_value) _Generic((set), SmallSet: sset_remove, default: set_remove)(set, value, removed_value)
+#define set_clear(set) _Generic((set), SmallSet: sset_clear, default: set_clear)(set)
+
+#endif
@@ -55,12 +55,13 @@ int32_t CONCAT(TUPLE_CLASS, __compare)(TUPLE_CLASS left, TUPLE_CLASS right)
 }
 
 // hash()
+// Members are combined in order, see hash_combine()
 uint32_t CONCAT(TUPLE_CLASS, __hash)(TUPLE_CLASS tuple)
 {
     uint32_t h = hash(TUPLE_TYPE1, tuple->TUPLE_VALUE1);
-    IIF_EMPTY(TUPLE_ARG2, h ^= hash(TUPLE_TYPE2, tuple->TUPLE_VALUE2);)
-    IIF_EMPTY(TUPLE_ARG3, h ^= hash(TUPLE_TYPE3, tuple->TUPLE_VALUE3);)
-    IIF_EMPTY(TUPLE_ARG4, h ^= hash(TUPLE_TYPE4, tuple->TUPLE_VALUE4);)
+    IIF_EMPTY(TUPLE_ARG2, h = hash_combine(h, hash(TUPLE_TYPE2, tuple->TUPLE_VALUE2));)
+    IIF_EMPTY(TUPLE_ARG3, h = hash_combine(h, hash(TUPLE_TYPE3, tuple->TUPLE_VALUE3));)
+    IIF_EMPTY(TUPLE_ARG4, h = hash_combine(h, hash(TUPLE_TYPE4, tuple->TUPLE_VALUE4));)
     return h;
 }
 
@@ -0,0 +1,89 @@
+#include "hash.h"
+
+#include <stdatomic.h> // Used for the seed counter
+
+// Unaligned little endian reads
+static inline uint64_t hash_read64(const uint8_t* p)
+{
+    uint64_t value;
+    memcpy(&value, p, sizeof(uint64_t));
+    return value;
+}
+
+static inline uint64_t hash_read32(const uint8_t* p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(uint32_t));
+    return value;
+}
+
+// Reads 1 - 3 bytes, as the first, middle and last byte
+static inline uint64_t hash_read3(const uint8_t* p, uint64_t length)
+{
+    return (((uint64_t) p[0]) << 16) | (((uint64_t) p[length >> 1]) << 8) | p[length - 1];
+}
+
+// Short inputs are read as two (possibly overlapping) words from each end. Longer inputs are read sixteen bytes per multiply, with three independent lanes above 48 bytes, so the multiplies can overlap.
+uint64_t hash_bytes(const void* data, uint64_t length, uint64_t seed)
+{
+    const uint8_t* p = data;
+    uint64_t a, b;
+
+    seed ^= hash_mum(seed ^ HASH_SECRET_0, HASH_SECRET_1);
+    if (length <= 16)
+    {
+        if (length >= 4)
+        {
+            uint64_t middle = (length >> 3) << 2; // 0 or 4, so 4 - 7 bytes read the same word twice
+            a = (hash_read32(p) << 32) | hash_read32(p + middle);
+            b = (hash_read32(p + length - 4) << 32) | hash_read32(p + length - 4 - middle);
+        }
+        else if (length > 0)
+        {
+            a = hash_read3(p, length);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        uint64_t remaining = length;
+        if (remaining > 48)
+        {
+            uint64_t seed1 = seed, seed2 = seed;
+            do
+            {
+                seed = hash_mum(hash_read64(p) ^ HASH_SECRET_1, hash_read64(p + 8) ^ seed);
+                seed1 = hash_mum(hash_read64(p + 16) ^ HASH_SECRET_2, hash_read64(p + 24) ^ seed1);
+                seed2 = hash_mum(hash_read64(p + 32) ^ HASH_SECRET_3, hash_read64(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16)
+        {
+            seed = hash_mum(hash_read64(p) ^ HASH_SECRET_1, hash_read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last sixteen bytes, which may overlap those already read
+        a = hash_read64(p + remaining - 16);
+        b = hash_read64(p + remaining - 8);
+    }
+
+    __uint128_t product = (__uint128_t) (a ^ HASH_SECRET_1) * (b ^ seed);
+    return hash_mum((uint64_t) product ^ HASH_SECRET_0 ^ length, (uint64_t) (product >> 64) ^ HASH_SECRET_1);
+}
+
+// Seeds are a counter, mixed with the time and the address of the counter, which vary between runs
+uint32_t hash_random_seed()
+{
+    static atomic_uint_fast64_t counter = 0;
+    uint64_t count = atomic_fetch_add(&counter, 1);
+    uint32_t seed = hash_fold(hash_mix64(count ^ hash_mix64((uint64_t) (uintptr_t) &counter ^ (uint64_t) time(NULL))));
+    return seed != 0 ? seed : 1;
+}
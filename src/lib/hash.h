@@ -0,0 +1,61 @@
+// Hash functions, used to implement the hash() of classes
+// Byte strings are hashed a word at a time (following wyhash), and values are mixed and combined with a 64 bit multiply, whose 128 bit product is folded back to 64 bits.
+// Class hashes are 32 bits, so these are folded once more with hash_fold().
+
+#include "lib.h"
+
+#ifndef HASH_H
+#define HASH_H
+
+// Secrets
+// Odd constants with half their bits set, and no long runs of equal bits (those of wyhash)
+#define HASH_SECRET_0 0xA0761D6478BD642Full
+#define HASH_SECRET_1 0xE7037ED1A0B428DBull
+#define HASH_SECRET_2 0x8EBC6AF09C88C6E3ull
+#define HASH_SECRET_3 0x589965CC75374CC3ull
+
+// Multiplies two values, and folds the 128 bit product with xor. Each bit of the result depends on every bit of both values
+static inline uint64_t hash_mum(uint64_t a, uint64_t b)
+{
+    __uint128_t product = (__uint128_t) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+// Folds a 64 bit hash to 32 bits
+static inline uint32_t hash_fold(uint64_t h)
+{
+    return (uint32_t) (h ^ (h >> 32));
+}
+
+// Mixes the bits of a hash (the murmur3 finalizer)
+// Identity hashes, such as those of small integers, only fill the low bits. Users of both the low and high bits of a hash, such as the group engine of Map and Set, mix them first.
+static inline uint32_t hash_mix(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85EBCA6B;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35;
+    h ^= h >> 16;
+    return h;
+}
+
+// Hashes a 64 bit value
+static inline uint64_t hash_mix64(uint64_t value)
+{
+    return hash_mum(value ^ HASH_SECRET_0, HASH_SECRET_1);
+}
+
+// Combines the hash of a value with the hash of the values before it, e.g. for the members of a tuple, or the elements of a list.
+// The result depends on the order of the values, so (a, b) and (b, a) hash differently, and (k, k) does not cancel out.
+static inline uint32_t hash_combine(uint32_t h, uint32_t value)
+{
+    return hash_fold(hash_mum(h ^ HASH_SECRET_0, value ^ HASH_SECRET_1));
+}
+
+// Hashes an array of bytes, reading it eight bytes at a time. Different seeds give independent hash functions.
+uint64_t hash_bytes(const void* data, uint64_t length, uint64_t seed);
+
+// Returns a new seed for a hash table, which is different for each call, and each run of the program. Never 0
+uint32_t hash_random_seed();
+
+#endif
@@ -6,9 +6,9 @@ bool    __panic_recovery_active = false;
 jmp_buf __panic_recovery_context;
 
 // Stack Tracing
-StackFrame __stack_frame_array[MAX_STACK];
-uint32_t   __stack_frame_length = 0;
-bool       __panic_invoked = false;
+_Thread_local StackFrame __stack_frame_array[MAX_STACK];
+_Thread_local uint32_t   __stack_frame_length = 0;
+_Thread_local bool       __panic_invoked = false;
 
 void __panic(slice_t panic_func, StackFrame frame_in, slice_t detail_string, slice_t format_string, ...)
 {
@@ -109,12 +109,7 @@ int32_t Class__compare(Class left, Class right)
 uint32_t Class__hash(Class cls)
 {
     // Hash the name as a string
-    uint32_t h = 0;
-    for (uint32_t i = 0; cls->name[i] != '\0'; i++)
-    {
-        h = (h * 31) + (uint32_t) cls->name[i];
-    }
-    return h;
+    return hash_fold(hash_bytes(cls->name, strlen(cls->name), 0));
 }
 
 String Class__format(Class cls)
@@ -202,6 +197,15 @@ pointer_t __malloc(uint64_t size, StackFrame frame)
     return ptr;
 }
 
+pointer_t __calloc(uint64_t size, StackFrame frame)
+{
+    __stack_frame_push(frame);
+    pointer_t ptr = calloc(1, size);
+    panic_if_null(ptr, "Out of Memory: Cannot allocate %lu bytes", size);
+    __stack_frame_pop();
+    return ptr;
+}
+
 void __realloc(pointer_t* ref_ptr, uint64_t size, StackFrame frame)
 {
     __stack_frame_push(frame);
@@ -249,9 +249,9 @@ typedef String    (*FnFormat)  (pointer_t);
 #define char__hash(instance)     ((uint32_t) instance)
 #define bool__hash(instance)     ((uint32_t) instance)
 #define int32_t__hash(instance)  ((uint32_t) instance)
-#define int64_t__hash(instance)  ((uint32_t)((instance) | ((instance) >> 32)))
+#define int64_t__hash(instance)  hash_fold(hash_mix64((uint64_t) (instance)))
 #define uint32_t__hash(instance) ((uint32_t) instance)
-#define uint64_t__hash(instance) ((uint32_t)((instance) | ((instance) >> 32)))
+#define uint64_t__hash(instance) hash_fold(hash_mix64((uint64_t) (instance)))
 
 #define char__format(instance)     str_format("%c", instance)
 #define bool__format(instance)     new(String, ((instance) ? "true" : "false"))
@@ -468,9 +468,10 @@ typedef struct StackFrame__struct StackFrame;
 #define MAX_STACK 16
 
 // Stack Tracing
-extern StackFrame __stack_frame_array[MAX_STACK];
-extern uint32_t   __stack_frame_length;
-extern bool       __panic_invoked;
+// Each thread traces it's own stack, so library functions which push stack frames (such as safe_malloc()) can be called from multiple threads
+extern _Thread_local StackFrame __stack_frame_array[MAX_STACK];
+extern _Thread_local uint32_t   __stack_frame_length;
+extern _Thread_local bool       __panic_invoked;
 
 // Internal function, like exit(), which tries to invoke a panic
 // If the global recovery context is set, uses longjmp to return to there
@@ -507,11 +508,15 @@ void __stack_frame_pop();
 // Standard Memory Allocations
 #define class_malloc(cls) __malloc(sizeof(struct CONCAT(cls, __struct)), __create_stack_frame)
 #define safe_malloc(size) __malloc(size, __create_stack_frame)
+#define safe_calloc(size) __calloc(size, __create_stack_frame)
 #define safe_realloc(ptr, size) __realloc((pointer_t*) (& (ptr)), size, __create_stack_frame)
 
 // Calls malloc() guarded with an panic. Return value is gaurenteed to be non null
 pointer_t __malloc(uint64_t size, StackFrame frame);
 
+// Calls calloc() guarded with a panic. The memory is zeroed, and large allocations are zeroed lazily, by the OS, as pages are first touched. Return value is gaurenteed to be non null
+pointer_t __calloc(uint64_t size, StackFrame frame);
+
 // Calls realloc() guarded with a panic. ref_ptr is gaurenteed to be non null on return.
 void __realloc(pointer_t* ref_ptr, uint64_t size, StackFrame frame);
 
@@ -558,11 +563,21 @@ pointer_t __move(pointer_t* ref_ptr);
 // Interdependencies: Specified per header
 
 #include "utils.h"
+#include "hash.h"
 #include "strings.h"
 
 #include "collections/arraylist.h"
 #include "collections/map.h"
+#include "collections/orderedmap.h"
 #include "collections/result.h"
+#include "collections/primitivemap.h"
 #include "collections/set.h"
+#include "collections/concurrentmap.h"
+#include "collections/concurrentset.h"
+#include "collections/rcumap.h"
+#include "collections/smallset.h"
+#include "collections/smallmap.h"
+#include "collections/bitset.h"
+#include "collections/interner.h"
 
 #endif
\ No newline at end of file
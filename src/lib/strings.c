@@ -133,12 +133,7 @@ int32_t String__compare(String left, String right)
 
 uint32_t String__hash(String instance)
 {
-    uint32_t h = 0;
-    for iter(String, it, instance)
-    {
-        h = (h * 31) + (uint32_t) it.value;
-    }
-    return h;
+    return hash_fold(hash_bytes(instance->slice, instance->length, 0));
 }
 
 String String__format(String instance)
@@ -14,12 +14,8 @@ int main(void)
         }
 
         // Part 1 - calculate the difference between max and min in each line
-        uint32_t min_value = INT_MAX, max_value = 0;
-        for iter(PrimitiveArrayList(uint32_t), it, array)
-        {
-            min_value = min(min_value, it.value);
-            max_value = max(max_value, it.value);
-        }
+        uint32_t min_value, max_value;
+        al_minmax(array, &min_value, &max_value);
         part1 += max_value - min_value;
 
         // Part 2 - find the only two numbers which divide one another, and find the quotient
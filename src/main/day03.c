@@ -6,6 +6,9 @@
 #define Tuple Point, int32_t, x, int32_t, y
 #include "../lib/collections/tuple.template.c"
 
+// Packs a point into a single int64_t, to use as a PrimitiveMap key
+#define point_key(x, y) ((int64_t) (((uint64_t) (uint32_t) (x) << 32) | (uint32_t) (y)))
+
 int main(void)
 {
     Point p = new(Point, 0, 0);
@@ -46,9 +49,8 @@ int main(void)
     max_steps = INPUT, walk_count = 0, step_max = 1, step_count = 0;
     uint32_t part2 = 0;
 
-    Point q = new(Point, 0, 0);
-    Map points = new(Map, 32, class(Point), class(Int32));
-    map_put(points, copy(Point, p), new(Int32, 1));
+    PrimitiveMap(int64_t) points = new(PrimitiveMap(int64_t), 32);
+    pm_put(points, point_key(p->x, p->y), 1);
 
     for (uint32_t i = 2; part2 <= INPUT; i++)
     {
@@ -73,27 +75,20 @@ int main(void)
             step_max += 1;
         }
 
-        int32_t next_value = 0;
+        int64_t next_value = 0;
         for (int32_t dx = -1; dx <= 1; dx++)
         {
             for(int32_t dy = -1; dy <= 1; dy++)
             {
-                q->x = p->x + dx;
-                q->y = p->y + dy;
-                Int32 value = map_get(points, q);
-                if (value != NULL)
-                {
-                    next_value += *value;
-                }
+                next_value += pm_get(points, point_key(p->x + dx, p->y + dy)); // Missing points are 0
             }
         }
-        map_put(points, copy(Point, p), new(Int32, next_value));
+        pm_put(points, point_key(p->x, p->y), next_value);
         part2 = next_value;
     }
 
     // Cleanup
-    del(Map, points);
-    del(Point, q);
+    del(PrimitiveMap(int64_t), points);
     del(Point, p);
     del(Point, dp);
 
@@ -4,8 +4,9 @@ int main(void)
 {
     String input = read_file("./inputs/day04.txt", 1000);
 
-    Set unique_words = new(Set, 10, class(String));
-    Set unique_sorted_words = new(Set, 10, class(String));
+    // Lines rarely have more than a dozen words, so both sets hold them inline, without hashing. Both are cleared after every line
+    SmallSet unique_words = new(SmallSet, 10, class(String), HASH_DEFAULT | HASH_REUSABLE);
+    SmallSet unique_sorted_words = new(SmallSet, 10, class(String), HASH_DEFAULT | HASH_REUSABLE);
 
     uint32_t part1 = 0, part2 = 0;
     for iter(StringSplit, line_it, input, "\n")
@@ -46,8 +47,8 @@ int main(void)
     }
 
     del(String, input);
-    del(Set, unique_words);
-    del(Set, unique_sorted_words);
+    del(SmallSet, unique_words);
+    del(SmallSet, unique_sorted_words);
 
     ANSWER(325, part1, 119, part2);
 }
\ No newline at end of file
@@ -11,7 +11,8 @@ int main(void)
     uint32_t mask = SIZE - 1; // This only works when SIZE is a multiple of 2
     panic_if(next_highest_power_of_two(SIZE) != SIZE, "This solution uses bit fiddling hacks that only work with SIZE = 1 << N");
 
-    Map found = new(Map, 1000, class(PrimitiveArrayList(uint32_t)), class(Int32));
+    // Each distinct state is stored once. As every new state is interned in order, a state's id is the cycle it was first seen
+    Interner found = new(Interner, 1000, class(PrimitiveArrayList(uint32_t)));
     PrimitiveArrayList(uint32_t) state = new(PrimitiveArrayList(uint32_t), SIZE);
     for (uint32_t i = 0; i < SIZE; i++)
     {
@@ -19,22 +20,14 @@ int main(void)
     }
 
     uint32_t cycle = 0;
-    map_put(found, state, new(Int32, cycle));
+    intern_put(found, state);
     loop
     {
         PrimitiveArrayList(uint32_t) next = copy(PrimitiveArrayList(uint32_t), state);
 
-        // Compute the smallest memory bank
-        uint32_t max_index = 0;
-        uint32_t max_value = al_get(next, 0);
-        for iter(PrimitiveArrayList(uint32_t), it, next)
-        {
-            if (it.value > max_value)
-            {
-                max_value = it.value;
-                max_index = it.index;
-            }
-        }
+        // Compute the largest memory bank, choosing the first on ties
+        uint32_t max_index = unwrap(al_argmax(next));
+        uint32_t max_value = al_get(next, max_index);
 
         // Remove all from the minimum bank
         al_set(next, max_index, 0);
@@ -50,21 +43,20 @@ int main(void)
 
         cycle++;
 
-        if (map_contains_key(found, next))
+        // Intern the state, which either inserts it, or deletes it and returns the cycle it was first seen
+        uint32_t first_seen = intern_put(found, next);
+        if (first_seen != cycle)
         {
             // Detected a cycle
             part1 = cycle;
-            part2 = cycle - *(Int32) map_get(found, next);
-
-            del(PrimitiveArrayList(uint32_t), next);
+            part2 = cycle - first_seen;
             break;
         }
 
-        map_put(found, next, new(Int32, cycle));
         state = next;
     }
 
-    del(Map, found);
+    del(Interner, found);
 
     ANSWER(14029, part1, 2765, part2);
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #include "aoc.h"
 
-#define Tuple Node, String, name, uint32_t, weight, ArrayList, children
+#define Tuple Node, uint32_t, name, uint32_t, weight, ArrayList, children
 #include "../lib/collections/tuple.template.c" 
 
 int main(void)
 {
     String input = read_file("./inputs/day07.txt", 1000);
-    Map nodes = new(Map, 1024, class(String), class(Node));
+    Interner names = new(Interner, 1024, class(String)); // Each name is stored once, and nodes refer to it by id
+    ArrayList nodes = new(ArrayList, 1024, class(Node)); // Nodes, indexed by the id of their name
 
     for iter(StringSplit, it, input, "\n") // Lines
     {
@@ -19,9 +20,11 @@ int main(void)
         uint32_t weight = unwrap(str_parse_uint32_t(weight_string));
         del(String, weight_string);
 
-        map_put(nodes, key, new(Node, copy(String, key), weight, new(ArrayList, 1, class(String))));
+        uint32_t name = intern_put(names, key); // Each line names a new node, so this is also the node's index
+        al_append(nodes, new(Node, name, weight, new(ArrayList, 1, class(String))));
     }
 
     del(String, input);
-    del(Map, nodes);
+    del(ArrayList, nodes);
+    del(Interner, names);
 }
@@ -28,7 +28,153 @@
 #define v1 123
 #include "testprimitivearraylist.template.c"
 
+TEST(test_array_list_reserve_shrink, {
+    ArrayList list = new(ArrayList, 0, class(String));
+
+    al_append(list, new(String, "one")); // Grows from a size of 0
+    al_reserve(list, 50);
+    ASSERT_EQUAL(list->size, 50u, "Actual size = %d", list->size);
+    al_shrink_to_fit(list);
+    ASSERT_EQUAL(list->size, 1u, "Actual size = %d", list->size);
+
+    String value = al_get(list, 0);
+    ASSERT_TRUE(str_equals_content(value, "one"), "Actual: '%s'", value->slice);
+
+    del(ArrayList, list);
+});
+
+TEST(test_array_list_extend, {
+    ArrayList list = new(ArrayList, 1, class(String));
+    pointer_t array[] = { new(String, "one"), new(String, "two") };
+
+    al_extend_array(list, array, 2); // Takes ownership of each value
+    al_extend(list, list); // Copies each value
+    ASSERT_EQUAL(list->length, 4u, "Actual length = %d", list->length);
+
+    String s = format(ArrayList, list);
+    ASSERT_TRUE(str_equals_content(s, "ArrayList{one, two, one, two}"), "Actual: '%s'", s->slice);
+    ASSERT_TRUE(al_get(list, 0) != al_get(list, 2), "Extending should copy each value");
+
+    del(String, s);
+    del(ArrayList, list);
+});
+
+TEST(test_array_list_reductions_signed, {
+    // Long enough for several argmax blocks, and for the vector loops to have a remainder
+    PrimitiveArrayList(int32_t) list = new(PrimitiveArrayList(int32_t), 10);
+    ASSERT_TRUE(is_err(al_min(list)), "Min of an empty list should be Err");
+    ASSERT_TRUE(is_err(al_max(list)), "Max of an empty list should be Err");
+    ASSERT_TRUE(is_err(al_argmax(list)), "Argmax of an empty list should be Err");
+
+    for (int32_t i = 0; i < 5000; i++)
+    {
+        al_append(list, (i * 7919) % 3001 - 1500);
+    }
+    al_set(list, 2500, INT_MIN);
+    al_set(list, 3100, INT_MAX);
+    al_set(list, 4200, INT_MAX); // Not the first maximum
+
+    int64_t sum = 0;
+    for iter(PrimitiveArrayList(int32_t), it, list)
+    {
+        sum += it.value;
+    }
+    ASSERT_EQUAL(al_sum(list), sum, "Expected sum = %ld, Actual = %ld", sum, al_sum(list));
+
+    int32_t low, high;
+    ASSERT_TRUE(al_minmax(list, &low, &high), "Minmax of a list should be true");
+    ASSERT_EQUAL(low, INT_MIN, "Actual min = %d", low);
+    ASSERT_EQUAL(high, INT_MAX, "Actual max = %d", high);
+    ASSERT_EQUAL(unwrap(al_min(list)), INT_MIN, "Actual min = %d", unwrap(al_min(list)));
+    ASSERT_EQUAL(unwrap(al_max(list)), INT_MAX, "Actual max = %d", unwrap(al_max(list)));
+    ASSERT_EQUAL(unwrap(al_argmax(list)), 3100u, "Actual argmax = %d", unwrap(al_argmax(list)));
+
+    del(PrimitiveArrayList(int32_t), list);
+});
+
+TEST(test_array_list_reductions_unsigned, {
+    PrimitiveArrayList(uint64_t) list = new(PrimitiveArrayList(uint64_t), 10);
+    for (uint64_t i = 0; i < 3000; i++)
+    {
+        al_append(list, i * 1000);
+    }
+    al_set(list, 1500, UINT64_MAX); // Above INT64_MAX, so would be negative if compared as signed
+
+    ASSERT_EQUAL(unwrap(al_max(list)), UINT64_MAX, "Actual max = %lu", unwrap(al_max(list)));
+    ASSERT_EQUAL(unwrap(al_min(list)), 0ul, "Actual min = %lu", unwrap(al_min(list)));
+    ASSERT_EQUAL(unwrap(al_argmax(list)), 1500u, "Actual argmax = %d", unwrap(al_argmax(list)));
+
+    PrimitiveArrayList(uint32_t) large = new(PrimitiveArrayList(uint32_t), 10);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        al_append(large, UINT32_MAX);
+    }
+    ASSERT_EQUAL(al_sum(large), 1000ul * UINT32_MAX, "The sum should not overflow. Actual sum = %lu", al_sum(large));
+    ASSERT_EQUAL(unwrap(al_argmax(large)), 0u, "Actual argmax = %d", unwrap(al_argmax(large)));
+
+    del(PrimitiveArrayList(uint64_t), list);
+    del(PrimitiveArrayList(uint32_t), large);
+});
+
+TEST(test_array_list_sort_signed, {
+    // Sizes either side of the insertion sort, with negative values, and values which differ only in their high bytes
+    uint32_t sizes[] = { 1, 2, 63, 64, 1000, 5000 };
+    for (uint32_t k = 0; k < 6; k++)
+    {
+        PrimitiveArrayList(int32_t) list32 = new(PrimitiveArrayList(int32_t), 10);
+        PrimitiveArrayList(int64_t) list64 = new(PrimitiveArrayList(int64_t), 10);
+        for (uint32_t i = 0; i < sizes[k]; i++)
+        {
+            al_append(list32, (int32_t) rand_uint32());
+            al_append(list64, (int64_t) (((uint64_t) rand_uint32() << 32) | (i & 3)));
+        }
+        al_set(list32, 0, INT_MIN);
+        al_set(list64, sizes[k] - 1, INT64_MIN);
+
+        al_sort(list32);
+        al_sort(list64);
+
+        ASSERT_EQUAL(al_get(list32, 0), INT_MIN, "Actual first = %d", al_get(list32, 0));
+        ASSERT_EQUAL(al_get(list64, 0), INT64_MIN, "Actual first = %ld", al_get(list64, 0));
+        for (uint32_t i = 1; i < sizes[k]; i++)
+        {
+            ASSERT_TRUE(al_get(list32, i - 1) <= al_get(list32, i), "List of %d not sorted at index %d", sizes[k], i);
+            ASSERT_TRUE(al_get(list64, i - 1) <= al_get(list64, i), "List of %d not sorted at index %d", sizes[k], i);
+        }
+
+        del(PrimitiveArrayList(int32_t), list32);
+        del(PrimitiveArrayList(int64_t), list64);
+    }
+});
+
+TEST(test_array_list_sort_unsigned, {
+    PrimitiveArrayList(uint32_t) list = new(PrimitiveArrayList(uint32_t), 10);
+    for (uint32_t i = 0; i < 5000; i++)
+    {
+        al_append(list, i < 2500 ? rand_uint32_in(256) : rand_uint32()); // Half differ only in their low byte
+    }
+    al_set(list, 100, UINT32_MAX);
+
+    uint64_t sum = al_sum(list);
+    al_sort(list);
+
+    ASSERT_EQUAL(al_sum(list), sum, "Sorting should keep every value. Actual sum = %lu", al_sum(list));
+    ASSERT_EQUAL(al_get(list, 4999), UINT32_MAX, "Actual last = %u", al_get(list, 4999));
+    for (uint32_t i = 1; i < 5000; i++)
+    {
+        ASSERT_TRUE(al_get(list, i - 1) <= al_get(list, i), "List not sorted at index %d", i);
+    }
+
+    del(PrimitiveArrayList(uint32_t), list);
+});
+
 TEST_GROUP(test_array_list, {
+    test_array_list_sort_signed();
+    test_array_list_sort_unsigned();
+    test_array_list_reductions_signed();
+    test_array_list_reductions_unsigned();
+    test_array_list_reserve_shrink();
+    test_array_list_extend();
 
     // Primitive ArrayList groups
     test_char_list();
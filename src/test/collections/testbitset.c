@@ -0,0 +1,155 @@
+#include "../unittest.h"
+
+TEST(test_bitset_new, {
+    BitSet set = new(BitSet, 100);
+    ASSERT_EQUAL(set->size, 2u, "Actual size = %d", set->size);
+    ASSERT_EQUAL(bs_count(set), 0u, "Actual count = %d", bs_count(set));
+    del(BitSet, set);
+});
+
+TEST(test_bitset_set_clear_test, {
+    BitSet set = new(BitSet, 128);
+
+    ASSERT_FALSE(bs_set(set, 3), "3 should not be set");
+    ASSERT_TRUE(bs_set(set, 3), "3 should already be set");
+    ASSERT_FALSE(bs_set(set, 64), "64 should not be set");
+    ASSERT_FALSE(bs_set(set, 127), "127 should not be set");
+
+    ASSERT_TRUE(bs_test(set, 3), "3 should be set");
+    ASSERT_TRUE(bs_test(set, 64), "64 should be set");
+    ASSERT_TRUE(bs_test(set, 127), "127 should be set");
+    ASSERT_FALSE(bs_test(set, 4), "4 should not be set");
+    ASSERT_FALSE(bs_test(set, 63), "63 should not be set");
+    ASSERT_FALSE(bs_test(set, 100000), "Integers outside the set should not be set");
+
+    ASSERT_TRUE(bs_clear(set, 64), "64 should have been set");
+    ASSERT_FALSE(bs_clear(set, 64), "64 should have been cleared");
+    ASSERT_FALSE(bs_clear(set, 100000), "Integers outside the set should not be set");
+    ASSERT_FALSE(bs_test(set, 64), "64 should not be set");
+    ASSERT_EQUAL(bs_count(set), 2u, "Actual count = %d", bs_count(set));
+
+    bs_clear_all(set);
+    ASSERT_EQUAL(bs_count(set), 0u, "Actual count = %d", bs_count(set));
+    ASSERT_EQUAL(set->size, 2u, "Actual size = %d", set->size);
+
+    del(BitSet, set);
+});
+
+TEST(test_bitset_grow, {
+    BitSet set = new(BitSet, 1);
+
+    bs_set(set, 0);
+    bs_set(set, 1000);
+    ASSERT_TRUE(set->size >= 16, "Actual size = %d", set->size);
+    ASSERT_TRUE(bs_test(set, 0), "0 should be set");
+    ASSERT_TRUE(bs_test(set, 1000), "1000 should be set");
+    ASSERT_EQUAL(bs_count(set), 2u, "Actual count = %d", bs_count(set));
+
+    // New words are cleared
+    for (uint32_t i = 1; i < 1000; i++)
+    {
+        ASSERT_FALSE(bs_test(set, i), "%d should not be set", i);
+    }
+
+    del(BitSet, set);
+});
+
+TEST(test_bitset_count_rank, {
+    BitSet set = new(BitSet, 1000);
+    for (uint32_t i = 0; i < 1000; i += 3)
+    {
+        bs_set(set, i);
+    }
+
+    ASSERT_EQUAL(bs_count(set), 334u, "Actual count = %d", bs_count(set));
+    ASSERT_EQUAL(bs_rank(set, 0), 0u, "Actual rank = %d", bs_rank(set, 0));
+    ASSERT_EQUAL(bs_rank(set, 1), 1u, "Actual rank = %d", bs_rank(set, 1));
+    ASSERT_EQUAL(bs_rank(set, 3), 1u, "Actual rank = %d", bs_rank(set, 3));
+    ASSERT_EQUAL(bs_rank(set, 64), 22u, "Actual rank = %d", bs_rank(set, 64));
+    ASSERT_EQUAL(bs_rank(set, 999), 333u, "Actual rank = %d", bs_rank(set, 999));
+    ASSERT_EQUAL(bs_rank(set, 100000), 334u, "Actual rank = %d", bs_rank(set, 100000));
+
+    del(BitSet, set);
+});
+
+TEST(test_bitset_iterator, {
+    BitSet set = new(BitSet, 256);
+    uint32_t values[] = { 0, 1, 63, 64, 65, 191, 255 };
+    for (uint32_t i = 0; i < 7; i++)
+    {
+        bs_set(set, values[i]);
+    }
+
+    uint32_t count = 0;
+    for iter(BitSet, it, set)
+    {
+        ASSERT_TRUE(count < 7, "Too many values");
+        ASSERT_EQUAL(it.value, values[count], "Value %d: Expected %d, Actual %d", count, values[count], it.value);
+        count++;
+    }
+    ASSERT_EQUAL(count, 7u, "Actual count = %d", count);
+
+    String s = format(BitSet, set);
+    ASSERT_TRUE(str_equals_content(s, "BitSet{0, 1, 63, 64, 65, 191, 255}"), "Actual: '%s'", s->slice);
+    del(String, s);
+
+    bs_clear_all(set);
+    s = format(BitSet, set);
+    ASSERT_TRUE(str_equals_content(s, "BitSet{}"), "Actual: '%s'", s->slice);
+    del(String, s);
+
+    del(BitSet, set);
+});
+
+TEST(test_bitset_bulk, {
+    // Multiples of 2 up to 200, and multiples of 3 up to 100, in a smaller set
+    BitSet twos = new(BitSet, 200), threes = new(BitSet, 100);
+    for (uint32_t i = 0; i < 200; i += 2)
+    {
+        bs_set(twos, i);
+    }
+    for (uint32_t i = 0; i < 100; i += 3)
+    {
+        bs_set(threes, i);
+    }
+
+    BitSet set = new(BitSet, 1);
+    bs_or(set, twos);
+    bs_and(set, threes); // Multiples of 6, below 100
+    ASSERT_EQUAL(bs_count(set), 17u, "Actual count = %d", bs_count(set));
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        ASSERT_EQUAL(bs_test(set, i), (i < 100 && i / 6 * 6 == i), "%d: Actual %d", i, bs_test(set, i));
+    }
+
+    bs_clear_all(set);
+    bs_or(set, twos);
+    bs_andnot(set, threes); // Multiples of 2, but not of 6 below 100
+    ASSERT_EQUAL(bs_count(set), 100u - 17u, "Actual count = %d", bs_count(set));
+    ASSERT_FALSE(bs_test(set, 96), "96 should not be set");
+    ASSERT_TRUE(bs_test(set, 98), "98 should be set");
+    ASSERT_TRUE(bs_test(set, 102), "102 should be set");
+
+    bs_clear_all(set);
+    bs_or(set, threes);
+    bs_xor(set, twos); // Multiples of 2 or 3, but not 6, below 100, and of 2 above
+    ASSERT_EQUAL(bs_count(set), 100u + 34u - 2u * 17u, "Actual count = %d", bs_count(set));
+    ASSERT_FALSE(bs_test(set, 0), "0 should not be set");
+    ASSERT_TRUE(bs_test(set, 3), "3 should be set");
+    ASSERT_TRUE(bs_test(set, 4), "4 should be set");
+    ASSERT_FALSE(bs_test(set, 96), "96 should not be set");
+    ASSERT_TRUE(bs_test(set, 102), "102 should be set");
+
+    del(BitSet, set);
+    del(BitSet, twos);
+    del(BitSet, threes);
+});
+
+TEST_GROUP(test_bitset, {
+    test_bitset_new();
+    test_bitset_set_clear_test();
+    test_bitset_grow();
+    test_bitset_count_rank();
+    test_bitset_iterator();
+    test_bitset_bulk();
+});
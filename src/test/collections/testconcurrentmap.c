@@ -0,0 +1,153 @@
+#include "../unittest.h"
+
+#define TEST_CMAP_THREADS 8
+#define TEST_CMAP_KEYS 4000
+
+TEST(test_concurrent_map_new, {
+    ConcurrentMap map = new(ConcurrentMap, 5, 16, class(Int32), class(Int32));
+    ASSERT_EQUAL(map->shard_count, 8u, "Actual shard count = %d", map->shard_count);
+    del(ConcurrentMap, map);
+});
+
+TEST(test_concurrent_map_put_get, {
+    ConcurrentMap map = new(ConcurrentMap, 4, 16, class(Int32), class(Int32));
+    Int32 key = new(Int32, 3);
+
+    ASSERT_FALSE(cmap_put(map, new(Int32, 3), new(Int32, 30)), "Key should not have been present");
+    ASSERT_TRUE(cmap_put(map, new(Int32, 3), new(Int32, 31)), "Key should have been present");
+    ASSERT_TRUE(cmap_contains_key(map, key), "Map should contain key = 3");
+
+    Int32 value = cmap_get(map, key); // A copy, owned by the caller
+    ASSERT_EQUAL(*value, 31, "Actual value = %d", *value);
+    del(Int32, value);
+
+    value = cmap_get_or_insert(map, new(Int32, 3), new(Int32, 40));
+    ASSERT_EQUAL(*value, 31, "Actual value = %d", *value);
+    del(Int32, value);
+
+    *key = 4;
+    ASSERT_TRUE(cmap_get(map, key) == NULL, "Map should not contain key = 4");
+    value = cmap_get_or_insert(map, new(Int32, 4), new(Int32, 40));
+    ASSERT_EQUAL(*value, 40, "Actual value = %d", *value);
+    del(Int32, value);
+
+    ASSERT_EQUAL(cmap_length(map), 2u, "Actual length = %d", cmap_length(map));
+    ASSERT_TRUE(cmap_remove(map, key, NULL, NULL), "Key = 4 should have been removed");
+    ASSERT_EQUAL(cmap_length(map), 1u, "Actual length = %d", cmap_length(map));
+
+    String s = format(ConcurrentMap, map);
+    ASSERT_TRUE(str_equals_content(s, "ConcurrentMap<Int32, Int32>{3: 31}"), "Actual: %s", s->slice);
+
+    del(String, s);
+    del(Int32, key);
+    del(ConcurrentMap, map);
+});
+
+typedef struct
+{
+    ConcurrentMap map;
+    uint32_t id;
+    int32_t seen[TEST_CMAP_KEYS]; // The value seen by get_or_insert() for each key
+} TestConcurrentMapThread;
+
+// Each thread puts it's own keys, and then races every other thread to get_or_insert() a shared range of keys, with it's id as the value
+static void* test_concurrent_map_thread(void* arg)
+{
+    TestConcurrentMapThread* thread = arg;
+    for (int32_t i = 0; i < TEST_CMAP_KEYS; i++)
+    {
+        int32_t key = (int32_t) (TEST_CMAP_KEYS * (thread->id + 1)) + i;
+        cmap_put(thread->map, new(Int32, key), new(Int32, key));
+    }
+    for (int32_t i = 0; i < TEST_CMAP_KEYS; i++)
+    {
+        Int32 value = cmap_get_or_insert(thread->map, new(Int32, i), new(Int32, (int32_t) thread->id));
+        thread->seen[i] = *value;
+        del(Int32, value);
+    }
+    return NULL;
+}
+
+TEST(test_concurrent_map_threads, {
+    ConcurrentMap map = new(ConcurrentMap, 4, 2, class(Int32), class(Int32));
+    pthread_t threads[TEST_CMAP_THREADS];
+    TestConcurrentMapThread* args = safe_malloc(sizeof(TestConcurrentMapThread) * TEST_CMAP_THREADS);
+
+    for (uint32_t i = 0; i < TEST_CMAP_THREADS; i++)
+    {
+        args[i].map = map;
+        args[i].id = i;
+        pthread_create(&threads[i], NULL, test_concurrent_map_thread, &args[i]);
+    }
+    for (uint32_t i = 0; i < TEST_CMAP_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    uint32_t expected = TEST_CMAP_KEYS * (TEST_CMAP_THREADS + 1);
+    ASSERT_EQUAL(cmap_length(map), expected, "Actual length = %d, expected = %d", cmap_length(map), expected);
+
+    Int32 key = new(Int32, 0);
+    for (int32_t i = 0; i < TEST_CMAP_KEYS; i++)
+    {
+        // Every thread must have seen the single value that was inserted
+        *key = i;
+        Int32 value = cmap_get(map, key);
+        for (uint32_t t = 0; t < TEST_CMAP_THREADS; t++)
+        {
+            ASSERT_EQUAL(args[t].seen[i], *value, "Key = %d, thread = %d saw %d, inserted = %d", i, t, args[t].seen[i], *value);
+        }
+        del(Int32, value);
+    }
+    for (int32_t i = TEST_CMAP_KEYS; i < (int32_t) expected; i++)
+    {
+        *key = i;
+        Int32 value = cmap_get(map, key);
+        ASSERT_TRUE(value != NULL && *value == i, "Key = %d", i);
+        del(Int32, value);
+    }
+
+    del(Int32, key);
+    free(args);
+    del(ConcurrentMap, map);
+});
+
+TEST(test_concurrent_map_shard_tags, {
+    // With many shards, the keys of each shard should still have well distributed h2 tags, so that a Swiss engine control byte match is rarely a false match
+    ConcurrentMap map = new(ConcurrentMap, 64, 16, class(Int32), class(Int32));
+    for (int32_t i = 0; i < 64 * 512; i++)
+    {
+        cmap_put(map, new(Int32, i), new(Int32, i));
+    }
+
+    // The chance that two keys of the same shard have the same tag, which for uniform tags is 1 / 128
+    uint64_t pairs = 0, matches = 0;
+    for (uint32_t i = 0; i < map->shard_count; i++)
+    {
+        Map shard = map->shards[i].map;
+        uint32_t tags[128] = { 0 };
+        for (uint32_t slot = 0; slot < shard->size; slot++)
+        {
+            if (shard->control[slot] < HASH_CONTROL_EMPTY)
+            {
+                tags[shard->control[slot]]++;
+            }
+        }
+        for (uint32_t tag = 0; tag < 128; tag++)
+        {
+            matches += (uint64_t) tags[tag] * (tags[tag] - 1);
+        }
+        pairs += (uint64_t) shard->length * (shard->length - 1);
+    }
+    double rate = (double) matches / pairs;
+    ASSERT_TRUE(rate < 2.0 / 128, "Tag false match rate = %f, expected about %f", rate, 1.0 / 128);
+
+    del(ConcurrentMap, map);
+});
+
+TEST_GROUP(test_concurrent_map, {
+    test_concurrent_map_new();
+    test_concurrent_map_put_get();
+    test_concurrent_map_threads();
+    test_concurrent_map_shard_tags();
+});
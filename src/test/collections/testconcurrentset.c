@@ -0,0 +1,152 @@
+#include "../unittest.h"
+
+#define TEST_CSET_THREADS 8
+#define TEST_CSET_VALUES 20000
+
+TEST(test_concurrent_set_put_contains, {
+    ConcurrentSet set = new(ConcurrentSet, 10, class(Int32));
+    Int32 value = new(Int32, 2);
+
+    ASSERT_FALSE(cset_put_if_absent(set, new(Int32, 2)), "Value should not have been present");
+    ASSERT_TRUE(cset_put_if_absent(set, new(Int32, 2)), "Value should have been present");
+    ASSERT_TRUE(cset_contains(set, value), "Set should contain value = 2");
+
+    *value = 5;
+    ASSERT_FALSE(cset_contains(set, value), "Set should not contain value = 5");
+    ASSERT_EQUAL(set->length, 1u, "Actual length = %d", set->length);
+
+    String s = format(ConcurrentSet, set);
+    ASSERT_TRUE(str_equals_content(s, "ConcurrentSet<Int32>{2}"), "Actual: %s", s->slice);
+
+    del(String, s);
+    del(Int32, value);
+    del(ConcurrentSet, set);
+});
+
+TEST(test_concurrent_set_capacity, {
+    ConcurrentSet set = new(ConcurrentSet, 100, class(Int32));
+    ASSERT_TRUE(set->capacity >= 100, "Actual capacity = %d", set->capacity);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        cset_put_if_absent(set, new(Int32, i));
+    }
+    ASSERT_EQUAL(set->length, 100u, "Actual length = %d", set->length);
+    del(ConcurrentSet, set);
+});
+
+typedef struct
+{
+    ConcurrentSet set;
+    uint32_t id;
+    uint32_t inserted; // The number of values this thread inserted
+} TestConcurrentSetThread;
+
+// Every thread inserts the same values, starting from a different offset, and checks each is present after inserting it
+static void* test_concurrent_set_thread(void* arg)
+{
+    TestConcurrentSetThread* thread = arg;
+    Int32 query = new(Int32, 0);
+    for (uint32_t i = 0; i < TEST_CSET_VALUES; i++)
+    {
+        int32_t value = (int32_t) ((i + thread->id * (TEST_CSET_VALUES / TEST_CSET_THREADS)) % TEST_CSET_VALUES);
+        thread->inserted += !cset_put_if_absent(thread->set, new(Int32, value));
+        *query = value;
+        if (!cset_contains(thread->set, query))
+        {
+            thread->inserted = UINT32_MAX / 2; // Fails the test
+        }
+    }
+    del(Int32, query);
+    return NULL;
+}
+
+TEST(test_concurrent_set_stress, {
+    for (uint32_t round = 0; round < 10; round++)
+    {
+        ConcurrentSet set = new(ConcurrentSet, TEST_CSET_VALUES, class(Int32));
+        pthread_t threads[TEST_CSET_THREADS];
+        TestConcurrentSetThread args[TEST_CSET_THREADS];
+
+        for (uint32_t i = 0; i < TEST_CSET_THREADS; i++)
+        {
+            args[i] = (TestConcurrentSetThread) { set, i, 0 };
+            pthread_create(&threads[i], NULL, test_concurrent_set_thread, &args[i]);
+        }
+
+        uint32_t inserted = 0;
+        for (uint32_t i = 0; i < TEST_CSET_THREADS; i++)
+        {
+            pthread_join(threads[i], NULL);
+            inserted += args[i].inserted;
+        }
+
+        // Each value was inserted by exactly one thread
+        ASSERT_EQUAL(inserted, (uint32_t) TEST_CSET_VALUES, "Round = %d, inserted = %d", round, inserted);
+        ASSERT_EQUAL(set->length, (uint32_t) TEST_CSET_VALUES, "Round = %d, length = %d", round, set->length);
+
+        uint32_t iterated = 0;
+        for iter(ConcurrentSet, it, set)
+        {
+            iterated++;
+        }
+        ASSERT_EQUAL(iterated, (uint32_t) TEST_CSET_VALUES, "Round = %d, iterated = %d", round, iterated);
+        del(ConcurrentSet, set);
+    }
+});
+
+// Every thread inserts the same values, which exactly fill the set, and then checks values which are not present
+static void* test_concurrent_set_full_thread(void* arg)
+{
+    TestConcurrentSetThread* thread = arg;
+    Int32 query = new(Int32, 0);
+    for (uint32_t i = 0; i < thread->set->capacity; i++)
+    {
+        int32_t value = (int32_t) ((i + thread->id) % thread->set->capacity);
+        thread->inserted += !cset_put_if_absent(thread->set, new(Int32, value));
+    }
+    for (int32_t i = 0; i < 100; i++)
+    {
+        *query = -1 - i;
+        if (cset_contains(thread->set, query))
+        {
+            thread->inserted = UINT32_MAX / 2; // Fails the test
+        }
+    }
+    del(Int32, query);
+    return NULL;
+}
+
+TEST(test_concurrent_set_full, {
+    // A small set, which threads race to fill to exactly it's capacity, should never hold more values than that
+    for (uint32_t round = 0; round < 200; round++)
+    {
+        ConcurrentSet set = new(ConcurrentSet, 10, class(Int32));
+        pthread_t threads[TEST_CSET_THREADS];
+        TestConcurrentSetThread args[TEST_CSET_THREADS];
+
+        for (uint32_t i = 0; i < TEST_CSET_THREADS; i++)
+        {
+            args[i] = (TestConcurrentSetThread) { set, i, 0 };
+            pthread_create(&threads[i], NULL, test_concurrent_set_full_thread, &args[i]);
+        }
+
+        uint32_t inserted = 0;
+        for (uint32_t i = 0; i < TEST_CSET_THREADS; i++)
+        {
+            pthread_join(threads[i], NULL);
+            inserted += args[i].inserted;
+        }
+
+        ASSERT_EQUAL(inserted, set->capacity, "Round = %d, inserted = %d", round, inserted);
+        ASSERT_EQUAL(set->length, set->capacity, "Round = %d, length = %d", round, set->length);
+        ASSERT_EQUAL(set->reserved, set->capacity, "Round = %d, reserved = %d", round, set->reserved);
+        del(ConcurrentSet, set);
+    }
+});
+
+TEST_GROUP(test_concurrent_set, {
+    test_concurrent_set_put_contains();
+    test_concurrent_set_capacity();
+    test_concurrent_set_stress();
+    test_concurrent_set_full();
+});
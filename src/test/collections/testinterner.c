@@ -0,0 +1,87 @@
+#include "../unittest.h"
+
+TEST(test_interner_new, {
+    Interner interner = new(Interner, 10, class(String));
+    ASSERT_EQUAL(interner->length, 0u, "Actual length = %d", interner->length);
+    del(Interner, interner);
+});
+
+TEST(test_interner_put_get, {
+    Interner interner = new(Interner, 10, class(String));
+
+    ASSERT_EQUAL(intern_put(interner, new(String, "one")), 0u, "First value should have id 0");
+    ASSERT_EQUAL(intern_put(interner, new(String, "two")), 1u, "Second value should have id 1");
+    ASSERT_EQUAL(intern_put(interner, new(String, "one")), 0u, "Equal value should have the same id");
+    ASSERT_EQUAL(interner->length, 2u, "Actual length = %d", interner->length);
+
+    String one = intern_get(interner, 0), two = intern_get(interner, 1);
+    ASSERT_TRUE(str_equals_content(one, "one"), "Actual: '%s'", one->slice);
+    ASSERT_TRUE(str_equals_content(two, "two"), "Actual: '%s'", two->slice);
+
+    del(Interner, interner);
+});
+
+TEST(test_interner_find, {
+    Interner interner = new(Interner, 10, class(String));
+    String one = new(String, "one"), two = new(String, "two");
+
+    intern_put(interner, copy(String, one));
+    Result(uint32_t) found = intern_find(interner, one), missing = intern_find(interner, two);
+    ASSERT_TRUE(is_ok(found), "'one' should be found");
+    ASSERT_EQUAL(unwrap(found), 0u, "Actual id = %d", unwrap(found));
+    ASSERT_TRUE(is_err(missing), "'two' should not be found");
+    ASSERT_EQUAL(interner->length, 1u, "Finding should not intern. Actual length = %d", interner->length);
+
+    del(String, one);
+    del(String, two);
+    del(Interner, interner);
+});
+
+TEST(test_interner_format, {
+    Interner interner = new(Interner, 10, class(Int32));
+
+    String s1 = format(Interner, interner);
+    ASSERT_TRUE(str_equals_content(s1, "Interner<Int32>{}"), "Actual: '%s'", s1->slice);
+    del(String, s1);
+
+    intern_put(interner, new(Int32, 7));
+    intern_put(interner, new(Int32, 3));
+    intern_put(interner, new(Int32, 7));
+    String s2 = format(Interner, interner);
+    ASSERT_TRUE(str_equals_content(s2, "Interner<Int32>{0: 7, 1: 3}"), "Actual: '%s'", s2->slice);
+    del(String, s2);
+
+    del(Interner, interner);
+});
+
+TEST(test_interner_resize, {
+    // Starts too small, so both the values and the index are resized many times
+    Interner interner = new(Interner, 1, class(Int32));
+    for (int32_t round = 0; round < 2; round++)
+    {
+        for (int32_t i = 0; i < 10000; i++)
+        {
+            uint32_t id = intern_put(interner, new(Int32, i * 7));
+            ASSERT_EQUAL(id, (uint32_t) i, "Value %d: Actual id = %d", i * 7, id);
+        }
+    }
+    ASSERT_EQUAL(interner->length, 10000u, "Actual length = %d", interner->length);
+
+    uint32_t count = 0;
+    for iter(Interner, it, interner)
+    {
+        ASSERT_EQUAL(*(Int32) it.value, (int32_t) it.index * 7, "Id %d: Actual value = %d", it.index, *(Int32) it.value);
+        count++;
+    }
+    ASSERT_EQUAL(count, 10000u, "Actual count = %d", count);
+
+    del(Interner, interner);
+});
+
+TEST_GROUP(test_interner, {
+    test_interner_new();
+    test_interner_put_get();
+    test_interner_find();
+    test_interner_format();
+    test_interner_resize();
+});
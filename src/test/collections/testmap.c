@@ -98,6 +98,668 @@ TEST(test_map_stress, {
     del(Map, map);
 });
 
+TEST(test_map_robin_hood_put_get, {
+    Map map = new(Map, 10, class(Int32), class(Int32), HASH_ROBIN_HOOD);
+
+    // Keys which all share the same home index, and keys with adjacent home indexes, in order to build a single long cluster
+    for (int32_t i = 0; i < 6; i++)
+    {
+        map_put(map, new(Int32, i * 64), new(Int32, i));
+        map_put(map, new(Int32, i + 1), new(Int32, -i));
+    }
+
+    ASSERT_EQUAL(map->length, 12, "Actual length = %d", map->length);
+    for (int32_t i = 0; i < 6; i++)
+    {
+        Int32 key = new(Int32, i * 64);
+        Int32 value = map_get(map, key);
+        ASSERT_TRUE(value != NULL && *value == i, "Expected to get val = %d from key = %d", i, *key);
+        *key = i + 1;
+        value = map_get(map, key);
+        ASSERT_TRUE(value != NULL && *value == -i, "Expected to get val = %d from key = %d", -i, *key);
+        *key = i * 64 + 32;
+        ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key = %d", *key);
+        del(Int32, key);
+    }
+
+    del(Map, map);
+});
+
+TEST(test_map_robin_hood_stress, {
+    Map map = new(Map, 2, class(Int32), class(Int32), HASH_ROBIN_HOOD);
+
+    for (int32_t k = 0; k < 10; k++)
+    {
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            for (int32_t j = 0; j < 10; j++)
+            {
+                Int32 key = new(Int32, (i * 16 + 11 * j + 52 * k) % 3000);
+                Int32 value = new(Int32, (i + 10 * j * 19 * k) % 300);
+
+                map_put(map, key, value);
+                Int32 get_value = map_get(map, key);
+
+                ASSERT_TRUE(equals(Int32, get_value, value), "Key = %d, Value = %d, Get Value = %d", *key, *value, *get_value);
+            }
+        }
+        map_clear(map);
+    }
+
+    del(Map, map);
+});
+
+TEST(test_map_linear_stress, {
+    Map map = new(Map, 2, class(Int32), class(Int32), HASH_LINEAR);
+
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        map_put(map, new(Int32, i * 16), new(Int32, i));
+    }
+    ASSERT_EQUAL(map->length, 3000, "Actual length = %d", map->length);
+
+    Int32 key = new(Int32, 0);
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        *key = i * 16;
+        Int32 value = map_get(map, key);
+        ASSERT_TRUE(value != NULL && *value == i, "Expected to get val = %d from key = %d", i, *key);
+        *key = i * 16 + 1;
+        ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key = %d", *key);
+    }
+
+    del(Int32, key);
+    del(Map, map);
+});
+
+TEST(test_map_swiss_groups, {
+    Map map = new(Map, 16, class(Int32), class(Int32), HASH_SWISS);
+
+    // Enough keys to span many groups, and to force several resizes
+    for (int32_t i = 0; i < 5000; i++)
+    {
+        map_put(map, new(Int32, i * 7), new(Int32, i));
+    }
+    ASSERT_EQUAL(map->length, 5000, "Actual length = %d", map->length);
+    ASSERT_TRUE(map->length < map->size * HASH_SWISS_LOAD_FACTOR, "Map should have resized, size = %d", map->size);
+
+    Int32 key = new(Int32, 0);
+    for (int32_t i = 0; i < 5000; i++)
+    {
+        *key = i * 7;
+        Int32 value = map_get(map, key);
+        ASSERT_TRUE(value != NULL && *value == i, "Expected to get val = %d from key = %d", i, *key);
+        *key = i * 7 + 3;
+        ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key = %d", *key);
+    }
+
+    map_clear(map);
+    ASSERT_EQUAL(map->length, 0, "Actual length = %d", map->length);
+    *key = 0;
+    ASSERT_FALSE(map_contains_key(map, key), "Map should be empty after clear");
+
+    del(Int32, key);
+    del(Map, map);
+});
+
+TEST(test_map_incremental_stress, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t e = 0; e < 3; e++)
+    {
+        Map map = new(Map, 2, class(Int32), class(Int32), engines[e] | HASH_INCREMENTAL);
+        Int32 key = new(Int32, 0);
+
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            map_put(map, new(Int32, i * 16), new(Int32, i));
+
+            // Query keys both already migrated and not, and replace some while they may be in the previous map
+            *key = (i * 7) % (i + 1) * 16;
+            Int32 value = map_get(map, key);
+            ASSERT_TRUE(value != NULL && *value == *key / 16, "Expected to get val = %d from key = %d", *key / 16, *key);
+            if (i % 5 == 0)
+            {
+                map_put(map, new(Int32, *key), new(Int32, *key / 16));
+            }
+        }
+        ASSERT_EQUAL(map->length, 3000, "Actual length = %d", map->length);
+
+        // Iteration must cover keys in both the map and any previous map
+        uint32_t count = 0;
+        for iter(Map, it, map)
+        {
+            ASSERT_EQUAL(*(Int32) it.key, *(Int32) it.value * 16, "Key = %d, Value = %d", *(Int32) it.key, *(Int32) it.value);
+            count++;
+        }
+        ASSERT_EQUAL(count, 3000, "Iterated count = %d", count);
+
+        // Lookups never migrate keys
+        Map previous = map->previous;
+        uint32_t migrated = map->migrated;
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            *key = i * 16;
+            Int32 value = map_get(map, key);
+            ASSERT_TRUE(value != NULL && *value == i, "Expected to get val = %d from key = %d", i, *key);
+            *key = i * 16 + 1;
+            ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key = %d", *key);
+        }
+        ASSERT_TRUE(map->previous == previous && map->migrated == migrated, "Lookups should not migrate keys");
+
+        // Clear during a migration
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            map_put(map, new(Int32, i), new(Int32, i));
+        }
+        map_clear(map);
+        ASSERT_EQUAL(map->length, 0, "Actual length = %d", map->length);
+        ASSERT_TRUE(map->previous == NULL, "Map should not be migrating after clear");
+
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_incremental_iterate, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_BLOOM };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        Map map = new(Map, 2, class(Int32), class(Int32), engines[e] | HASH_INCREMENTAL);
+        Int32 key = new(Int32, 0);
+
+        // Fill until the map has just started migrating, so keys are split between both maps
+        int32_t length = 0;
+        while (length < 1000 || map->previous == NULL)
+        {
+            map_put(map, new(Int32, length), new(Int32, length));
+            length++;
+        }
+
+        // Looking up keys while iterating must not move keys under the iterator
+        uint32_t* visits = safe_calloc(sizeof(uint32_t) * length);
+        for iter(Map, it, map)
+        {
+            int32_t k = *(Int32) it.key;
+            ASSERT_TRUE(k >= 0 && k < length, "Unexpected key = %d", k);
+            visits[k]++;
+
+            *key = length - 1 - k;
+            Int32 value = map_get(map, key);
+            ASSERT_TRUE(value != NULL && *value == *key, "Expected to get val = %d from key = %d", *key, *key);
+            ASSERT_TRUE(map_contains_key(map, key), "Map should contain key = %d", *key);
+            *key = length + k;
+            ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key = %d", *key);
+        }
+        ASSERT_TRUE(map->previous != NULL, "Map should still be migrating");
+        for (int32_t k = 0; k < length; k++)
+        {
+            ASSERT_EQUAL(visits[k], 1u, "Key = %d was visited %d times", k, visits[k]);
+        }
+
+        free(visits);
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_incremental_format, {
+    Map map = new(Map, 4, class(Int32), class(Int32), HASH_LINEAR | HASH_INCREMENTAL);
+    map_put(map, new(Int32, 1), new(Int32, 1));
+    map_put(map, new(Int32, 2), new(Int32, 2));
+    map_put(map, new(Int32, 3), new(Int32, 3)); // Starts migrating the keys 1 and 2 to a map of size 8
+
+    ASSERT_TRUE(map->previous != NULL, "Map should be migrating");
+
+    String s = format(Map, map);
+    ASSERT_TRUE(str_equals_content(s, "Map<Int32, Int32>{3: 3, 1: 1, 2: 2}"), "Actual: '%s'", s->slice);
+    del(String, s);
+    del(Map, map);
+});
+
+TEST(test_map_remove, {
+    Map map = new(Map, 16, class(Int32), class(Int32));
+    map_put(map, new(Int32, 1), new(Int32, 10));
+    map_put(map, new(Int32, 2), new(Int32, 20));
+
+    Int32 key = new(Int32, 1);
+    pointer_t removed_key = NULL, removed_value = NULL;
+
+    ASSERT_TRUE(map_remove(map, key, &removed_key, &removed_value), "Key 1 should be removed");
+    ASSERT_TRUE(removed_key != key && *(Int32) removed_key == 1, "Removed key should be the key from the map");
+    ASSERT_EQUAL(*(Int32) removed_value, 10, "Removed value = %d", *(Int32) removed_value);
+    ASSERT_EQUAL(map->length, 1, "Actual length = %d", map->length);
+    ASSERT_FALSE(map_contains_key(map, key), "Map should not contain key 1");
+    ASSERT_FALSE(map_remove(map, key, NULL, NULL), "Key 1 should not be removed twice");
+
+    *key = 2;
+    ASSERT_TRUE(map_remove(map, key, NULL, NULL), "Key 2 should be removed, and deleted");
+    ASSERT_EQUAL(map->length, 0, "Actual length = %d", map->length);
+
+    del(Int32, removed_key);
+    del(Int32, removed_value);
+    del(Int32, key);
+    del(Map, map);
+});
+
+TEST(test_map_remove_churn, {
+    HashOptions options[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_LINEAR | HASH_INCREMENTAL, HASH_ROBIN_HOOD | HASH_INCREMENTAL, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t o = 0; o < 6; o++)
+    {
+        // Keys are drawn from a small range, with a identity hash, so removals shift keys within long clusters
+        Map map = new(Map, 16, class(Int32), class(Int32), options[o]);
+        bool present[600] = { false };
+        uint32_t length = 0;
+        Int32 key = new(Int32, 0);
+
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            *key = (int32_t) rand_uint32_in(600);
+            if (rand_uint32_in(2) == 0)
+            {
+                bool removed = map_remove(map, key, NULL, NULL);
+                ASSERT_EQUAL(removed, present[*key], "Remove key = %d, expected %d", *key, present[*key]);
+                length -= present[*key];
+                present[*key] = false;
+            }
+            else
+            {
+                length += !present[*key];
+                present[*key] = true;
+                map_put(map, new(Int32, *key), new(Int32, *key));
+            }
+        }
+        ASSERT_EQUAL(map->length, length, "Actual length = %d, expected = %d", map->length, length);
+
+        for (int32_t i = 0; i < 600; i++)
+        {
+            *key = i;
+            Int32 value = map_get(map, key);
+            ASSERT_EQUAL(value != NULL, present[i], "Key = %d, expected present = %d", i, present[i]);
+            ASSERT_TRUE(value == NULL || *value == i, "Key = %d, Value = %d", i, *value);
+        }
+
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_entry, {
+    Map map = new(Map, 16, class(Int32), class(Int32));
+    Int32 key = new(Int32, 3);
+
+    MapEntry entry = map_entry(map, key);
+    ASSERT_FALSE(entry.occupied, "Expected a vacant entry");
+    ASSERT_TRUE(map_entry_value(&entry) == NULL, "Expected no value for a vacant entry");
+
+    pointer_t* value = map_entry_insert(&entry, new(Int32, 30)); // Key ownership is given to the map
+    ASSERT_TRUE(entry.occupied, "Expected an occupied entry after insert");
+    ASSERT_EQUAL(*(Int32) *value, 30, "Actual value = %d", *(Int32) *value);
+
+    key = new(Int32, 3);
+    entry = map_entry(map, key);
+    ASSERT_TRUE(entry.occupied, "Expected an occupied entry");
+    value = map_entry_value(&entry);
+    *(Int32) *value += 1; // Update the boxed value in place
+    del(Int32, *value);
+    *value = new(Int32, 40); // Replace the value
+    del(Int32, key);
+
+    key = new(Int32, 3);
+    Int32 actual = map_get(map, key);
+    ASSERT_EQUAL(*actual, 40, "Actual value = %d", *actual);
+    ASSERT_EQUAL(map->length, 1u, "Actual length = %d", map->length);
+    del(Int32, key);
+
+    del(Map, map);
+});
+
+TEST(test_map_get_or_insert, {
+    HashOptions options[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_LINEAR | HASH_INCREMENTAL, HASH_ROBIN_HOOD | HASH_INCREMENTAL, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t o = 0; o < 6; o++)
+    {
+        // Counts occurrences of keys, drawn from a small range, with some removals, so entries are filled across resizes and within long clusters
+        Map map = new(Map, 2, class(Int32), class(Int32), options[o]);
+        int32_t counts[500] = { 0 };
+        Int32 key = new(Int32, 0);
+
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            int32_t k = (int32_t) rand_uint32_in(500);
+            if (rand_uint32_in(8) == 0)
+            {
+                *key = k;
+                map_remove(map, key, NULL, NULL);
+                counts[k] = 0;
+            }
+            else
+            {
+                Int32 count = map_get_or_insert(map, new(Int32, k), new(Int32, 0));
+                (*count)++;
+                counts[k]++;
+            }
+        }
+
+        uint32_t length = 0;
+        for (int32_t i = 0; i < 500; i++)
+        {
+            *key = i;
+            Int32 value = map_get(map, key);
+            ASSERT_EQUAL(value != NULL, counts[i] > 0, "Key = %d, expected count = %d", i, counts[i]);
+            ASSERT_TRUE(value == NULL || *value == counts[i], "Key = %d, Value = %d, expected count = %d", i, *value, counts[i]);
+            length += counts[i] > 0;
+        }
+        ASSERT_EQUAL(map->length, length, "Actual length = %d, expected = %d", map->length, length);
+
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_hashed, {
+    HashOptions options[] = { HASH_LINEAR, HASH_SWISS | HASH_SEEDED, HASH_ROBIN_HOOD | HASH_INCREMENTAL | HASH_BLOOM };
+    for (uint32_t o = 0; o < 3; o++)
+    {
+        // Keys put with a pre-computed hash are found by the plain methods, and vice versa
+        Map map = new(Map, 2, class(Int32), class(Int32), options[o]);
+        Int32 key = new(Int32, 0);
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            Int32 k = new(Int32, i);
+            if (i % 2 == 0)
+            {
+                map_put_hashed(map, k, new(Int32, i * 3), hash_c(class(Int32), k));
+            }
+            else
+            {
+                map_put(map, k, new(Int32, i * 3));
+            }
+        }
+        ASSERT_EQUAL(map->length, 1000u, "Actual length = %d", map->length);
+
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            *key = i;
+            Int32 value = map_get_hashed(map, key, hash_c(class(Int32), key));
+            ASSERT_TRUE(value != NULL && *value == i * 3, "Key = %d", i);
+            ASSERT_TRUE(map_contains_key(map, key), "Key = %d", i);
+        }
+
+        for (int32_t i = 0; i < 1000; i += 3)
+        {
+            *key = i;
+            ASSERT_TRUE(map_remove_hashed(map, key, hash_c(class(Int32), key), NULL, NULL), "Key = %d", i);
+            ASSERT_FALSE(map_contains_key_hashed(map, key, hash_c(class(Int32), key)), "Key = %d", i);
+        }
+        ASSERT_EQUAL(map->length, 666u, "Actual length = %d", map->length);
+
+        *key = 1;
+        Int32 value = map_get_or_insert_hashed(map, new(Int32, 1), new(Int32, 0), hash_c(class(Int32), key));
+        ASSERT_EQUAL(*value, 3, "Actual value = %d", *value);
+
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_reserve, {
+    Map map = new(Map, 2, class(Int32), class(Int32));
+    map_reserve(map, 1000);
+    uint32_t size = map->size;
+    ASSERT_TRUE(size >= 1000, "Actual size = %d", size);
+
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        map_put(map, new(Int32, i), new(Int32, i));
+    }
+    ASSERT_EQUAL(map->size, size, "Expected no resize, actual size = %d, reserved size = %d", map->size, size);
+
+    map_reserve(map, 10); // Never shrinks
+    ASSERT_EQUAL(map->size, size, "Actual size = %d, reserved size = %d", map->size, size);
+    del(Map, map);
+});
+
+// Builds a map from arrays of keys drawn from a range, including duplicates, where each value is the index of the key.
+// The last value for each key must be kept. Above HASH_PARALLEL_THRESHOLD keys, this uses the parallel path.
+static bool test_map_from_arrays_with(uint32_t length, int32_t range, HashOptions options)
+{
+    pointer_t* keys = safe_malloc(sizeof(pointer_t) * length);
+    pointer_t* values = safe_malloc(sizeof(pointer_t) * length);
+    int32_t* last = safe_malloc(sizeof(int32_t) * range);
+    uint32_t distinct = 0;
+    for (int32_t i = 0; i < range; i++)
+    {
+        last[i] = -1;
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        int32_t k = (int32_t) rand_uint32_in(range);
+        distinct += last[k] == -1;
+        last[k] = (int32_t) i;
+        keys[i] = new(Int32, k);
+        values[i] = new(Int32, (int32_t) i);
+    }
+
+    Map map = map_from_arrays(length, keys, values, class(Int32), class(Int32), options);
+    ASSERT_EQUAL(map->length, distinct, "Options = %d, Actual length = %d, expected = %d", options, map->length, distinct);
+
+    uint32_t iterated = 0;
+    for iter(Map, it, map)
+    {
+        iterated++;
+    }
+    ASSERT_EQUAL(iterated, distinct, "Options = %d, Iterated = %d, expected = %d", options, iterated, distinct);
+
+    Int32 key = new(Int32, 0);
+    for (int32_t i = 0; i < range; i++)
+    {
+        *key = i;
+        Int32 value = map_get(map, key);
+        ASSERT_EQUAL(value != NULL, last[i] != -1, "Options = %d, Key = %d, expected present = %d", options, i, last[i] != -1);
+        ASSERT_TRUE(value == NULL || *value == last[i], "Options = %d, Key = %d, Value = %d, expected = %d", options, i, *value, last[i]);
+    }
+    del(Int32, key);
+
+    del(Map, map);
+    free(keys);
+    free(values);
+    free(last);
+    return true;
+}
+
+TEST(test_map_from_arrays, {
+    HashOptions options[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t o = 0; o < 4; o++)
+    {
+        ASSERT_TRUE(test_map_from_arrays_with(0, 10, options[o]), "Empty arrays");
+        ASSERT_TRUE(test_map_from_arrays_with(1000, 300, options[o]), "Small arrays");
+        ASSERT_TRUE(test_map_from_arrays_with(HASH_PARALLEL_THRESHOLD + 5000, HASH_PARALLEL_THRESHOLD, options[o]), "Large arrays");
+    }
+});
+
+TEST(test_map_parallel_rehash, {
+    HashOptions options[] = { HASH_LINEAR, HASH_SWISS };
+    for (uint32_t o = 0; o < 2; o++)
+    {
+        // Grows past HASH_PARALLEL_THRESHOLD keys, so the last resizes place keys in parallel
+        // Keys are multiples of a large power of two, so linear probing has long clusters, which cross regions
+        Map map = new(Map, 16, class(Int32), class(Int32), options[o]);
+        uint32_t count = 2 * HASH_PARALLEL_THRESHOLD;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            int32_t k = (int32_t) (i < count / 2 ? i : (i << 12));
+            map_put(map, new(Int32, k), new(Int32, k));
+        }
+        ASSERT_EQUAL(map->length, count, "Actual length = %d, expected = %d", map->length, count);
+
+        Int32 key = new(Int32, 0);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            *key = (int32_t) (i < count / 2 ? i : (i << 12));
+            Int32 value = map_get(map, key);
+            ASSERT_TRUE(value != NULL && *value == *key, "Key = %d not found", *key);
+        }
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_reusable_clear, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        Map map = new(Map, 16, class(Int32), class(Int32), engines[e] | HASH_REUSABLE);
+        Int32 key = new(Int32, 0);
+
+        // Grow the map first, which fills more slots than the log can hold, so the first clear visits every slot
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            map_put(map, new(Int32, i), new(Int32, i));
+        }
+        map_clear(map);
+        ASSERT_EQUAL(map->length, 0u, "Actual length = %d", map->length);
+
+        for (int32_t round = 0; round < 200; round++)
+        {
+            // Colliding keys, some of which are removed and replaced, which moves keys between slots
+            for (int32_t i = 0; i < 20; i++)
+            {
+                map_put(map, new(Int32, i * 4096 + round), new(Int32, i));
+            }
+            for (int32_t i = 0; i < 20; i += 3)
+            {
+                *key = i * 4096 + round;
+                ASSERT_TRUE(map_remove(map, key, NULL, NULL), "Key = %d should be removed", *key);
+                map_put(map, new(Int32, i * 4096 + round + 1), new(Int32, i));
+            }
+            ASSERT_TRUE(map->filled_length != UINT32_MAX, "The log should not overflow in round %d", round);
+
+            map_clear(map);
+            ASSERT_EQUAL(map->length, 0u, "Actual length = %d", map->length);
+            ASSERT_EQUAL(map->filled_length, 0u, "Actual filled length = %d", map->filled_length);
+            for (int32_t i = 0; i < 20; i++)
+            {
+                *key = i * 4096 + round;
+                ASSERT_FALSE(map_contains_key(map, key), "Key = %d should be cleared", *key);
+                *key += 1;
+                ASSERT_FALSE(map_contains_key(map, key), "Key = %d should be cleared", *key);
+            }
+        }
+
+        // Every slot should be empty, including those not visited by the last clears
+        uint32_t count = 0;
+        for iter(Map, it, map)
+        {
+            count++;
+        }
+        ASSERT_EQUAL(count, 0u, "Iterated count = %d", count);
+
+        del(Int32, key);
+        del(Map, map);
+    }
+});
+
+TEST(test_map_bloom, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        Map map = new(Map, 16, class(Int32), class(Int32), engines[e] | HASH_BLOOM);
+        Int32 key = new(Int32, 0);
+
+        // Grows several times, which rebuilds the filter
+        for (int32_t i = 0; i < 20000; i++)
+        {
+            map_put(map, new(Int32, 2 * i), new(Int32, i));
+        }
+
+        // Every present key passes the filter, and most missing keys are rejected by it
+        for (int32_t i = 0; i < 40000; i++)
+        {
+            *key = i;
+            bool even = i % 2 == 0;
+            ASSERT_EQUAL(map_contains_key(map, key), even, "Key = %d", i);
+        }
+        HashBloomStats stats = map_bloom_stats(map);
+        ASSERT_EQUAL(stats.lookups, 40000ul, "Actual lookups = %lu", stats.lookups);
+        ASSERT_EQUAL(stats.rejected + stats.false_positives, 20000ul, "Actual rejected = %lu, false positives = %lu", stats.rejected, stats.false_positives);
+        ASSERT_TRUE(stats.false_positive_rate < 0.1, "Actual false positive rate = %.3f", stats.false_positive_rate);
+        ASSERT_TRUE(stats.bytes > 0, "Actual bytes = %lu", stats.bytes);
+
+        // Removed keys stay in the filter, but are still missing
+        for (int32_t i = 0; i < 20000; i += 2)
+        {
+            *key = 2 * i;
+            ASSERT_TRUE(map_remove(map, key, NULL, NULL), "Key = %d should be removed", *key);
+        }
+        for (int32_t i = 0; i < 20000; i++)
+        {
+            *key = 2 * i;
+            bool removed = i % 2 == 0;
+            ASSERT_EQUAL(map_get(map, key) == NULL, removed, "Key = %d", *key);
+        }
+
+        map_clear(map);
+        *key = 2;
+        ASSERT_FALSE(map_contains_key(map, key), "Map should be empty");
+        ASSERT_EQUAL(map_bloom_stats(map).rejected, stats.rejected + 1, "A lookup in an empty map should be rejected");
+
+        del(Int32, key);
+        del(Map, map);
+    }
+
+    Map map = new(Map, 16, class(Int32), class(Int32));
+    Int32 key = new(Int32, 0);
+    map_contains_key(map, key);
+    ASSERT_EQUAL(map_bloom_stats(map).lookups, 0ul, "Without a filter, no lookups are counted");
+    del(Int32, key);
+    del(Map, map);
+});
+
+TEST(test_map_stats, {
+    // Int32 hashes are the identity, so distinct keys in [0, 100) each sit in their home slot, in one cluster
+    Map map = new(Map, 256, class(Int32), class(Int32), HASH_LINEAR);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        map_put(map, new(Int32, i), new(Int32, i));
+    }
+    HashStats stats = map_stats(map);
+    ASSERT_EQUAL(stats.length, 100u, "Actual length = %u", stats.length);
+    ASSERT_EQUAL(stats.capacity, 256u, "Actual capacity = %u", stats.capacity);
+    ASSERT_TRUE(stats.load_factor == 100.0 / 256, "Actual load factor = %.3f", stats.load_factor);
+    ASSERT_TRUE(stats.mean_probe_length == 1.0, "Actual mean probe length = %.3f", stats.mean_probe_length);
+    ASSERT_EQUAL(stats.max_probe_length, 1u, "Actual max probe length = %u", stats.max_probe_length);
+    ASSERT_EQUAL(stats.clusters[6], 1u, "A single cluster of 64 - 127 keys, actual = %u", stats.clusters[6]);
+    ASSERT_EQUAL(stats.rehashes, 0u, "Actual rehashes = %u", stats.rehashes);
+    ASSERT_EQUAL(stats.bytes, sizeof(struct Map__struct) + 256 * sizeof(MapSlot), "Actual bytes = %lu", stats.bytes);
+    del(Map, map);
+
+    // Multiples of the capacity all have the same home slot, as with a poor hash(), so the nth key is found after probing n slots
+    map = new(Map, 256, class(Int32), class(Int32), HASH_LINEAR);
+    for (int32_t i = 0; i < 100; i++)
+    {
+        map_put(map, new(Int32, 256 * i), new(Int32, i));
+    }
+    stats = map_stats(map);
+    ASSERT_TRUE(stats.mean_probe_length == 50.5, "Actual mean probe length = %.3f", stats.mean_probe_length);
+    ASSERT_EQUAL(stats.max_probe_length, 100u, "Actual max probe length = %u", stats.max_probe_length);
+    del(Map, map);
+
+    // Each doubling of the capacity from 16 is a rehash, with every engine
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        map = new(Map, 16, class(Int32), class(Int32), engines[e]);
+        for (int32_t i = 0; i < 100; i++)
+        {
+            map_put(map, new(Int32, i), new(Int32, i));
+        }
+        stats = map_stats(map);
+        ASSERT_EQUAL(stats.rehashes, (uint32_t) __builtin_ctz(stats.capacity / 16), "Actual rehashes = %u, capacity = %u", stats.rehashes, stats.capacity);
+        ASSERT_TRUE(stats.mean_probe_length >= 1.0, "Actual mean probe length = %.3f", stats.mean_probe_length);
+        ASSERT_TRUE(stats.max_probe_length >= 1, "Actual max probe length = %u", stats.max_probe_length);
+        del(Map, map);
+    }
+});
+
 TEST_GROUP(test_map, {
     test_map_new();
     test_map_put_get();
@@ -106,4 +768,23 @@ TEST_GROUP(test_map, {
     test_map_format();
 
     test_map_stress();
+
+    test_map_robin_hood_put_get();
+    test_map_robin_hood_stress();
+    test_map_linear_stress();
+    test_map_swiss_groups();
+    test_map_incremental_stress();
+    test_map_incremental_iterate();
+    test_map_incremental_format();
+    test_map_remove();
+    test_map_remove_churn();
+    test_map_entry();
+    test_map_get_or_insert();
+    test_map_hashed();
+    test_map_reserve();
+    test_map_from_arrays();
+    test_map_parallel_rehash();
+    test_map_reusable_clear();
+    test_map_bloom();
+    test_map_stats();
 });
\ No newline at end of file
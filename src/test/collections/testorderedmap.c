@@ -0,0 +1,162 @@
+#include "../unittest.h"
+
+TEST(test_ordered_map_new, {
+    OrderedMap map = new(OrderedMap, 10, class(Int32), class(String));
+    del(OrderedMap, map);
+});
+
+TEST(test_ordered_map_put_get, {
+    OrderedMap map = new(OrderedMap, 10, class(Int32), class(String));
+    Int32 key = new(Int32, 2);
+    Int32 bad_key = new(Int32, 5);
+
+    ASSERT_FALSE(omap_put(map, copy(Int32, key), new(String, "two")), "Key should not be present");
+    ASSERT_TRUE(omap_contains_key(map, key), "Map should contain key = 2");
+    ASSERT_FALSE(omap_contains_key(map, bad_key), "Map should not contain key = 5");
+    ASSERT_TRUE(str_equals_content(omap_get(map, key), "two"), "Actual: '%s'", ((String) omap_get(map, key))->slice);
+    ASSERT_TRUE(omap_get(map, bad_key) == NULL, "Missing key should have a NULL value");
+
+    del(Int32, key);
+    del(Int32, bad_key);
+    del(OrderedMap, map);
+});
+
+TEST(test_ordered_map_format, {
+    OrderedMap map = new(OrderedMap, 10, class(Int32), class(Int32));
+
+    String s1 = format(OrderedMap, map);
+    ASSERT_TRUE(str_equals_content(s1, "OrderedMap<Int32, Int32>{}"), "Actual: '%s'", s1->slice);
+    del(String, s1);
+
+    // Keys are formatted in insertion order, not by hash
+    omap_put(map, new(Int32, 30), new(Int32, 1));
+    omap_put(map, new(Int32, 10), new(Int32, 2));
+    omap_put(map, new(Int32, 20), new(Int32, 3));
+
+    String s2 = format(OrderedMap, map);
+    ASSERT_TRUE(str_equals_content(s2, "OrderedMap<Int32, Int32>{30: 1, 10: 2, 20: 3}"), "Actual: '%s'", s2->slice);
+    del(String, s2);
+
+    // Replacing keeps the position, and removing then putting moves it to the end
+    Int32 key = new(Int32, 30);
+    ASSERT_TRUE(omap_put(map, new(Int32, 10), new(Int32, 4)), "Key = 10 should be replaced");
+    ASSERT_TRUE(omap_remove(map, key, NULL, NULL), "Key = 30 should be removed");
+    omap_put(map, key, new(Int32, 5));
+
+    String s3 = format(OrderedMap, map);
+    ASSERT_TRUE(str_equals_content(s3, "OrderedMap<Int32, Int32>{10: 4, 20: 3, 30: 5}"), "Actual: '%s'", s3->slice);
+    del(String, s3);
+
+    del(OrderedMap, map);
+});
+
+TEST(test_ordered_map_stress, {
+    OrderedMap map = new(OrderedMap, 2, class(Int32), class(Int32));
+    Int32 key = new(Int32, 0);
+
+    // Enough keys to widen the index from 1 to 2 to 4 bytes, with every third key removed again
+    for (int32_t i = 0; i < 100000; i++)
+    {
+        omap_put(map, new(Int32, i), new(Int32, -i));
+        if (i % 3 == 2)
+        {
+            *key = i - 1;
+            ASSERT_TRUE(omap_remove(map, key, NULL, NULL), "Key = %d should be removed", *key);
+        }
+    }
+    ASSERT_EQUAL(map->length, 66667u, "Actual length = %d", map->length);
+    ASSERT_EQUAL(map->width, 4u, "Actual width = %d", map->width);
+
+    for (int32_t i = 0; i < 100000; i++)
+    {
+        *key = i;
+        bool removed = i % 3 == 1;
+        ASSERT_EQUAL(omap_contains_key(map, key), !removed, "Key = %d", i);
+        if (!removed)
+        {
+            ASSERT_EQUAL(*(Int32) omap_get(map, key), -i, "Key = %d", i);
+        }
+    }
+
+    // Iteration is in insertion order
+    int32_t previous = -1;
+    uint32_t count = 0;
+    for iter(OrderedMap, it, map)
+    {
+        ASSERT_TRUE(*(Int32) it.key > previous, "Key = %d after %d", *(Int32) it.key, previous);
+        previous = *(Int32) it.key;
+        count++;
+    }
+    ASSERT_EQUAL(count, map->length, "Iterated count = %d", count);
+
+    del(Int32, key);
+    del(OrderedMap, map);
+});
+
+TEST(test_ordered_map_remove_compacts, {
+    OrderedMap map = new(OrderedMap, 16, class(Int32), class(Int32));
+    for (int32_t i = 0; i < 10000; i++)
+    {
+        omap_put(map, new(Int32, i), new(Int32, i));
+    }
+
+    // Remove all but the last 10 keys, keeping ownership of some
+    Int32 key = new(Int32, 0);
+    for (int32_t i = 0; i < 9990; i++)
+    {
+        *key = i;
+        pointer_t removed_key = NULL, removed_value = NULL;
+        bool keep = i % 2 == 0;
+        ASSERT_TRUE(omap_remove(map, key, keep ? &removed_key : NULL, keep ? &removed_value : NULL), "Key = %d should be removed", i);
+        if (keep)
+        {
+            ASSERT_TRUE(*(Int32) removed_key == i && *(Int32) removed_value == i, "Removed key and value should be from the map");
+            del(Int32, removed_key);
+            del(Int32, removed_value);
+        }
+        ASSERT_TRUE(map->used <= 2 * map->length + 9, "Holes should be compacted, used = %d, length = %d", map->used, map->length);
+    }
+    ASSERT_FALSE(omap_remove(map, key, NULL, NULL), "Key should already be removed");
+    ASSERT_EQUAL(map->length, 10u, "Actual length = %d", map->length);
+    ASSERT_TRUE(map->size <= 64, "Index should shrink, actual size = %d", map->size);
+
+    String s = format(OrderedMap, map);
+    ASSERT_TRUE(str_equals_content(s, "OrderedMap<Int32, Int32>{9990: 9990, 9991: 9991, 9992: 9992, 9993: 9993, 9994: 9994, 9995: 9995, 9996: 9996, 9997: 9997, 9998: 9998, 9999: 9999}"), "Actual: '%s'", s->slice);
+    del(String, s);
+
+    del(Int32, key);
+    del(OrderedMap, map);
+});
+
+TEST(test_ordered_map_clear, {
+    OrderedMap map = new(OrderedMap, 16, class(Int32), class(Int32));
+    Int32 key = new(Int32, 0);
+    for (int32_t k = 0; k < 5; k++)
+    {
+        // Colliding keys, so the index has long clusters to empty
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            omap_put(map, new(Int32, (i * 64 + k) % 3000), new(Int32, i));
+        }
+        omap_clear(map);
+        ASSERT_EQUAL(map->length, 0u, "Actual length = %d", map->length);
+
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            *key = i;
+            ASSERT_FALSE(omap_contains_key(map, key), "Key = %d should be cleared", i);
+        }
+    }
+
+    del(Int32, key);
+    del(OrderedMap, map);
+});
+
+TEST_GROUP(test_ordered_map, {
+    test_ordered_map_new();
+    test_ordered_map_put_get();
+    test_ordered_map_format();
+    test_ordered_map_stress();
+    test_ordered_map_remove_compacts();
+    test_ordered_map_clear();
+});
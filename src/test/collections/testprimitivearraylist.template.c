@@ -59,11 +59,131 @@ TEST(CONCAT3(test_, type, _list_append_get_resize), {
     del(PrimitiveArrayList(type), list);
 });
 
+TEST(CONCAT3(test_, type, _list_reserve_shrink), {
+    PrimitiveArrayList(type) list = new(PrimitiveArrayList(type), 1);
+
+    al_reserve(list, 100);
+    ASSERT_EQUAL(list->size, 100, "Actual size = %d", list->size);
+    al_reserve(list, 10); // Never shrinks
+    ASSERT_EQUAL(list->size, 100, "Actual size = %d", list->size);
+
+    al_append(list, v1);
+    al_append(list, v1);
+    al_shrink_to_fit(list);
+    ASSERT_EQUAL(list->size, 2, "Actual size = %d", list->size);
+    ASSERT_EQUAL(al_get(list, 1), v1, "List value not equal after shrink");
+
+    al_clear(list);
+    al_shrink_to_fit(list);
+    ASSERT_EQUAL(list->size, 1, "Actual size = %d", list->size);
+    al_append(list, v1);
+    al_append(list, v1);
+    ASSERT_EQUAL(list->length, 2, "Actual length = %d", list->length);
+
+    del(PrimitiveArrayList(type), list);
+});
+
+TEST(CONCAT3(test_, type, _list_extend), {
+    type array[] = { v1, v1, v1 };
+    PrimitiveArrayList(type) list = new(PrimitiveArrayList(type), 1);
+    PrimitiveArrayList(type) other = CONCAT3(al_, type, _from_array)(array, 3);
+
+    al_extend_array(list, array, 3);
+    al_extend(list, other);
+    al_extend(list, list); // Extending a list with itself
+    ASSERT_EQUAL(list->length, 12, "Actual length = %d", list->length);
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        ASSERT_EQUAL(al_get(list, i), v1, "List value not equal after extend");
+    }
+
+    del(PrimitiveArrayList(type), list);
+    del(PrimitiveArrayList(type), other);
+});
+
+TEST(CONCAT3(test_, type, _list_reductions), {
+    PrimitiveArrayList(type) list = new(PrimitiveArrayList(type), 10);
+    type low, high;
+
+    ASSERT_EQUAL(al_sum(list), 0, "Sum of an empty list should be 0");
+    ASSERT_FALSE(al_minmax(list, &low, &high), "Minmax of an empty list should be false");
+
+    al_append(list, v1);
+    al_append(list, v1);
+
+    ASSERT_EQUAL(al_sum(list), v1 + v1, "Sum not equal");
+    ASSERT_EQUAL(unwrap(al_min(list)), v1, "Min not equal");
+    ASSERT_EQUAL(unwrap(al_max(list)), v1, "Max not equal");
+    ASSERT_EQUAL(unwrap(al_argmax(list)), 0, "Argmax should be the first maximum");
+    ASSERT_TRUE(al_minmax(list, &low, &high), "Minmax of a list should be true");
+    ASSERT_TRUE(low == v1 && high == v1, "Minmax not equal");
+
+    del(PrimitiveArrayList(type), list);
+});
+
+TEST(CONCAT3(test_, type, _list_search), {
+    // Long enough for several search blocks
+    PrimitiveArrayList(type) list = new(PrimitiveArrayList(type), 10);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        al_append(list, (type) 0);
+    }
+
+    ASSERT_FALSE(al_contains(list, v1), "List should not contain " v1s);
+    ASSERT_EQUAL(al_count(list, v1), 0, "Actual count = %d", al_count(list, v1));
+    ASSERT_EQUAL(unwrap_or(al_index_of(list, v1), 999), 999, "Index of a missing value should be Err");
+    ASSERT_EQUAL(unwrap_or(al_last_index_of(list, v1), 999), 999, "Last index of a missing value should be Err");
+
+    al_set(list, 5, v1);
+    al_set(list, 70, v1);
+    al_set(list, 150, v1);
+
+    ASSERT_TRUE(al_contains(list, v1), "List should contain " v1s);
+    ASSERT_EQUAL(al_count(list, v1), 3, "Actual count = %d", al_count(list, v1));
+    ASSERT_EQUAL(al_count(list, (type) 0), 197, "Actual count = %d", al_count(list, (type) 0));
+    ASSERT_EQUAL(unwrap(al_index_of(list, v1)), 5, "Actual index = %d", unwrap(al_index_of(list, v1)));
+    ASSERT_EQUAL(unwrap(al_last_index_of(list, v1)), 150, "Actual index = %d", unwrap(al_last_index_of(list, v1)));
+
+    al_set(list, 5, (type) 0);
+    al_set(list, 150, (type) 0);
+    ASSERT_EQUAL(unwrap(al_index_of(list, v1)), 70, "Actual index = %d", unwrap(al_index_of(list, v1)));
+    ASSERT_EQUAL(unwrap(al_last_index_of(list, v1)), 70, "Actual index = %d", unwrap(al_last_index_of(list, v1)));
+
+    del(PrimitiveArrayList(type), list);
+});
+
+TEST(CONCAT3(test_, type, _list_sort), {
+    // Both an insertion sort, and a radix sort
+    uint32_t sizes[] = { 10, 100 };
+    for (uint32_t k = 0; k < 2; k++)
+    {
+        PrimitiveArrayList(type) list = new(PrimitiveArrayList(type), 10);
+        for (uint32_t i = 0; i < sizes[k]; i++)
+        {
+            al_append(list, i & 1 ? v1 : (type) 0);
+        }
+
+        al_sort(list);
+        ASSERT_EQUAL(list->length, sizes[k], "Actual length = %d", list->length);
+        for (uint32_t i = 0; i < sizes[k]; i++)
+        {
+            ASSERT_EQUAL(al_get(list, i), i < sizes[k] / 2 ? (type) 0 : v1, "List not sorted at index %d", i);
+        }
+
+        del(PrimitiveArrayList(type), list);
+    }
+});
+
 TEST_GROUP(CONCAT3(test_, type, _list), {
     CONCAT3(test_, type, _list_new)();
     CONCAT3(test_, type, _list_format)();
     CONCAT3(test_, type, _list_append_get)();
     CONCAT3(test_, type, _list_append_get_resize)();
+    CONCAT3(test_, type, _list_reserve_shrink)();
+    CONCAT3(test_, type, _list_extend)();
+    CONCAT3(test_, type, _list_reductions)();
+    CONCAT3(test_, type, _list_search)();
+    CONCAT3(test_, type, _list_sort)();
 });
 
 #undef type
@@ -0,0 +1,89 @@
+#include "../unittest.h"
+
+// Indvidual tests for each primitive map type using templates
+
+#define type char
+#define v1 'A'
+#define v1s "A"
+#define v2 'B'
+#include "testprimitivemap.template.c"
+
+#define type bool
+#define v1 true
+#define v1s "true"
+#define v2 false
+#include "testprimitivemap.template.c"
+
+#define type int32_t
+#define v1 123
+#define v2 -123
+#include "testprimitivemap.template.c"
+
+#define type int64_t
+#define v1 123
+#define v2 -123
+#include "testprimitivemap.template.c"
+
+#define type uint32_t
+#define v1 123
+#define v2 456
+#include "testprimitivemap.template.c"
+
+#define type uint64_t
+#define v1 123
+#define v2 456
+#include "testprimitivemap.template.c"
+
+TEST(test_primitive_map_stress, {
+    PrimitiveMap(int64_t) map = new(PrimitiveMap(int64_t), 16);
+
+    // Enough keys to force several resizes, with removes to leave tombstones
+    for (int64_t i = 0; i < 20000; i++)
+    {
+        pm_put(map, i * 7, i);
+        if (i % 3 == 0)
+        {
+            pm_remove(map, (i / 2) * 7);
+        }
+    }
+
+    uint32_t length = 0;
+    for (int64_t i = 0; i < 20000; i++)
+    {
+        if (pm_contains_key(map, i * 7))
+        {
+            int64_t value = pm_get(map, i * 7);
+            ASSERT_EQUAL(value, i, "Key = %ld, Value = %ld", i * 7, value);
+            length++;
+        }
+        ASSERT_FALSE(pm_contains_key(map, i * 7 + 1), "Map should not contain key = %ld", i * 7 + 1);
+    }
+    ASSERT_EQUAL(map->length, length, "Actual length = %d, expected = %d", map->length, length);
+
+    uint32_t count = 0;
+    for iter(PrimitiveMap(int64_t), it, map)
+    {
+        ASSERT_EQUAL(it.key, it.value * 7, "Key = %ld, Value = %ld", it.key, it.value);
+        count++;
+    }
+    ASSERT_EQUAL(count, length, "Iterated count = %d", count);
+
+    pm_clear(map);
+    ASSERT_EQUAL(map->length, 0, "Actual length = %d", map->length);
+    ASSERT_FALSE(pm_contains_key(map, 0), "Map should be empty after clear");
+
+    del(PrimitiveMap(int64_t), map);
+});
+
+TEST_GROUP(test_primitive_map, {
+
+    // Primitive Map groups
+    test_char_map();
+    test_bool_map();
+    test_int32_t_map();
+    test_int64_t_map();
+    test_uint32_t_map();
+    test_uint64_t_map();
+
+    test_primitive_map_stress();
+});
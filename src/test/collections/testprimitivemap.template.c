@@ -0,0 +1,62 @@
+// Template for PrimitiveMap(type) Tests
+// @param type : The type of the map
+// @param v1 : A literal of type 'type'
+// @param v1s : (Optional) The string literal form of param 'v1'
+// @param v2 : A different literal of type 'type'
+
+#ifndef v1s
+#define v1s LITERAL(v1)
+#endif
+
+TEST(CONCAT3(test_, type, _map_new), {
+    PrimitiveMap(type) map = new(PrimitiveMap(type), 10);
+
+    del(PrimitiveMap(type), map);
+});
+
+TEST(CONCAT3(test_, type, _map_format), {
+    PrimitiveMap(type) map = new(PrimitiveMap(type), 10);
+
+    String s1 = format(PrimitiveMap(type), map);
+    ASSERT_TRUE(str_equals_content(s1, "PrimitiveMap<" LITERAL(type) ">{}"), "Actual: '%s'", s1->slice);
+
+    pm_put(map, v1, v1);
+
+    String s2 = format(PrimitiveMap(type), map);
+    ASSERT_TRUE(str_equals_content(s2, "PrimitiveMap<" LITERAL(type) ">{" v1s ": " v1s "}"), "Actual: '%s'", s2->slice);
+
+    del(String, s1);
+    del(String, s2);
+    del(PrimitiveMap(type), map);
+});
+
+TEST(CONCAT3(test_, type, _map_put_get_remove), {
+    PrimitiveMap(type) map = new(PrimitiveMap(type), 10);
+
+    ASSERT_FALSE(pm_put(map, v1, v2), "Key should not be present before put");
+    ASSERT_TRUE(pm_put(map, v1, v1), "Key should be present, and be replaced");
+    ASSERT_EQUAL(map->length, 1, "Actual length = %d", map->length);
+    ASSERT_TRUE(pm_contains_key(map, v1), "Map should contain key");
+    ASSERT_FALSE(pm_contains_key(map, v2), "Map should not contain key");
+
+    ASSERT_EQUAL(pm_get(map, v1), v1, "Map value not equal after put");
+    ASSERT_EQUAL(pm_get(map, v2), default_value(type), "Map should return the default value for a missing key");
+
+    ASSERT_TRUE(pm_remove(map, v1), "Key should be removed");
+    ASSERT_FALSE(pm_remove(map, v1), "Key should not be removed twice");
+    ASSERT_EQUAL(map->length, 0, "Actual length = %d", map->length);
+    ASSERT_FALSE(pm_contains_key(map, v1), "Map should not contain removed key");
+
+    del(PrimitiveMap(type), map);
+});
+
+TEST_GROUP(CONCAT3(test_, type, _map), {
+    CONCAT3(test_, type, _map_new)();
+    CONCAT3(test_, type, _map_format)();
+    CONCAT3(test_, type, _map_put_get_remove)();
+});
+
+#undef type
+#undef v1
+#undef v1s
+#undef v2
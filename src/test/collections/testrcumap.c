@@ -0,0 +1,129 @@
+#include "../unittest.h"
+
+#define TEST_RCU_READERS 4
+#define TEST_RCU_KEYS 500
+#define TEST_RCU_ROUNDS 200
+
+TEST(test_rcu_map_put_publish_get, {
+    RcuMap map = new(RcuMap, 16, class(Int32), class(Int32));
+    uint32_t reader = rmap_register(map);
+    Int32 key = new(Int32, 3);
+
+    ASSERT_FALSE(rmap_put(map, new(Int32, 3), new(Int32, 30)), "Key should not have been present");
+    ASSERT_TRUE(rmap_get(map, reader, key) == NULL, "Changes should not be visible before publishing");
+
+    rmap_publish(map);
+    Int32 value = rmap_get(map, reader, key); // A copy, owned by the caller
+    ASSERT_TRUE(value != NULL && *value == 30, "Expected value = 30");
+    del(Int32, value);
+
+    // A reader keeps it's snapshot, and the values in it, until it stops reading
+    Map snapshot = rmap_read_begin(map, reader);
+    ASSERT_TRUE(rmap_put(map, new(Int32, 3), new(Int32, 31)), "Key should have been present");
+    rmap_publish(map);
+
+    Int32 borrowed = map_get(snapshot, key);
+    ASSERT_EQUAL(*borrowed, 30, "Actual value in the old snapshot = %d", *borrowed);
+    rmap_read_end(map, reader);
+
+    value = rmap_get(map, reader, key);
+    ASSERT_EQUAL(*value, 31, "Actual value = %d", *value);
+    del(Int32, value);
+
+    ASSERT_TRUE(rmap_remove(map, key), "Key should have been removed");
+    ASSERT_FALSE(rmap_remove(map, key), "Key should not have been present");
+    rmap_publish(map);
+    ASSERT_TRUE(rmap_get(map, reader, key) == NULL, "Key should not be present after publishing");
+
+    rmap_put(map, new(Int32, 4), new(Int32, 40));
+    rmap_publish(map);
+    String s = format(RcuMap, map);
+    ASSERT_TRUE(str_equals_content(s, "RcuMap<Int32, Int32>{4: 40}"), "Actual: %s", s->slice);
+    del(String, s);
+
+    rmap_unregister(map, reader);
+    del(Int32, key);
+    del(RcuMap, map);
+});
+
+typedef struct
+{
+    RcuMap map;
+    _Atomic(bool)* done;
+    uint32_t errors;
+    uint32_t reads;
+} TestRcuMapThread;
+
+// Each reader checks that every snapshot it reads is consistent: all keys are present, and have values from the same round
+static void* test_rcu_map_thread(void* arg)
+{
+    TestRcuMapThread* thread = arg;
+    uint32_t reader = rmap_register(thread->map);
+    Int32 key = new(Int32, 0);
+    while (!atomic_load(thread->done))
+    {
+        Map snapshot = rmap_read_begin(thread->map, reader);
+        *key = 0;
+        Int32 first = map_get(snapshot, key);
+        for (int32_t i = 0; i < TEST_RCU_KEYS; i++)
+        {
+            *key = i;
+            Int32 value = map_get(snapshot, key);
+            if (value == NULL || *value - i != *first)
+            {
+                thread->errors++;
+            }
+        }
+        rmap_read_end(thread->map, reader);
+        thread->reads++;
+    }
+    del(Int32, key);
+    rmap_unregister(thread->map, reader);
+    return NULL;
+}
+
+TEST(test_rcu_map_readers, {
+    RcuMap map = new(RcuMap, 16, class(Int32), class(Int32));
+    for (int32_t i = 0; i < TEST_RCU_KEYS; i++)
+    {
+        rmap_put(map, new(Int32, i), new(Int32, i));
+    }
+    rmap_publish(map);
+
+    _Atomic(bool) done = false;
+    pthread_t threads[TEST_RCU_READERS];
+    TestRcuMapThread args[TEST_RCU_READERS];
+    for (uint32_t i = 0; i < TEST_RCU_READERS; i++)
+    {
+        args[i] = (TestRcuMapThread) { map, &done, 0, 0 };
+        pthread_create(&threads[i], NULL, test_rcu_map_thread, &args[i]);
+    }
+
+    // Each round removes one key (retiring it's key and value), and then replaces every value (retiring the previous values), before publishing
+    Int32 key = new(Int32, 0);
+    for (int32_t round = 1; round <= TEST_RCU_ROUNDS; round++)
+    {
+        *key = round % TEST_RCU_KEYS;
+        rmap_remove(map, key);
+        for (int32_t i = 0; i < TEST_RCU_KEYS; i++)
+        {
+            rmap_put(map, new(Int32, i), new(Int32, round * TEST_RCU_KEYS + i));
+        }
+        rmap_publish(map);
+    }
+    atomic_store(&done, true);
+    del(Int32, key);
+
+    for (uint32_t i = 0; i < TEST_RCU_READERS; i++)
+    {
+        pthread_join(threads[i], NULL);
+        ASSERT_EQUAL(args[i].errors, 0u, "Reader %d saw %d inconsistent values in %d reads", i, args[i].errors, args[i].reads);
+    }
+
+    del(RcuMap, map);
+});
+
+TEST_GROUP(test_rcu_map, {
+    test_rcu_map_put_publish_get();
+    test_rcu_map_readers();
+});
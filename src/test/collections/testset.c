@@ -75,6 +75,397 @@ TEST(test_set_stress, {
     del(Set, set);
 });
 
+TEST(test_set_robin_hood_stress, {
+    Set set = new(Set, 2, class(Int32), HASH_ROBIN_HOOD);
+    Int32 missing = new(Int32, 0);
+
+    for (int32_t k = 0; k < 10; k++)
+    {
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            // Only even keys are inserted, with many keys sharing a home index
+            Int32 key = new(Int32, 2 * ((i * 64 + 52 * k) % 3000));
+            set_put(set, key);
+
+            ASSERT_TRUE(set_contains(set, key), "Key = %d", *key);
+
+            *missing = *key + 1;
+            ASSERT_FALSE(set_contains(set, missing), "Key = %d", *missing);
+        }
+        set_clear(set);
+    }
+
+    del(Int32, missing);
+    del(Set, set);
+});
+
+TEST(test_set_linear_stress, {
+    Set set = new(Set, 2, class(Int32), HASH_LINEAR);
+    Int32 missing = new(Int32, 0);
+
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        Int32 key = new(Int32, i * 16);
+        set_put(set, key);
+        ASSERT_TRUE(set_contains(set, key), "Key = %d", *key);
+
+        *missing = i * 16 + 1;
+        ASSERT_FALSE(set_contains(set, missing), "Key = %d", *missing);
+    }
+    ASSERT_EQUAL(set->length, 3000, "Actual length = %d", set->length);
+
+    del(Int32, missing);
+    del(Set, set);
+});
+
+TEST(test_set_incremental_stress, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t e = 0; e < 3; e++)
+    {
+        Set set = new(Set, 2, class(Int32), engines[e] | HASH_INCREMENTAL);
+        Int32 value = new(Int32, 0);
+
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            set_put(set, new(Int32, i * 16));
+            *value = (i * 7) % (i + 1) * 16;
+            ASSERT_TRUE(set_contains(set, value), "Set should contain value = %d", *value);
+        }
+        ASSERT_EQUAL(set->length, 3000, "Actual length = %d", set->length);
+
+        uint32_t count = 0;
+        for iter(Set, it, set)
+        {
+            count++;
+        }
+        ASSERT_EQUAL(count, 3000, "Iterated count = %d", count);
+
+        for (int32_t i = 0; i < 3000; i++)
+        {
+            *value = i * 16;
+            ASSERT_TRUE(set_contains(set, value), "Set should contain value = %d", *value);
+            *value = i * 16 + 1;
+            ASSERT_FALSE(set_contains(set, value), "Set should not contain value = %d", *value);
+        }
+
+        del(Int32, value);
+        del(Set, set);
+    }
+});
+
+TEST(test_set_incremental_iterate, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t e = 0; e < 3; e++)
+    {
+        Set set = new(Set, 2, class(Int32), engines[e] | HASH_INCREMENTAL);
+        Int32 value = new(Int32, 0);
+
+        // Fill until the set has just started migrating, so values are split between both sets
+        int32_t length = 0;
+        while (length < 1000 || set->previous == NULL)
+        {
+            set_put(set, new(Int32, length));
+            length++;
+        }
+
+        // Looking up values while iterating must not move values under the iterator
+        uint32_t* visits = safe_calloc(sizeof(uint32_t) * length);
+        for iter(Set, it, set)
+        {
+            int32_t v = *(Int32) it.value;
+            ASSERT_TRUE(v >= 0 && v < length, "Unexpected value = %d", v);
+            visits[v]++;
+
+            *value = length - 1 - v;
+            ASSERT_TRUE(set_contains(set, value), "Set should contain value = %d", *value);
+            *value = length + v;
+            ASSERT_FALSE(set_contains(set, value), "Set should not contain value = %d", *value);
+        }
+        ASSERT_TRUE(set->previous != NULL, "Set should still be migrating");
+        for (int32_t v = 0; v < length; v++)
+        {
+            ASSERT_EQUAL(visits[v], 1u, "Value = %d was visited %d times", v, visits[v]);
+        }
+
+        free(visits);
+        del(Int32, value);
+        del(Set, set);
+    }
+});
+
+TEST(test_set_remove, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t e = 0; e < 3; e++)
+    {
+        Set set = new(Set, 16, class(Int32), engines[e]);
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            set_put(set, new(Int32, i));
+        }
+
+        // Remove every other value, keeping ownership of some
+        Int32 value = new(Int32, 0);
+        for (int32_t i = 0; i < 1000; i += 2)
+        {
+            *value = i;
+            pointer_t removed = NULL;
+            bool keep = i % 4 == 0;
+            ASSERT_TRUE(set_remove(set, value, keep ? &removed : NULL), "Value = %d should be removed", i);
+            if (keep)
+            {
+                ASSERT_TRUE(removed != value && *(Int32) removed == i, "Removed value should be the value from the set");
+                del(Int32, removed);
+            }
+        }
+        ASSERT_EQUAL(set->length, 500, "Actual length = %d", set->length);
+
+        for (int32_t i = 0; i < 1000; i++)
+        {
+            *value = i;
+            bool odd = i % 2 == 1;
+            ASSERT_EQUAL(set_contains(set, value), odd, "Set contains value = %d", i);
+        }
+
+        del(Int32, value);
+        del(Set, set);
+    }
+});
+
+TEST(test_set_from_array, {
+    HashOptions options[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t o = 0; o < 3; o++)
+    {
+        // Includes duplicates, and is large enough to use the parallel path
+        uint32_t length = HASH_PARALLEL_THRESHOLD + 1000;
+        pointer_t* values = safe_malloc(sizeof(pointer_t) * length);
+        for (uint32_t i = 0; i < length; i++)
+        {
+            values[i] = new(Int32, (int32_t) (i % HASH_PARALLEL_THRESHOLD));
+        }
+
+        Set set = set_from_array(length, values, class(Int32), options[o]);
+        ASSERT_EQUAL(set->length, (uint32_t) HASH_PARALLEL_THRESHOLD, "Actual length = %d", set->length);
+
+        Int32 value = new(Int32, 0);
+        for (int32_t i = 0; i < HASH_PARALLEL_THRESHOLD + 10; i++)
+        {
+            *value = i;
+            ASSERT_EQUAL(set_contains(set, value), i < HASH_PARALLEL_THRESHOLD, "Value = %d", i);
+        }
+
+        uint32_t size = set->size;
+        set_reserve(set, 2 * set->length);
+        ASSERT_TRUE(set->size > size, "Expected reserve to grow the set, actual size = %d", set->size);
+
+        set_put_all(set, 0, NULL);
+        ASSERT_EQUAL(set->length, (uint32_t) HASH_PARALLEL_THRESHOLD, "Actual length = %d", set->length);
+
+        del(Int32, value);
+        del(Set, set);
+        free(values);
+    }
+});
+
+TEST(test_set_reusable_clear, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS };
+    for (uint32_t e = 0; e < 3; e++)
+    {
+        Set set = new(Set, 1024, class(String), engines[e] | HASH_REUSABLE);
+
+        // Clearing a set which is much larger than each round, which only visits the slots filled by the round
+        for (int32_t round = 0; round < 100; round++)
+        {
+            for (int32_t i = 0; i < 8; i++)
+            {
+                bool present = set_put(set, str_format("%d-%d", round, i));
+                ASSERT_FALSE(present, "Value should be new");
+            }
+            bool present = set_put(set, str_format("%d-%d", round, 0));
+            ASSERT_TRUE(present, "Value should already be present");
+            ASSERT_TRUE(set->filled_length <= 8, "Actual filled length = %d", set->filled_length);
+
+            set_clear(set);
+            String value = str_format("%d-%d", round, 0);
+            bool contains = set_contains(set, value);
+            del(String, value);
+            ASSERT_FALSE(contains, "Set should not contain round = %d", round);
+            ASSERT_EQUAL(set->length, 0u, "Actual length = %d", set->length);
+        }
+
+        del(Set, set);
+    }
+});
+
+// Creates a set of Int32 from start (inclusive) to end (exclusive)
+static Set test_set_range(int32_t start, int32_t end, HashOptions options)
+{
+    Set set = new(Set, 16, class(Int32), options);
+    for (int32_t i = start; i < end; i++)
+    {
+        set_put(set, new(Int32, i));
+    }
+    return set;
+}
+
+// Checks that a set contains exactly the values in [start, end)
+static bool test_set_is_range(Set set, int32_t start, int32_t end)
+{
+    ASSERT_EQUAL(set->length, (uint32_t) (end - start), "Actual length = %d, expected [%d, %d)", set->length, start, end);
+    for iter(Set, it, set)
+    {
+        int32_t value = *(Int32) it.value;
+        ASSERT_TRUE(value >= start && value < end, "Value = %d not in [%d, %d)", value, start, end);
+    }
+    return true;
+}
+
+TEST(test_set_algebra, {
+    // Pairs of engines, including pairs which store different hashes, or have different seeds, and an incremental set mid-resize
+    HashOptions options[][2] = {
+        { HASH_SWISS, HASH_SWISS },
+        { HASH_LINEAR, HASH_SWISS },
+        { HASH_SWISS, HASH_ROBIN_HOOD },
+        { HASH_LINEAR | HASH_INCREMENTAL, HASH_SWISS | HASH_INCREMENTAL },
+        { HASH_LINEAR | HASH_SEEDED, HASH_LINEAR },
+        { HASH_SWISS | HASH_SEEDED, HASH_ROBIN_HOOD | HASH_SEEDED },
+    };
+    for (uint32_t o = 0; o < 6; o++)
+    {
+        HashOptions a = options[o][0], b = options[o][1];
+
+        // [0, 300) and [200, 1000), so both the smaller and larger set are iterated
+        for (uint32_t swap = 0; swap < 2; swap++)
+        {
+            int32_t small_start = 0, small_end = 300, large_start = 200, large_end = 1000;
+            Set small = test_set_range(small_start, small_end, a), large = test_set_range(large_start, large_end, b);
+            Set first = swap ? large : small, second = swap ? small : large;
+
+            Set result = set_union_new(first, second);
+            ASSERT_TRUE(test_set_is_range(result, 0, 1000), "Union");
+            del(Set, result);
+
+            result = set_intersect_new(first, second);
+            ASSERT_TRUE(test_set_is_range(result, 200, 300), "Intersection");
+            del(Set, result);
+
+            result = set_difference_new(first, second);
+            ASSERT_TRUE(swap ? test_set_is_range(result, 300, 1000) : test_set_is_range(result, 0, 200), "Difference");
+            del(Set, result);
+
+            ASSERT_FALSE(set_is_subset(first, second), "Neither set is a subset");
+
+            // The other set is unchanged by any operation
+            ASSERT_TRUE(test_set_is_range(second, swap ? small_start : large_start, swap ? small_end : large_end), "Other set");
+
+            del(Set, small);
+            del(Set, large);
+        }
+
+        // In place
+        for (uint32_t swap = 0; swap < 2; swap++)
+        {
+            Set small = test_set_range(0, 300, a), large = test_set_range(200, 1000, b);
+            Set first = swap ? large : small, second = swap ? small : large;
+            set_intersect(first, second);
+            ASSERT_TRUE(test_set_is_range(first, 200, 300), "Intersection in place");
+            ASSERT_TRUE(set_is_subset(first, second), "Intersection is a subset");
+            del(Set, small);
+            del(Set, large);
+
+            small = test_set_range(0, 300, a), large = test_set_range(200, 1000, b);
+            first = swap ? large : small, second = swap ? small : large;
+            set_difference(first, second);
+            ASSERT_TRUE(swap ? test_set_is_range(first, 300, 1000) : test_set_is_range(first, 0, 200), "Difference in place");
+            del(Set, small);
+            del(Set, large);
+
+            small = test_set_range(0, 300, a), large = test_set_range(200, 1000, b);
+            first = swap ? large : small, second = swap ? small : large;
+            set_union(first, second);
+            ASSERT_TRUE(test_set_is_range(first, 0, 1000), "Union in place");
+            ASSERT_TRUE(set_is_subset(second, first), "Union is a superset");
+            del(Set, small);
+            del(Set, large);
+        }
+    }
+});
+
+TEST(test_set_algebra_same_set, {
+    Set set = test_set_range(0, 100, HASH_DEFAULT);
+
+    set_union(set, set);
+    set_intersect(set, set);
+    ASSERT_TRUE(test_set_is_range(set, 0, 100), "Set should be unchanged");
+    ASSERT_TRUE(set_is_subset(set, set), "A set is a subset of itself");
+
+    Set result = set_intersect_new(set, set);
+    ASSERT_TRUE(test_set_is_range(result, 0, 100), "Intersection");
+    del(Set, result);
+
+    result = set_difference_new(set, set);
+    ASSERT_EQUAL(result->length, 0u, "Actual length = %d", result->length);
+    del(Set, result);
+
+    set_difference(set, set);
+    ASSERT_EQUAL(set->length, 0u, "Actual length = %d", set->length);
+
+    del(Set, set);
+});
+
+TEST(test_set_bloom, {
+    // Parallel placement adds keys to the filter afterwards
+    Set set = test_set_range(0, HASH_PARALLEL_THRESHOLD + 1000, HASH_LINEAR | HASH_BLOOM);
+    Set other = test_set_range(0, 100, HASH_SWISS | HASH_BLOOM);
+    Int32 value = new(Int32, 0);
+    for (int32_t i = 0; i < 2 * HASH_PARALLEL_THRESHOLD; i++)
+    {
+        *value = i;
+        ASSERT_EQUAL(set_contains(set, value), i < HASH_PARALLEL_THRESHOLD + 1000, "Value = %d", i);
+    }
+    HashBloomStats stats = set_bloom_stats(set);
+    ASSERT_TRUE(stats.false_positive_rate < 0.1, "Actual false positive rate = %.3f", stats.false_positive_rate);
+
+    ASSERT_TRUE(set_is_subset(other, set), "Set algebra uses the filter");
+    set_difference(set, other);
+    ASSERT_TRUE(test_set_is_range(set, 100, HASH_PARALLEL_THRESHOLD + 1000), "Difference");
+
+    del(Int32, value);
+    del(Set, set);
+    del(Set, other);
+});
+
+TEST(test_set_stats, {
+    // Clusters of lengths 1, 2 and 3, with identity hashes: {0}, {2, 3} and {5, 6, 7}
+    Set set = new(Set, 16, class(Int32), HASH_LINEAR);
+    int32_t values[] = { 0, 2, 3, 5, 6, 7 };
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        set_put(set, new(Int32, values[i]));
+    }
+    HashStats stats = set_stats(set);
+    ASSERT_EQUAL(stats.clusters[0], 1u, "Actual clusters of length 1 = %u", stats.clusters[0]);
+    ASSERT_EQUAL(stats.clusters[1], 2u, "Actual clusters of length 2 - 3 = %u", stats.clusters[1]);
+    ASSERT_EQUAL(stats.bytes, sizeof(struct Set__struct) + 16 * (sizeof(pointer_t) + sizeof(uint32_t)), "Actual bytes = %lu", stats.bytes);
+
+    String s = hash_stats_format(stats);
+    bool matches = strstr(s->slice, "length 6, capacity 16,") == s->slice && strstr(s->slice, "clusters {1: 1, 2-3: 2}") != NULL;
+    ASSERT_TRUE(matches, "Actual: '%s'", s->slice);
+    del(String, s);
+    del(Set, set);
+
+    // A cluster which wraps around the end of the table is counted once: {14, 15, 30}, where 30 has home slot 14, and is in slot 0
+    set = new(Set, 16, class(Int32), HASH_LINEAR);
+    set_put(set, new(Int32, 14));
+    set_put(set, new(Int32, 15));
+    set_put(set, new(Int32, 30));
+    stats = set_stats(set);
+    ASSERT_EQUAL(stats.clusters[1], 1u, "Actual clusters of length 2 - 3 = %u", stats.clusters[1]);
+    ASSERT_EQUAL(stats.clusters[0], 0u, "Actual clusters of length 1 = %u", stats.clusters[0]);
+    ASSERT_EQUAL(stats.max_probe_length, 3u, "Actual max probe length = %u", stats.max_probe_length);
+    del(Set, set);
+});
+
+
 TEST_GROUP(test_set, {
     test_set_new();
     test_set_put_contains();
@@ -82,4 +473,16 @@ TEST_GROUP(test_set, {
     test_set_format();
 
     test_set_stress();
+
+    test_set_robin_hood_stress();
+    test_set_linear_stress();
+    test_set_incremental_stress();
+    test_set_incremental_iterate();
+    test_set_remove();
+    test_set_from_array();
+    test_set_reusable_clear();
+    test_set_algebra();
+    test_set_algebra_same_set();
+    test_set_bloom();
+    test_set_stats();
 });
\ No newline at end of file
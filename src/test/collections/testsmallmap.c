@@ -0,0 +1,100 @@
+#include "../unittest.h"
+
+TEST(test_small_map_new, {
+    SmallMap map = new(SmallMap, 10, class(Int32), class(String));
+    del(SmallMap, map);
+});
+
+TEST(test_small_map_put_get, {
+    // The Map methods select the SmallMap methods
+    SmallMap map = new(SmallMap, 10, class(Int32), class(String));
+    Int32 key = new(Int32, 2);
+    Int32 bad_key = new(Int32, 5);
+
+    ASSERT_FALSE(map_put(map, copy(Int32, key), new(String, "two")), "Key should not be present");
+    ASSERT_TRUE(map_contains_key(map, key), "Map should contain key = 2");
+    ASSERT_FALSE(map_contains_key(map, bad_key), "Map should not contain key = 5");
+    ASSERT_TRUE(str_equals_content(map_get(map, key), "two"), "Actual: '%s'", ((String) map_get(map, key))->slice);
+    ASSERT_TRUE(map_get(map, bad_key) == NULL, "Missing key should have a NULL value");
+
+    ASSERT_TRUE(map_put(map, copy(Int32, key), new(String, "TWO")), "Key should be replaced");
+    ASSERT_TRUE(str_equals_content(map_get(map, key), "TWO"), "Actual: '%s'", ((String) map_get(map, key))->slice);
+    ASSERT_TRUE(map->map == NULL, "No Map should be allocated");
+
+    del(Int32, key);
+    del(Int32, bad_key);
+    del(SmallMap, map);
+});
+
+TEST(test_small_map_format, {
+    SmallMap map = new(SmallMap, 10, class(Int32), class(Int32));
+
+    String s1 = format(SmallMap, map);
+    ASSERT_TRUE(str_equals_content(s1, "SmallMap<Int32, Int32>{}"), "Actual: '%s'", s1->slice);
+    del(String, s1);
+
+    map_put(map, new(Int32, 3), new(Int32, 30));
+    map_put(map, new(Int32, 1), new(Int32, 10));
+    String s2 = format(SmallMap, map);
+    ASSERT_TRUE(str_equals_content(s2, "SmallMap<Int32, Int32>{3: 30, 1: 10}"), "Actual: '%s'", s2->slice);
+    del(String, s2);
+
+    del(SmallMap, map);
+});
+
+TEST(test_small_map_grow, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_INCREMENTAL };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        SmallMap map = new(SmallMap, 16, class(Int32), class(Int32), engines[e]);
+        Int32 key = new(Int32, 0);
+
+        // Outgrows the inline entries, then is emptied and small again, several times
+        for (int32_t round = 0; round < 3; round++)
+        {
+            int32_t count = round == 1 ? 10 : 100;
+            for (int32_t i = 0; i < count; i++)
+            {
+                ASSERT_FALSE(map_put(map, new(Int32, i), new(Int32, -i)), "Key = %d should not be present", i);
+            }
+            for (int32_t i = 0; i < 2 * count; i++)
+            {
+                *key = i;
+                Int32 value = map_get(map, key);
+                ASSERT_EQUAL(value != NULL, i < count, "Key = %d", i);
+                ASSERT_TRUE(value == NULL || *value == -i, "Key = %d, actual value = %d", i, *value);
+            }
+
+            uint32_t length = 0;
+            for iter(SmallMap, it, map)
+            {
+                ASSERT_EQUAL(*(Int32) it.key, -*(Int32) it.value, "Key = %d", *(Int32) it.key);
+                length++;
+            }
+            ASSERT_EQUAL(length, (uint32_t) count, "Actual iterated length = %d", length);
+
+            // Remove the odd keys, then clear the rest
+            for (int32_t i = 1; i < count; i += 2)
+            {
+                *key = i;
+                ASSERT_TRUE(map_remove(map, key, NULL, NULL), "Key = %d should be removed", i);
+            }
+            *key = 0;
+            ASSERT_TRUE(map_contains_key(map, key), "Key = 0 should remain");
+
+            map_clear(map);
+            ASSERT_FALSE(map_contains_key(map, key), "Map should be empty");
+        }
+
+        del(Int32, key);
+        del(SmallMap, map);
+    }
+});
+
+
+TEST_GROUP(test_small_map, {
+    test_small_map_new();
+    test_small_map_put_get();
+    test_small_map_format();
+    test_small_map_grow();
+});
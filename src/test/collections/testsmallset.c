@@ -0,0 +1,117 @@
+#include "../unittest.h"
+
+TEST(test_small_set_new, {
+    SmallSet set = new(SmallSet, 10, class(String));
+    del(SmallSet, set);
+});
+
+TEST(test_small_set_put_contains, {
+    // The Set methods select the SmallSet methods
+    SmallSet set = new(SmallSet, 10, class(String));
+    String value = new(String, "one"), missing = new(String, "two");
+
+    ASSERT_FALSE(set_put(set, copy(String, value)), "Value should not be present");
+    ASSERT_TRUE(set_put(set, copy(String, value)), "Value should be replaced");
+    ASSERT_TRUE(set_contains(set, value), "Set should contain 'one'");
+    ASSERT_FALSE(set_contains(set, missing), "Set should not contain 'two'");
+    ASSERT_EQUAL(set->length, 1u, "Actual length = %d", set->length);
+    ASSERT_TRUE(set->set == NULL, "No Set should be allocated");
+
+    del(String, value);
+    del(String, missing);
+    del(SmallSet, set);
+});
+
+TEST(test_small_set_format, {
+    SmallSet set = new(SmallSet, 10, class(Int32));
+
+    String s1 = format(SmallSet, set);
+    ASSERT_TRUE(str_equals_content(s1, "SmallSet<Int32>{}"), "Actual: '%s'", s1->slice);
+    del(String, s1);
+
+    // Inline values are formatted in insertion order
+    set_put(set, new(Int32, 3));
+    set_put(set, new(Int32, 1));
+    String s2 = format(SmallSet, set);
+    ASSERT_TRUE(str_equals_content(s2, "SmallSet<Int32>{3, 1}"), "Actual: '%s'", s2->slice);
+    del(String, s2);
+
+    del(SmallSet, set);
+});
+
+TEST(test_small_set_grow, {
+    HashOptions engines[] = { HASH_LINEAR, HASH_ROBIN_HOOD, HASH_SWISS, HASH_SWISS | HASH_REUSABLE };
+    for (uint32_t e = 0; e < 4; e++)
+    {
+        SmallSet set = new(SmallSet, 16, class(Int32), engines[e]);
+        Int32 key = new(Int32, 0);
+
+        // Outgrows the inline values, then is emptied and small again, several times
+        for (int32_t round = 0; round < 3; round++)
+        {
+            int32_t count = round == 1 ? 10 : 100;
+            for (int32_t i = 0; i < count; i++)
+            {
+                ASSERT_FALSE(set_put(set, new(Int32, i)), "Value = %d should not be present", i);
+            }
+            ASSERT_EQUAL(set->set != NULL && set->set->length > 0, count > SMALL_SET_INLINE, "Values should be held in the Set, round = %d", round);
+            for (int32_t i = 0; i < 2 * count; i++)
+            {
+                *key = i;
+                ASSERT_EQUAL(set_contains(set, key), i < count, "Value = %d", i);
+            }
+
+            uint32_t length = 0;
+            for iter(SmallSet, it, set)
+            {
+                length++;
+            }
+            ASSERT_EQUAL(length, (uint32_t) count, "Actual iterated length = %d", length);
+
+            // Remove the odd values, then clear the rest
+            for (int32_t i = 1; i < count; i += 2)
+            {
+                *key = i;
+                ASSERT_TRUE(set_remove(set, key, NULL), "Value = %d should be removed", i);
+            }
+            *key = 0;
+            ASSERT_TRUE(set_contains(set, key), "Value = 0 should remain");
+            *key = 1;
+            ASSERT_FALSE(set_contains(set, key), "Value = 1 should be removed");
+
+            set_clear(set);
+            *key = 0;
+            ASSERT_FALSE(set_contains(set, key), "Set should be empty");
+        }
+
+        del(Int32, key);
+        del(SmallSet, set);
+    }
+});
+
+TEST(test_small_set_remove, {
+    SmallSet set = new(SmallSet, 10, class(String));
+    set_put(set, new(String, "a"));
+    set_put(set, new(String, "b"));
+    set_put(set, new(String, "c"));
+
+    String query = new(String, "a");
+    pointer_t removed = NULL;
+    ASSERT_TRUE(set_remove(set, query, &removed), "Value should be removed");
+    ASSERT_TRUE(removed != query && equals(String, removed, query), "The stored value should be returned");
+    ASSERT_FALSE(set_remove(set, query, NULL), "Value should already be removed");
+    ASSERT_EQUAL(set->length, 2u, "Actual length = %d", set->length);
+
+    del(String, removed);
+    del(String, query);
+    del(SmallSet, set);
+});
+
+
+TEST_GROUP(test_small_set, {
+    test_small_set_new();
+    test_small_set_put_contains();
+    test_small_set_format();
+    test_small_set_grow();
+    test_small_set_remove();
+});
@@ -12,6 +12,9 @@
 #define Tuple Numbers, int32_t, i32, uint32_t, u32, int64_t, i64, uint64_t, u64
 #include "../../lib/collections/tuple.template.c"
 
+#define Tuple Pair, int32_t, x, int32_t, y
+#include "../../lib/collections/tuple.template.c"
+
 // Generic Tests
 
 TEST(test_tuple_boolbox_new, {
@@ -59,6 +62,22 @@ TEST(test_tuple_numbers_format, {
     del(Numbers, n);
 });
 
+TEST(test_tuple_pair_hash, {
+    // Members are hashed in order, so (x, y) and (y, x) differ, and (k, k) does not cancel out to 0
+    Set hashes = new(Set, 1024, class(UInt32));
+    for (int32_t x = -16; x < 16; x++)
+    {
+        for (int32_t y = -16; y < 16; y++)
+        {
+            Pair pair = new(Pair, x, y);
+            bool present = set_put(hashes, new(UInt32, hash(Pair, pair)));
+            del(Pair, pair);
+            ASSERT_FALSE(present, "Hash of (%d, %d) collides", x, y);
+        }
+    }
+    del(Set, hashes);
+});
+
 
 TEST_GROUP(test_tuple, {
     test_tuple_boolbox_new();
@@ -69,4 +88,6 @@ TEST_GROUP(test_tuple, {
 
     test_tuple_numbers_new();
     test_tuple_numbers_format();
+
+    test_tuple_pair_hash();
 });
@@ -0,0 +1,100 @@
+#include "unittest.h"
+
+TEST(test_hash_bytes_lengths, {
+    // Every prefix of a buffer hashes differently, including those which are read as overlapping words
+    uint8_t data[128];
+    for (uint32_t i = 0; i < 128; i++)
+    {
+        data[i] = (uint8_t) (i * 7);
+    }
+
+    Set hashes = new(Set, 256, class(UInt64));
+    for (uint32_t length = 0; length <= 128; length++)
+    {
+        bool present = set_put(hashes, new(UInt64, hash_bytes(data, length, 0)));
+        ASSERT_FALSE(present, "Hash of length = %d collides", length);
+    }
+    del(Set, hashes);
+});
+
+TEST(test_hash_bytes_bits, {
+    // Flipping any single bit of the input changes the hash, at each length which is read differently
+    uint32_t lengths[] = { 3, 7, 16, 40, 100 };
+    for (uint32_t l = 0; l < 5; l++)
+    {
+        uint8_t data[100] = { 0 };
+        uint32_t length = lengths[l];
+        uint64_t h = hash_bytes(data, length, 0);
+        for (uint32_t bit = 0; bit < length * 8; bit++)
+        {
+            data[bit / 8] ^= (uint8_t) (1 << (bit & 7));
+            uint64_t flipped = hash_bytes(data, length, 0);
+            data[bit / 8] ^= (uint8_t) (1 << (bit & 7));
+            ASSERT_NOT_EQUAL(h, flipped, "Flipping bit %d of length %d", bit, length);
+        }
+    }
+});
+
+TEST(test_hash_bytes_seed, {
+    slice_t data = "the same bytes";
+    ASSERT_EQUAL(hash_bytes(data, strlen(data), 1), hash_bytes(data, strlen(data), 1), "Same seed");
+    ASSERT_NOT_EQUAL(hash_bytes(data, strlen(data), 1), hash_bytes(data, strlen(data), 2), "Different seeds");
+
+    // Only the content is hashed, not it's alignment
+    char buffer[32];
+    strcpy(buffer + 1, data);
+    ASSERT_EQUAL(hash_bytes(data, strlen(data), 0), hash_bytes(buffer + 1, strlen(data), 0), "Unaligned copy");
+});
+
+TEST(test_hash_string, {
+    // "Aa" and "BB" are a collision of a polynomial hash with multiplier 31
+    String aa = new(String, "Aa"), bb = new(String, "BB");
+    ASSERT_NOT_EQUAL(hash(String, aa), hash(String, bb), "Hash = %u", hash(String, aa));
+    ASSERT_EQUAL(hash(String, aa), hash_fold(hash_bytes("Aa", 2, 0)), "Hash = %u", hash(String, aa));
+    del(String, aa);
+    del(String, bb);
+});
+
+TEST(test_hash_int64, {
+    // Folding the halves together with or collides each of these
+    uint64_t values[] = { 1, (uint64_t) 1 << 32, ((uint64_t) 1 << 32) | 1, 3 };
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        for (uint32_t j = i + 1; j < 4; j++)
+        {
+            ASSERT_NOT_EQUAL(hash(uint64_t, values[i]), hash(uint64_t, values[j]), "Values %lu and %lu", values[i], values[j]);
+        }
+    }
+    ASSERT_EQUAL(hash(int64_t, -5l), hash(uint64_t, (uint64_t) -5l), "Signed and unsigned hash the same bits");
+});
+
+TEST(test_hash_combine, {
+    Set hashes = new(Set, 1024, class(UInt32));
+    for (uint32_t a = 0; a < 32; a++)
+    {
+        for (uint32_t b = 0; b < 32; b++)
+        {
+            bool present = set_put(hashes, new(UInt32, hash_combine(a, b)));
+            ASSERT_FALSE(present, "Combined hash of (%d, %d) collides", a, b);
+        }
+    }
+    ASSERT_NOT_EQUAL(hash_combine(7, 7), 0u, "Equal values do not cancel");
+    del(Set, hashes);
+});
+
+TEST(test_hash_random_seed, {
+    uint32_t first = hash_random_seed(), second = hash_random_seed();
+    ASSERT_NOT_EQUAL(first, 0u, "Seeds are never 0");
+    ASSERT_NOT_EQUAL(first, second, "Seeds = %u", first);
+});
+
+
+TEST_GROUP(test_hash, {
+    test_hash_bytes_lengths();
+    test_hash_bytes_bits();
+    test_hash_bytes_seed();
+    test_hash_string();
+    test_hash_int64();
+    test_hash_combine();
+    test_hash_random_seed();
+});
@@ -3,11 +3,21 @@
 #include "unittest.h"
 
 void test_array_list();
+void test_bitset();
+void test_concurrent_map();
+void test_concurrent_set();
+void test_interner();
 void test_map();
+void test_ordered_map();
+void test_primitive_map();
+void test_rcu_map();
 void test_result();
 void test_set();
+void test_small_map();
+void test_small_set();
 void test_tuple();
 void test_strings();
+void test_hash();
 void test_utils();
 
 uint32_t __failed_tests = 0;
@@ -18,11 +28,21 @@ int main(void)
     printf("-----\nTesting Starting\n-----\n\n");
     
     test_array_list();
+    test_bitset();
+    test_concurrent_map();
+    test_concurrent_set();
+    test_interner();
     test_map();
+    test_ordered_map();
+    test_primitive_map();
+    test_rcu_map();
     test_result();
     test_set();
+    test_small_map();
+    test_small_set();
     test_tuple();
     test_strings();
+    test_hash();
     test_utils();
 
     printf("\n-----\nTesting Complete\n-----\n\nPassed = %d\nFailed = %d\n", __passed_tests, __failed_tests);